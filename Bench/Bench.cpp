@@ -0,0 +1,237 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* vc64bench
+ *
+ * Micro benchmarks for the core emulator.
+ *
+ * Usage: vc64bench [-f frames] [-n rounds] [-r rom ...] [-l] [benchmark ...]
+ *
+ * Without arguments, all benchmarks are run. Benchmarks comparing two configurations
+ * interleave them in -n rounds and report the median.
+ */
+
+#include "Bench.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+static Benchmark benchmarks[] = {
+    
+    { "execution", "Host ticks per emulated C64 cycle", benchExecution },
+    { "cpu", "Instructions per second of both CPUs in isolation", benchCPU },
+    { "cia", "Speed gain from letting idle CIAs sleep", benchCIA },
+    { "idledrive", "Speed gain from parking the idle drive", benchIdleDrive },
+    { "snapshot", "Cost of full and incremental snapshots", benchSnapshot },
+    { "state", "Round trip time of saving and loading the internal state", benchState },
+    { "rewind", "Speed of silent execution and rewinding by re-simulation", benchRewind },
+    { "indexed", "Speed gain from palette index output without RGBA conversion", benchIndexed },
+    { "canvas", "Speed gain from drawing canvas pixels in chunks", benchCanvas },
+    { "sprites", "Cost of displaying eight sprites in every rasterline", benchSprites },
+    { "frameskip", "Speed gain from synthesizing 1 of 8 frames in warp mode", benchFrameSkip },
+    { "handoff", "Frame handoff to a concurrent consumer thread", benchHandoff },
+    { "capture", "Cost of capturing video and audio losslessly", benchCapture },
+    { NULL, NULL, NULL }
+};
+
+unsigned benchFrames = 500;
+unsigned benchRounds = 5;
+
+static const char *roms[8];
+static unsigned numRoms;
+
+
+//
+// Benchmark environment
+//
+
+uint64_t
+hostTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+const char *
+hostTickUnit()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+double
+hostSeconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1E9;
+}
+
+static int
+compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+double
+median(double *values, unsigned n)
+{
+    assert(n > 0);
+    
+    qsort(values, n, sizeof(double), compareDoubles);
+    return (n % 2) ? values[n / 2] : (values[n / 2 - 1] + values[n / 2]) / 2;
+}
+
+static void
+installSyntheticKernal(C64 *c64)
+{
+    // Reset routine at $E100
+    const uint8_t reset[] = {
+        0x78,                   // SEI
+        0xA2, 0xFF,             // LDX #$FF
+        0x9A,                   // TXS
+        0xA9, 0x1B,             // LDA #$1B
+        0x8D, 0x11, 0xD0,       // STA $D011       Enable screen
+        0xA9, 0x7F,             // LDA #$7F
+        0x8D, 0x0D, 0xDC,       // STA $DC0D       Clear interrupt mask
+        0xA9, 0x81,             // LDA #$81
+        0x8D, 0x0D, 0xDC,       // STA $DC0D       Enable timer A interrupt
+        0xA9, 0x00,             // LDA #$00
+        0x8D, 0x04, 0xDC,       // STA $DC04
+        0xA9, 0x40,             // LDA #$40
+        0x8D, 0x05, 0xDC,       // STA $DC05       Timer A = $4000
+        0xA9, 0x11,             // LDA #$11
+        0x8D, 0x0E, 0xDC,       // STA $DC0E       Start timer A
+        0x58,                   // CLI
+        0xEE, 0x00, 0x04,       // INC $0400       Busy loop
+        0xE8,                   // INX
+        0x8A,                   // TXA
+        0x9D, 0x00, 0x05,       // STA $0500,X
+        0x4C, 0x23, 0xE1        // JMP $E123
+    };
+    
+    // Interrupt handler at $E140
+    const uint8_t irq[] = {
+        0xEE, 0x20, 0xD0,       // INC $D020
+        0xAD, 0x0D, 0xDC,       // LDA $DC0D       Acknowledge interrupt
+        0xEE, 0x01, 0x04,       // INC $0401
+        0x40                    // RTI
+    };
+    
+    // Vectors (NMI, RESET, IRQ)
+    const uint8_t vectors[] = { 0x49, 0xE1, 0x00, 0xE1, 0x40, 0xE1 };
+
+    memcpy(&c64->mem.rom[0xE100], reset, sizeof(reset));
+    memcpy(&c64->mem.rom[0xE140], irq, sizeof(irq));
+    memcpy(&c64->mem.rom[0xFFFA], vectors, sizeof(vectors));
+    
+    // The drive CPU mimics the DOS main loop ($EBFF - $EC9B)
+    const uint8_t start[] = { 0x4C, 0xFF, 0xEB };          // JMP $EBFF
+    const uint8_t loop[] = { 0x58, 0x4C, 0x9B, 0xEC };     // CLI, JMP $EC9B
+    const uint8_t loopEnd[] = { 0x4C, 0xFF, 0xEB };        // JMP $EBFF
+    uint8_t *driveRom = c64->floppy.mem.mem;
+    memcpy(&driveRom[0xEAA0], start, sizeof(start));
+    memcpy(&driveRom[0xEBFF], loop, sizeof(loop));
+    memcpy(&driveRom[0xEC9B], loopEnd, sizeof(loopEnd));
+    driveRom[0xFFFA] = driveRom[0xFFFC] = driveRom[0xFFFE] = 0xFF;
+    driveRom[0xFFFB] = driveRom[0xFFFD] = driveRom[0xFFFF] = 0xEB;
+}
+
+C64 *
+makeBenchC64()
+{
+    C64 *c64 = new C64();
+    
+    if (numRoms == 0) {
+        installSyntheticKernal(c64);
+    } else {
+        for (unsigned i = 0; i < numRoms; i++)
+            c64->loadRom(roms[i]);
+    }
+    
+    c64->reset();
+    return c64;
+}
+
+
+//
+// Main entry point
+//
+
+static void
+usage()
+{
+    fprintf(stderr, "Usage: vc64bench [-f frames] [-n rounds] [-r rom ...] [-l] [benchmark ...]\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "f:n:r:l")) != -1) {
+        switch (opt) {
+            case 'f':
+                benchFrames = (unsigned)atoi(optarg);
+                break;
+            case 'n':
+                benchRounds = MAX(1, atoi(optarg));
+                break;
+            case 'r':
+                if (numRoms < sizeof(roms) / sizeof(roms[0]))
+                    roms[numRoms++] = optarg;
+                break;
+            case 'l':
+                for (Benchmark *b = benchmarks; b->name; b++)
+                    printf("%-16s %s\n", b->name, b->description);
+                return 0;
+            default:
+                usage();
+                return 2;
+        }
+    }
+    
+    // Keep the emulator quiet
+    VC64Object::setDefaultDebugLevel(0);
+    VC64Object::setLogfile(fopen("/dev/null", "w"));
+    
+    for (Benchmark *b = benchmarks; b->name; b++) {
+        
+        bool selected = (optind == argc);
+        for (int i = optind; i < argc; i++)
+            selected |= (strcmp(argv[i], b->name) == 0);
+        
+        if (selected) {
+            printf("%s: %s\n", b->name, b->description);
+            b->run();
+            printf("\n");
+        }
+    }
+    
+    return 0;
+}
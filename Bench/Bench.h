@@ -0,0 +1,119 @@
+/*!
+ * @header      Bench.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2006 - 2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _BENCH_INC
+#define _BENCH_INC
+
+#include "C64.h"
+
+//! @brief    A single benchmark of the vc64bench suite
+typedef struct {
+    
+    //! @brief    Name used to select the benchmark on the command line
+    const char *name;
+    
+    //! @brief    Short description printed by vc64bench -l
+    const char *description;
+    
+    //! @brief    Runs the benchmark and prints the results
+    void (*run)();
+    
+} Benchmark;
+
+//
+//! @functiongroup Benchmark environment
+//
+
+//! @brief    Number of frames each benchmark emulates (-f option)
+extern unsigned benchFrames;
+
+/*! @brief    Number of rounds of comparative benchmarks
+ *  @details  Benchmarks comparing two configurations run them alternately in each round,
+ *            starting with a different one every round, and report the median. This keeps
+ *            warm caches and frequency scaling from favoring one of them.
+ */
+extern unsigned benchRounds;
+
+/*! @brief    Creates a C64 instance for benchmarking
+ *  @details  If ROM images have been specified on the command line, they are loaded.
+ *            Otherwise, a small synthetic Kernal is installed that enables the screen,
+ *            programs a CIA timer interrupt, and runs a busy loop writing into screen memory.
+ *            The drive CPU spins in a loop located where VC1541 DOS has its main loop.
+ *            The emulator is powered up, but the execution thread is not started.
+ */
+C64 *makeBenchC64();
+
+//! @brief    Reads the host's high resolution tick counter
+uint64_t hostTicks();
+
+//! @brief    Returns the unit of hostTicks() ("cycles" or "ns")
+const char *hostTickUnit();
+
+//! @brief    Returns a monotonic time stamp in seconds
+double hostSeconds();
+
+//! @brief    Returns the median of n values (the array gets sorted)
+double median(double *values, unsigned n);
+
+
+//
+//! @functiongroup Benchmarks
+//
+
+//! @brief    Measures host ticks per emulated C64 cycle
+void benchExecution();
+
+//! @brief    Measures the instruction throughput of the C64 CPU and the drive CPU
+void benchCPU();
+
+//! @brief    Compares emulation speed with and without letting idle CIAs sleep
+void benchCIA();
+
+//! @brief    Compares emulation speed with and without parking the idle drive
+void benchIdleDrive();
+
+//! @brief    Compares the cost of full and incremental snapshots
+void benchSnapshot();
+
+//! @brief    Measures the time needed to save and load the internal state
+void benchState();
+
+//! @brief    Compares normal and silent execution and measures the latency of rewinding
+void benchRewind();
+
+//! @brief    Compares emulation speed with and without the per frame RGBA conversion
+void benchIndexed();
+
+//! @brief    Compares canvas rendering pixel by pixel and in chunks of eight pixels
+void benchCanvas();
+
+//! @brief    Measures the cost of displaying eight sprites in every rasterline
+void benchSprites();
+
+//! @brief    Compares warp mode with all frames and with every eighth frame synthesized
+void benchFrameSkip();
+
+//! @brief    Measures the cost of handing frames over to a consumer thread
+void benchHandoff();
+
+//! @brief    Measures the cost of capturing video and audio into a file
+void benchCapture();
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "Bench.h"
+
+//! @brief    Returns the seconds needed to emulate benchFrames frames
+static double
+timeFrames(C64 *c64)
+{
+    double start = hostSeconds();
+    c64->runFrames(benchFrames);
+    return hostSeconds() - start;
+}
+
+void
+benchCIA()
+{
+    C64 *c64[2];
+    double *seconds[2];
+    unsigned fps;
+    
+    // Instance 0 executes both CIAs in every cycle, instance 1 lets them sleep
+    for (unsigned i = 0; i < 2; i++) {
+        c64[i] = makeBenchC64();
+        c64[i]->cia1.setIdleSleep(i == 1);
+        c64[i]->cia2.setIdleSleep(i == 1);
+        c64[i]->runFrames(10);
+        seconds[i] = new double[benchRounds];
+    }
+    fps = c64[0]->vic.getFramesPerSecond();
+    
+    for (unsigned r = 0; r < benchRounds; r++) {
+        for (unsigned k = 0; k < 2; k++) {
+            unsigned i = (r + k) % 2;
+            seconds[i][r] = timeFrames(c64[i]);
+        }
+    }
+    
+    bool equal = memcmp(c64[0]->mem.ram, c64[1]->mem.ram, 0x10000) == 0;
+    double off = median(seconds[0], benchRounds);
+    double on = median(seconds[1], benchRounds);
+    
+    printf("  Sleep off: %.1f ms per emulated second\n", 1E3 * off * fps / benchFrames);
+    printf("  Sleep on:  %.1f ms per emulated second\n", 1E3 * on * fps / benchFrames);
+    printf("  Speedup: %.2fx (median of %u rounds), RAM contents %s\n",
+           off / on, benchRounds, equal ? "match" : "DIFFER");
+    
+    for (unsigned i = 0; i < 2; i++) {
+        delete[] seconds[i];
+        delete c64[i];
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Bench.h"
+
+// Copies a memory block from $0200 - $027F to $0280 - $02FF in an endless loop
+static const uint8_t program[] = {
+    0xE6, 0x20,             // INC $20
+    0xA5, 0x20,             // LDA $20
+    0x18,                   // CLC
+    0x69, 0x01,             // ADC #$01
+    0x85, 0x21,             // STA $21
+    0xA2, 0x7F,             // LDX #$7F
+    0xBD, 0x00, 0x02,       // LDA $0200,X
+    0x9D, 0x80, 0x02,       // STA $0280,X
+    0xCA,                   // DEX
+    0x10, 0xF7,             // BPL $030B
+    0x4C, 0x00, 0x03        // JMP $0300
+};
+
+static void
+runCPU(CPU *cpu, Memory *mem, const char *name)
+{
+    for (unsigned i = 0; i < sizeof(program); i++)
+        mem->poke(0x0300 + i, program[i]);
+    cpu->setPC_at_cycle_0(0x0300);
+    
+    // Execute the CPU in isolation. Other components are not clocked.
+    const uint64_t cycles = (uint64_t)benchFrames * 20000;
+    uint64_t instructions = 0;
+    double start = hostSeconds();
+    
+    for (uint64_t i = 0; i < cycles; i++) {
+        if (cpu->atBeginningOfNewCommand())
+            instructions++;
+        cpu->executeOneCycle();
+    }
+    
+    double elapsed = hostSeconds() - start;
+    printf("  %s: %llu instructions in %.3f s (%.1f million instructions per second)\n",
+           name, (unsigned long long)instructions, elapsed, instructions / elapsed / 1E6);
+}
+
+void
+benchCPU()
+{
+    C64 *c64 = makeBenchC64();
+    
+    runCPU(&c64->cpu, &c64->mem, "6510 (C64)   ");
+    runCPU(&c64->floppy.cpu, &c64->floppy.mem, "6502 (VC1541)");
+    
+    delete c64;
+}
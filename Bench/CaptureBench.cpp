@@ -0,0 +1,54 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "Bench.h"
+
+void
+benchCapture()
+{
+    C64 *c64 = makeBenchC64();
+    unsigned fps = c64->vic.getFramesPerSecond();
+    const char *path = "vc64bench.vcap";
+    
+    c64->runFrames(10);
+    double start = hostSeconds();
+    c64->runFrames(benchFrames);
+    double plain = hostSeconds() - start;
+    
+    if (!c64->startCapture(path)) {
+        printf("  Cannot create %s\n", path);
+        delete c64;
+        return;
+    }
+    start = hostSeconds();
+    c64->runFrames(benchFrames);
+    double captured = hostSeconds() - start;
+    c64->stopCapture();
+    
+    struct stat fileProperties;
+    long size = stat(path, &fileProperties) == 0 ? (long)fileProperties.st_size : 0;
+    
+    printf("  Without capture: %.1f ms per emulated second\n", 1E3 * plain * fps / benchFrames);
+    printf("  With capture:    %.1f ms per emulated second\n", 1E3 * captured * fps / benchFrames);
+    printf("  %ld bytes per frame, %llu frames and %llu samples dropped\n",
+           size / benchFrames,
+           (unsigned long long)c64->capture.getDroppedFrames(),
+           (unsigned long long)c64->capture.getDroppedSamples());
+    
+    unlink(path);
+    delete c64;
+}
@@ -0,0 +1,46 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Bench.h"
+
+void
+benchExecution()
+{
+    C64 *c64 = makeBenchC64();
+    
+    // Warm up caches and branch predictors
+    c64->runFrames(10);
+    
+    uint64_t cycles = c64->getCycles();
+    uint64_t ticks = hostTicks();
+    double start = hostSeconds();
+    
+    c64->runFrames(benchFrames);
+    
+    ticks = hostTicks() - ticks;
+    cycles = c64->getCycles() - cycles;
+    double elapsed = hostSeconds() - start;
+    
+    printf("  %u frames, %llu C64 cycles in %.3f s\n",
+           benchFrames, (unsigned long long)cycles, elapsed);
+    printf("  %.1f host %s per C64 cycle\n", (double)ticks / cycles, hostTickUnit());
+    printf("  %.1f frames per second (%.1fx real time)\n",
+           benchFrames / elapsed, benchFrames / elapsed / c64->vic.getFramesPerSecond());
+    
+    delete c64;
+}
@@ -0,0 +1,228 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "Bench.h"
+
+//! @brief    Returns the seconds needed to emulate a number of frames
+static double
+timeFrames(C64 *c64, unsigned frames)
+{
+    double start = hostSeconds();
+    c64->runFrames(frames);
+    return hostSeconds() - start;
+}
+
+void
+benchIndexed()
+{
+    C64 *c64[2];
+    double *seconds[2];
+    unsigned fps;
+    
+    // Instance 0 writes RGBA pixels, instance 1 writes palette indices
+    for (unsigned i = 0; i < 2; i++) {
+        c64[i] = makeBenchC64();
+        c64[i]->vic.setIndexedOutput(i == 1);
+        c64[i]->runFrames(10);
+        seconds[i] = new double[benchRounds];
+    }
+    fps = c64[0]->vic.getFramesPerSecond();
+    
+    for (unsigned r = 0; r < benchRounds; r++) {
+        for (unsigned k = 0; k < 2; k++) {
+            unsigned i = (r + k) % 2;
+            seconds[i][r] = timeFrames(c64[i], benchFrames);
+        }
+    }
+    
+    double rgba = median(seconds[0], benchRounds);
+    double indexed = median(seconds[1], benchRounds);
+    
+    printf("  RGBA output:    %.1f ms per emulated second\n", 1E3 * rgba * fps / benchFrames);
+    printf("  Indexed output: %.1f ms per emulated second\n", 1E3 * indexed * fps / benchFrames);
+    printf("  Speedup: %.2fx (median of %u rounds)\n", rgba / indexed, benchRounds);
+    
+    for (unsigned i = 0; i < 2; i++) {
+        delete[] seconds[i];
+        delete c64[i];
+    }
+}
+
+/*! @brief    Displays eight sprites in every rasterline
+ *  @details  A loop at $C000 keeps copying the current rasterline into all sprite Y registers,
+ *            which restarts each sprite as soon as it has been completed. Four of the sprites
+ *            are multicolor sprites and two of them are drawn behind the foreground.
+ */
+static void
+installSpriteMultiplexer(C64 *c64)
+{
+    const uint8_t loop[] = {
+        0xAD, 0x12, 0xD0,       // LDA $D012
+        0x8D, 0x01, 0xD0,       // STA $D001
+        0x8D, 0x03, 0xD0,       // STA $D003
+        0x8D, 0x05, 0xD0,       // STA $D005
+        0x8D, 0x07, 0xD0,       // STA $D007
+        0x8D, 0x09, 0xD0,       // STA $D009
+        0x8D, 0x0B, 0xD0,       // STA $D00B
+        0x8D, 0x0D, 0xD0,       // STA $D00D
+        0x8D, 0x0F, 0xD0,       // STA $D00F
+        0x4C, 0x00, 0xC0        // JMP $C000
+    };
+    memcpy(&c64->mem.ram[0xC000], loop, sizeof(loop));
+    
+    // Sprite data at $2000
+    for (unsigned i = 0; i < 63; i++)
+        c64->mem.ram[0x2000 + i] = (i % 3 == 1) ? 0x3C : 0xE7;
+    memset(&c64->mem.ram[0x07F8], 0x80, 8);
+    
+    for (unsigned i = 0; i < 8; i++) {
+        c64->vic.poke(2 * i, 24 + 40 * i);
+        c64->vic.poke(0x27 + i, 1 + i);
+    }
+    c64->vic.poke(0x15, 0xFF);
+    c64->vic.poke(0x1C, 0x0F);
+    c64->vic.poke(0x1B, 0x30);
+    c64->vic.poke(0x25, 0x0A);
+    c64->vic.poke(0x26, 0x0D);
+    c64->cpu.setPC_at_cycle_0(0xC000);
+}
+
+void
+benchSprites()
+{
+    C64 *c64 = makeBenchC64();
+    unsigned fps = c64->vic.getFramesPerSecond();
+    
+    c64->runFrames(10);
+    double plain = timeFrames(c64, benchFrames);
+    installSpriteMultiplexer(c64);
+    c64->runFrames(10);
+    double sprites = timeFrames(c64, benchFrames);
+    
+    printf("  No sprites:    %.1f ms per emulated second\n", 1E3 * plain * fps / benchFrames);
+    printf("  Eight sprites: %.1f ms per emulated second\n", 1E3 * sprites * fps / benchFrames);
+    printf("  Sprite overhead: %.0f%%\n", 100.0 * (sprites - plain) / plain);
+    
+    delete c64;
+}
+
+void
+benchCanvas()
+{
+    C64 *c64 = makeBenchC64();
+    unsigned fps = c64->vic.getFramesPerSecond();
+    
+    c64->runFrames(10);
+    c64->vic.setSpanRendering(false);
+    double pixelwise = timeFrames(c64, benchFrames);
+    c64->vic.setSpanRendering(true);
+    double spanwise = timeFrames(c64, benchFrames);
+    
+    printf("  Pixel by pixel: %.1f ms per emulated second\n", 1E3 * pixelwise * fps / benchFrames);
+    printf("  Eight at once:  %.1f ms per emulated second\n", 1E3 * spanwise * fps / benchFrames);
+    printf("  Speedup: %.2fx\n", pixelwise / spanwise);
+    
+    delete c64;
+}
+
+void
+benchFrameSkip()
+{
+    C64 *c64 = makeBenchC64();
+    unsigned fps = c64->vic.getFramesPerSecond();
+    
+    c64->setWarp(true);
+    c64->runFrames(10);
+    double all = timeFrames(c64, benchFrames);
+    c64->setWarpRenderInterval(8);
+    double skipped = timeFrames(c64, benchFrames);
+    c64->setWarpRenderInterval(1);
+    c64->setWarp(false);
+    
+    printf("  Every frame:    %.1f ms per emulated second\n", 1E3 * all * fps / benchFrames);
+    printf("  1 of 8 frames:  %.1f ms per emulated second\n", 1E3 * skipped * fps / benchFrames);
+    printf("  Speedup: %.2fx\n", all / skipped);
+    
+    delete c64;
+}
+
+//! @brief    State shared with a frame consumer thread
+typedef struct {
+    
+    TripleBuffer *frames;
+    FrameConsumer consumer;
+    volatile bool stop;
+    
+    //! @brief    Number of frames that changed while they were copied
+    uint64_t torn;
+    
+} ConsumerJob;
+
+static void *
+consumeFrames(void *arg)
+{
+    ConsumerJob *job = (ConsumerJob *)arg;
+    static int copy[PAL_RASTERLINES][NTSC_PIXELS];
+    
+    TripleBuffer::initConsumer(&job->consumer);
+    while (!job->stop) {
+        const ScreenFrame *frame = job->frames->acquire(&job->consumer);
+        uint64_t sequence = frame->sequence;
+        memcpy(copy, frame->rgba, sizeof(copy));
+        if (frame->sequence != sequence)
+            job->torn++;
+        job->frames->release(&job->consumer);
+        
+        // Poll at 200 Hz like a display would
+        sleepMicrosec(5000);
+    }
+    return NULL;
+}
+
+void
+benchHandoff()
+{
+    C64 *c64 = makeBenchC64();
+    unsigned fps = c64->vic.getFramesPerSecond();
+    TripleBuffer *frames = c64->vic.getFrames();
+    
+    c64->runFrames(10);
+    double alone = timeFrames(c64, benchFrames);
+    
+    ConsumerJob job;
+    memset(&job, 0, sizeof(job));
+    job.frames = frames;
+    uint64_t discarded = frames->getDiscarded();
+    
+    pthread_t thread;
+    pthread_create(&thread, NULL, consumeFrames, &job);
+    double shared = timeFrames(c64, benchFrames);
+    job.stop = true;
+    pthread_join(thread, NULL);
+    
+    printf("  Without consumer: %.1f ms per emulated second\n", 1E3 * alone * fps / benchFrames);
+    printf("  With consumer:    %.1f ms per emulated second\n", 1E3 * shared * fps / benchFrames);
+    printf("  Consumer: %llu frames, %llu dropped, %llu duplicated, %llu torn\n",
+           (unsigned long long)job.consumer.received,
+           (unsigned long long)job.consumer.dropped,
+           (unsigned long long)job.consumer.duplicated,
+           (unsigned long long)job.torn);
+    printf("  Frames discarded by the emulator: %llu\n",
+           (unsigned long long)(frames->getDiscarded() - discarded));
+    
+    delete c64;
+}
@@ -0,0 +1,65 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "Bench.h"
+
+//! @brief    Returns the seconds needed to emulate a number of frames
+static double
+timeFrames(C64 *c64, unsigned frames)
+{
+    double start = hostSeconds();
+    c64->runFrames(frames);
+    return hostSeconds() - start;
+}
+
+void
+benchRewind()
+{
+    C64 *c64 = makeBenchC64();
+    unsigned fps = c64->vic.getFramesPerSecond();
+    
+    // Compare normal and silent execution
+    c64->setTimeTravelInterval(0);
+    c64->runFrames(10);
+    double normal = timeFrames(c64, benchFrames);
+    c64->setSilent(true);
+    double silent = timeFrames(c64, benchFrames);
+    c64->setSilent(false);
+    
+    printf("  Normal execution: %.1f ms per emulated second\n", 1E3 * normal * fps / benchFrames);
+    printf("  Silent execution: %.1f ms per emulated second\n", 1E3 * silent * fps / benchFrames);
+    printf("  Speedup: %.2fx\n", normal / silent);
+    
+    // Rewind to the end of a four second snapshot interval
+    c64->setTimeTravelInterval(4 * fps);
+    c64->runFrames(4 * fps - (unsigned)(c64->getFrame() % (4 * fps)));
+    c64->runFrames(4 * fps - 1);
+    uint64_t target = c64->getCycles();
+    c64->runFrames(fps);
+    
+    double start = hostSeconds();
+    bool success = c64->rewindUnsafe(target);
+    double elapsed = hostSeconds() - start;
+    
+    if (success && c64->getCycles() == target)
+        printf("  Rewind by re-simulating %.2f s: %.1f ms (%.1f ms per emulated second)\n",
+               (4 * fps - 1) / (double)fps, 1E3 * elapsed, 1E3 * elapsed * fps / (4 * fps - 1));
+    else
+        printf("  Rewind failed\n");
+    
+    delete c64;
+}
@@ -0,0 +1,58 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Bench.h"
+
+void
+benchSnapshot()
+{
+    C64 *c64 = makeBenchC64();
+    Snapshot *full = new Snapshot();
+    Snapshot *incremental = new Snapshot();
+    double fullTime = 0, incrementalTime = 0, start;
+    size_t dirtyBytes = 0;
+    
+    // Only a single snapshot may be updated incrementally
+    c64->setTimeTravelInterval(0);
+    c64->runFrames(10);
+    c64->updateSnapshotUnsafe(incremental);
+    
+    for (unsigned i = 0; i < benchFrames; i++) {
+        
+        c64->runFrames(1);
+        dirtyBytes += c64->dirtySize();
+        
+        start = hostSeconds();
+        c64->updateSnapshotUnsafe(incremental);
+        incrementalTime += hostSeconds() - start;
+        
+        start = hostSeconds();
+        c64->saveToSnapshotUnsafe(full);
+        fullTime += hostSeconds() - start;
+    }
+    
+    printf("  State size: %zu bytes, modified per frame: %zu bytes\n",
+           c64->stateSize(), dirtyBytes / benchFrames);
+    printf("  Full save       : %.1f us per snapshot\n", 1E6 * fullTime / benchFrames);
+    printf("  Incremental save: %.1f us per snapshot\n", 1E6 * incrementalTime / benchFrames);
+    printf("  Speedup: %.2fx\n", fullTime / incrementalTime);
+    
+    delete full;
+    delete incremental;
+    delete c64;
+}
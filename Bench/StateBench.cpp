@@ -0,0 +1,96 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "Bench.h"
+
+//! @brief    Returns the average seconds needed to load the state from a buffer
+static double
+timeLoad(C64 *c64, uint8_t *buffer, bool foreign)
+{
+    uint8_t *ptr;
+    double start = hostSeconds();
+    
+    // A state of the opposite byte order is loaded and converted item by item
+    c64->setForeignByteOrder(foreign);
+    for (unsigned i = 0; i < benchFrames; i++) {
+        ptr = buffer;
+        c64->loadFromBuffer(&ptr);
+    }
+    c64->setForeignByteOrder(false);
+    
+    return (hostSeconds() - start) / benchFrames;
+}
+
+void
+benchState()
+{
+    C64 *c64 = makeBenchC64();
+    size_t size = c64->stateSize();
+    uint8_t *buffer = (uint8_t *)malloc(size);
+    uint8_t *original = (uint8_t *)malloc(size);
+    double *saveTime = new double[benchRounds];
+    double *loadTime[2] = { new double[benchRounds], new double[benchRounds] };
+    uint8_t *ptr;
+    
+    if (buffer == NULL || original == NULL) {
+        fprintf(stderr, "Failed to allocate %zu bytes\n", size);
+        exit(1);
+    }
+    c64->setTimeTravelInterval(0);
+    c64->runFrames(10);
+    ptr = original;
+    c64->saveToBuffer(&ptr);
+    
+    for (unsigned r = 0; r < benchRounds; r++) {
+        
+        double start = hostSeconds();
+        for (unsigned i = 0; i < benchFrames; i++) {
+            ptr = buffer;
+            c64->saveToBuffer(&ptr);
+        }
+        saveTime[r] = (hostSeconds() - start) / benchFrames;
+        
+        // Native and foreign loads take turns in starting a round
+        for (unsigned k = 0; k < 2; k++) {
+            unsigned i = (r + k) % 2;
+            loadTime[i][r] = timeLoad(c64, buffer, i == 1);
+        }
+        
+        // Restore the original state (the foreign load has scrambled it)
+        ptr = original;
+        c64->loadFromBuffer(&ptr);
+    }
+    
+    double save = median(saveTime, benchRounds);
+    double native = median(loadTime[0], benchRounds);
+    double foreign = median(loadTime[1], benchRounds);
+    
+    printf("  State size: %zu bytes\n", size);
+    printf("  Save          : %.1f us\n", 1E6 * save);
+    printf("  Load          : %.1f us\n", 1E6 * native);
+    printf("  Round trip    : %.1f us\n", 1E6 * (save + native));
+    printf("  Foreign load  : %.1f us\n", 1E6 * foreign);
+    printf("  Speedup of native over foreign loads: %.2fx (median of %u rounds)\n",
+           foreign / native, benchRounds);
+    
+    delete[] saveTime;
+    delete[] loadTime[0];
+    delete[] loadTime[1];
+    free(original);
+    free(buffer);
+    delete c64;
+}
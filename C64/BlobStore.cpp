@@ -0,0 +1,150 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "BlobStore.h"
+
+BlobStore::Blob *BlobStore::table = NULL;
+unsigned BlobStore::capacity = 0;
+unsigned BlobStore::count = 0;
+size_t BlobStore::bytes = 0;
+pthread_mutex_t BlobStore::lock = PTHREAD_MUTEX_INITIALIZER;
+
+uint64_t
+BlobStore::hash(const uint8_t *data, size_t size)
+{
+    uint64_t result = 0xcbf29ce484222325;
+    
+    for (size_t i = 0; i < size; i++) {
+        result ^= data[i];
+        result *= 0x100000001b3;
+    }
+    
+    return result;
+}
+
+BlobStore::Blob *
+BlobStore::slot(uint64_t hash, size_t size)
+{
+    assert(capacity > 0);
+    
+    for (unsigned i = (unsigned)hash & (capacity - 1);; i = (i + 1) & (capacity - 1)) {
+        if (table[i].data == NULL || (table[i].hash == hash && table[i].size == size))
+            return &table[i];
+    }
+}
+
+bool
+BlobStore::grow()
+{
+    Blob *oldTable = table;
+    unsigned oldCapacity = capacity;
+    unsigned newCapacity = capacity ? 2 * capacity : 64;
+    Blob *newTable = (Blob *)calloc(newCapacity, sizeof(Blob));
+    
+    if (newTable == NULL) {
+        fprintf(stderr, "Failed to allocate the blob store\n");
+        return false;
+    }
+    
+    table = newTable;
+    capacity = newCapacity;
+    for (unsigned i = 0; i < oldCapacity; i++)
+        if (oldTable[i].data)
+            *slot(oldTable[i].hash, oldTable[i].size) = oldTable[i];
+    
+    free(oldTable);
+    return true;
+}
+
+bool
+BlobStore::add(const uint8_t *data, size_t size, uint64_t *result)
+{
+    assert(data != NULL);
+    assert(result != NULL);
+    
+    bool success = true;
+    uint64_t h = *result = hash(data, size);
+    
+    pthread_mutex_lock(&lock);
+    
+    // Keep the load factor below 50 %
+    if (2 * (count + 1) > capacity && !grow()) {
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+    
+    Blob *blob = slot(h, size);
+    
+    if (blob->data == NULL) {
+        
+        if ((blob->data = (uint8_t *)malloc(size ? size : 1)) == NULL) {
+            fprintf(stderr, "Failed to allocate %zu bytes for the blob store\n", size);
+            success = false;
+        } else {
+            memcpy(blob->data, data, size);
+            blob->hash = h;
+            blob->size = (uint32_t)size;
+            count++;
+            bytes += size;
+        }
+        
+    } else if (memcmp(blob->data, data, size) != 0) {
+        
+        // Two different images with the same hash (never seen in practice)
+        fprintf(stderr, "Blob store: Hash collision (%016llx)\n", (unsigned long long)h);
+        success = false;
+    }
+    
+    pthread_mutex_unlock(&lock);
+    return success;
+}
+
+bool
+BlobStore::get(uint64_t hash, size_t size, uint8_t *data)
+{
+    bool result = false;
+    
+    pthread_mutex_lock(&lock);
+    
+    if (capacity) {
+        Blob *blob = slot(hash, size);
+        if (blob->data) {
+            memcpy(data, blob->data, size);
+            result = true;
+        }
+    }
+    
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+void
+BlobStore::addReference(BlobList *list, uint64_t hash, size_t size)
+{
+    assert(list != NULL);
+    
+    for (unsigned i = 0; i < list->count; i++)
+        if (list->hash[i] == hash && list->size[i] == size)
+            return;
+    
+    assert(list->count < MAX_BLOB_REFERENCES);
+    list->hash[list->count] = hash;
+    list->size[list->count] = (uint32_t)size;
+    list->count++;
+}
@@ -0,0 +1,126 @@
+/*!
+ * @header      BlobStore.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _BLOBSTORE_INC
+#define _BLOBSTORE_INC
+
+#include "basic.h"
+#include <pthread.h>
+
+//! @brief    Maximum number of entries in a BlobList
+#define MAX_BLOB_REFERENCES 128
+
+/*! @brief    List of blob references
+ *  @details  Used to determine the blobs that need to be embedded into a snapshot file.
+ */
+typedef struct {
+    
+    //! @brief    Number of valid entries
+    unsigned count;
+    
+    //! @brief    Content hashes
+    uint64_t hash[MAX_BLOB_REFERENCES];
+    
+    //! @brief    Blob sizes in bytes
+    uint32_t size[MAX_BLOB_REFERENCES];
+    
+} BlobList;
+
+/*! @class    BlobStore
+ *  @brief    Content-addressed storage for ROM and cartridge images
+ *  @details  Immutable memory images are kept in this store exactly once and are referred to by
+ *            a 64 bit FNV-1a hash of their contents. Snapshots only carry these references instead
+ *            of the images themselves. The store is shared by all emulator instances and is
+ *            thread-safe. Blobs are never removed, because old snapshots may still refer to them.
+ *            The store only grows when a new ROM or cartridge image is used.
+ */
+class BlobStore {
+    
+    //! @brief    A single stored image
+    typedef struct {
+        
+        //! @brief    Content hash
+        uint64_t hash;
+        
+        //! @brief    Size in bytes
+        uint32_t size;
+        
+        //! @brief    Image data (NULL marks an empty hash table slot)
+        uint8_t *data;
+        
+    } Blob;
+    
+    //! @brief    Open addressing hash table holding all blobs
+    static Blob *table;
+    
+    //! @brief    Size of the hash table (always a power of two)
+    static unsigned capacity;
+    
+    //! @brief    Number of stored blobs
+    static unsigned count;
+    
+    //! @brief    Total size of all stored blobs in bytes
+    static size_t bytes;
+    
+    //! @brief    Protects the hash table against concurrent access
+    static pthread_mutex_t lock;
+    
+public:
+    
+    //! @brief    Computes the content hash of a memory image
+    static uint64_t hash(const uint8_t *data, size_t size);
+    
+    /*! @brief    Adds a memory image to the store
+     *  @details  Nothing is added if the store already contains the image. The content hash
+     *            referring to the image is written into hash.
+     *  @result   false, if the store contains a different image with the same hash and size or
+     *            if memory is exhausted. The image is not stored in that case and must not be
+     *            referred to.
+     */
+    static bool add(const uint8_t *data, size_t size, uint64_t *hash);
+    
+    /*! @brief    Copies a stored image
+     *  @result   false, if the store does not contain an image with the specified hash and size
+     */
+    static bool get(uint64_t hash, size_t size, uint8_t *data);
+    
+    //! @brief    Returns the number of stored blobs
+    static unsigned numBlobs() { return count; }
+    
+    //! @brief    Returns the total size of all stored blobs in bytes
+    static size_t numBytes() { return bytes; }
+    
+    /*! @brief    Adds a reference to a list
+     *  @details  Duplicates are ignored.
+     */
+    static void addReference(BlobList *list, uint64_t hash, size_t size);
+    
+private:
+    
+    //! @brief    Returns the hash table slot of an image or the empty slot it would be stored in
+    static Blob *slot(uint64_t hash, size_t size);
+    
+    /*! @brief    Doubles the size of the hash table
+     *  @result   false, if memory is exhausted. The table stays as it is in that case.
+     */
+    static bool grow();
+};
+
+#endif
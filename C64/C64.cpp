@@ -18,9 +18,6 @@
 
 #include "C64.h"
 
-int debugcnt = 0;
-int debugirq = 0;
-
 //
 // Execution thread
 //
@@ -74,15 +71,18 @@ void
 // Class methods
 //
 
-C64::C64()
+C64::C64() : worker(&history)
 {
 	setDescription("C64");
 	debug("Creating virtual C64[%p]\n", this);
 
-	p = NULL;    
+    running = false;
     warp = false;
     alwaysWarp = false;
     warpLoad = false;
+    batchMode = false;
+    silent = false;
+    warpRenderInterval = 1;
 	
     // Register sub components
     VirtualComponent *subcomponents[] = {
@@ -107,22 +107,22 @@ C64::C64()
     // Register snapshot items
     SnapshotItem items[] = {
  
-        { &warp,            sizeof(warp),               CLEAR_ON_RESET },
-        { &alwaysWarp,      sizeof(alwaysWarp),         CLEAR_ON_RESET },
-        { &warpLoad,        sizeof(warpLoad),           KEEP_ON_RESET },
-        { &cycle,           sizeof(cycle),              CLEAR_ON_RESET },
-        { &frame,           sizeof(frame),              CLEAR_ON_RESET },
-        { &rasterline,      sizeof(rasterline),         CLEAR_ON_RESET },
-        { &rasterlineCycle, sizeof(rasterlineCycle),    CLEAR_ON_RESET },
-        { &ultimax,         sizeof(ultimax),            CLEAR_ON_RESET },
-        { NULL,             0,                          0 }};
+        { "warp",            &warp,            sizeof(warp),               CLEAR_ON_RESET },
+        { "alwaysWarp",      &alwaysWarp,      sizeof(alwaysWarp),         CLEAR_ON_RESET },
+        { "warpLoad",        &warpLoad,        sizeof(warpLoad),           KEEP_ON_RESET },
+        { "cycle",           &cycle,           sizeof(cycle),              CLEAR_ON_RESET },
+        { "frame",           &frame,           sizeof(frame),              CLEAR_ON_RESET },
+        { "rasterline",      &rasterline,      sizeof(rasterline),         CLEAR_ON_RESET },
+        { "rasterlineCycle", &rasterlineCycle, sizeof(rasterlineCycle),    CLEAR_ON_RESET },
+        { "ultimax",         &ultimax,         sizeof(ultimax),            CLEAR_ON_RESET },
+        { NULL,              NULL,             0,                          0 }};
     
     registerSnapshotItems(items, sizeof(items));
 
     // Setup references
-    cpu.mem = &mem;
+    cpu.connectMemory(&mem);
     mem.cpu = &cpu;
-    floppy.cpu.mem = &c64->floppy.mem;
+    floppy.cpu.connectMemory(&c64->floppy.mem);
     floppy.mem.cpu = &c64->floppy.cpu;
     
     floppy.mem.iec = &c64->iec;
@@ -130,16 +130,34 @@ C64::C64()
 
     floppy.iec = &c64->iec;
     
+    // Setup VIC cycle dispatch tables
+    initVicFunctionTable();
+    
     // Configure VIC
     setPAL();
 			
-    // Initialize mach timer info
-    mach_timebase_info(&timebase);
+    // Initialize kernel timer info
+    kernelTimebase(&timebase.numer, &timebase.denom);
 
 	// Initialize snapshot ringbuffer (BackInTime feature)
-	for (unsigned i = 0; i < BACK_IN_TIME_BUFFER_SIZE; i++)
-		backInTimeHistory[i] = new Snapshot();	
-	backInTimeWritePtr = 0;
+    timeTravelSnapshot = new Snapshot();
+    historicSnapshot = new Snapshot();
+    fileSnapshot = new Snapshot();
+    timeTravelInterval = 4 * vic.getFramesPerSecond();
+    epoch = 0;
+    
+    // Initialize input recording
+    recording = NULL;
+    replaying = NULL;
+    replayPosition = 0;
+    firstEpochEvent = 0;
+    numPendingInputs = 0;
+    applyingInput = false;
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&inputLock, &attr);
+    pthread_mutexattr_destroy(&attr);
     
     reset();
 }
@@ -148,6 +166,40 @@ C64::~C64()
 {
     debug(1, "Destroying virtual C64[%p]\n", this);
 	halt();
+    
+    worker.waitUntilIdle();
+    delete timeTravelSnapshot;
+    delete historicSnapshot;
+    delete fileSnapshot;
+    
+    delete stopRecording();
+    pthread_mutex_destroy(&inputLock);
+}
+
+void
+C64::initVicFunctionTable()
+{
+    for (unsigned model = 0; model < 2; model++) {
+        
+        void (VIC::**table)(void) = vicfunc[model];
+        
+        table[0] = NULL;
+        table[1] = &VIC::cycle1;   table[2] = &VIC::cycle2;   table[3] = &VIC::cycle3;
+        table[4] = &VIC::cycle4;   table[5] = &VIC::cycle5;   table[6] = &VIC::cycle6;
+        table[7] = &VIC::cycle7;   table[8] = &VIC::cycle8;   table[9] = &VIC::cycle9;
+        table[10] = &VIC::cycle10; table[11] = &VIC::cycle11; table[12] = &VIC::cycle12;
+        table[13] = &VIC::cycle13; table[14] = &VIC::cycle14; table[15] = &VIC::cycle15;
+        table[16] = &VIC::cycle16; table[17] = &VIC::cycle17; table[18] = &VIC::cycle18;
+        for (unsigned i = 19; i <= 54; i++)
+            table[i] = &VIC::cycle19to54;
+        table[55] = &VIC::cycle55; table[56] = &VIC::cycle56; table[57] = &VIC::cycle57;
+        table[58] = &VIC::cycle58; table[59] = &VIC::cycle59; table[60] = &VIC::cycle60;
+        table[61] = &VIC::cycle61; table[62] = &VIC::cycle62; table[63] = &VIC::cycle63;
+        
+        // Only NTSC machines have rasterline cycles 64 and 65
+        table[64] = (model == MOS6567_NTSC) ? &VIC::cycle64 : NULL;
+        table[65] = (model == MOS6567_NTSC) ? &VIC::cycle65 : NULL;
+    }
 }
 
 void
@@ -172,6 +224,7 @@ C64::reset()
     
 	rasterlineCycle = 1;
     nanoTargetTime = 0UL;
+    beginEpoch();
     ping();
 	// resume();
 }
@@ -198,6 +251,13 @@ C64::dumpState() {
 	msg("      Current rasterline : %d\n", rasterline);
 	msg("Current rasterline cycle : %d\n", rasterlineCycle);
     msg("            Ultimax mode : %s\n", getUltimax() ? "YES" : "NO");
+    msg("   Time travel snapshots : %d (%d keyframes, one every %d frames, %llu dropped)\n",
+        history.numSnapshots(), history.numKeyframes(), timeTravelInterval,
+        (unsigned long long)worker.getDropped());
+    msg("      Bytes per snapshot : %zu (%zu of %zu bytes used)\n",
+        history.bytesPerSnapshot(), history.bytesUsed(), history.getBudget());
+    msg("     ROM and chip images : %d (%zu bytes)\n",
+        BlobStore::numBlobs(), BlobStore::numBytes());
 	msg("\n");
 }
 
@@ -236,9 +296,11 @@ C64::setNTSC()
 void
 C64::powerUp()
 {
-    suspend();
-    reset();
-    resume();
+    if (!interceptInput(INPUT_RESET)) {
+        suspend();
+        reset();
+        resume();
+    }
     run();
 }
 
@@ -257,14 +319,16 @@ C64::run()
         sid.run();
         
         // Start execution thread
-        pthread_create(&p, NULL, runThread, (void *)this);
+        running = true;
+        if (pthread_create(&p, NULL, runThread, (void *)this) != 0)
+            running = false;
     }
 }
 
 void
 C64::threadCleanup()
 {
-    p = NULL;
+    running = false;
     debug(1, "Execution thread cleanup\n");
 }
 
@@ -277,7 +341,7 @@ C64::isRunnable()
 bool
 C64::isRunning()
 {
-    return p != NULL;
+    return running;
 }
 
 void
@@ -291,13 +355,16 @@ C64::halt()
         pthread_join(p, NULL);
         // Finish the current command (to reach a clean state)
         step();
+        // Bring the timer values up to date for inspection
+        cia1.wakeUp();
+        cia2.wakeUp();
     }
 }
 
 bool
 C64::isHalted()
 {
-    return p == NULL;
+    return !running;
 }
 
 void
@@ -327,293 +394,32 @@ C64::step()
 // |   '-----'   |   '----------------'     '------'     '------'  |
 // '---------------------------------------------------------------'
 
-#define EXECUTE(x) \
-cia1.executeOneCycle(); \
-cia2.executeOneCycle(); \
-if (!cpu.executeOneCycle()) result = false; \
-if (!floppy.executeOneCycle()) result = false; \
-datasette.execute(); \
-cycle++; \
-rasterlineCycle++;
+inline bool
+C64::_executeOneCycle()
+{
+    bool result = true; // Don't break execution
+    
+    cia1.execute(cycle);
+    cia2.execute(cycle);
+    if (!cpu.executeOneCycle()) result = false;
+    if (!floppy.executeOneCycle()) result = false;
+    datasette.execute();
+    cycle++;
+    rasterlineCycle++;
+    
+    return result;
+}
 
 bool
 C64::executeOneCycle()
 {
-    bool result = true; // Don't break execution
+    bool isFirstCycle = rasterlineCycle == 1;
+    bool isLastCycle = rasterlineCycle == vic.getCyclesPerRasterline();
     
-    switch(rasterlineCycle) {
-        case 1:
-            beginOfRasterline();
-            vic.cycle1();
-            EXECUTE(1);
-            break;
-        case 2:
-            vic.cycle2();
-            EXECUTE(2);
-            break;
-        case 3:
-            vic.cycle3();
-            EXECUTE(3);
-            break;
-        case 4:
-            vic.cycle4();
-            EXECUTE(4);
-            break;
-        case 5:
-            vic.cycle5();
-            EXECUTE(5);
-            break;
-        case 6:
-            vic.cycle6();
-            EXECUTE(6);
-            break;
-        case 7:
-            vic.cycle7();
-            EXECUTE(7);
-            break;
-        case 8:
-            vic.cycle8();
-            EXECUTE(8);
-            break;
-        case 9:
-            vic.cycle9();
-            EXECUTE(9);
-            break;
-        case 10:
-            vic.cycle10();
-            EXECUTE(10);
-            break;
-        case 11:
-            vic.cycle11();
-            EXECUTE(11);
-            break;
-        case 12:
-            vic.cycle12();
-            EXECUTE(12);
-            break;
-        case 13:
-            vic.cycle13();
-            EXECUTE(13);
-            break;
-        case 14:
-            vic.cycle14();
-            EXECUTE(14);
-            break;
-        case 15:
-            vic.cycle15();
-            EXECUTE(15);
-            break;
-        case 16:
-            vic.cycle16();
-            EXECUTE(16);
-            break;
-        case 17:
-            vic.cycle17();
-            EXECUTE(17);
-            break;
-        case 18:
-            vic.cycle18();
-            EXECUTE(18);
-            break;
-        case 19:
-            vic.cycle19to54();
-            EXECUTE(19);
-            break;
-        case 20:
-            vic.cycle19to54();
-            EXECUTE(20);
-            break;
-        case 21:
-            vic.cycle19to54();
-            EXECUTE(21);
-            break;
-        case 22:
-            vic.cycle19to54();
-            EXECUTE(22);
-            break;
-        case 23:
-            vic.cycle19to54();
-            EXECUTE(23);
-            break;
-        case 24:
-            vic.cycle19to54();
-            EXECUTE(24);
-            break;
-        case 25:
-            vic.cycle19to54();
-            EXECUTE(25);
-            break;
-        case 26:
-            vic.cycle19to54();
-            EXECUTE(26);
-            break;
-        case 27:
-            vic.cycle19to54();
-            EXECUTE(27);
-            break;
-        case 28:
-            vic.cycle19to54();
-            EXECUTE(28);
-            break;
-        case 29:
-            vic.cycle19to54();
-            EXECUTE(29);
-            break;
-        case 30:
-            vic.cycle19to54();
-            EXECUTE(30);
-            break;
-        case 31:
-            vic.cycle19to54();
-            EXECUTE(31);
-            break;
-        case 32:
-            vic.cycle19to54();
-            EXECUTE(32);
-            break;
-        case 33:
-            vic.cycle19to54();
-            EXECUTE(33);
-            break;
-        case 34:
-            vic.cycle19to54();
-            EXECUTE(34);
-            break;
-        case 35:
-            vic.cycle19to54();
-            EXECUTE(35);
-            break;
-        case 36:
-            vic.cycle19to54();
-            EXECUTE(36);
-            break;
-        case 37:
-            vic.cycle19to54();
-            EXECUTE(37);
-            break;
-        case 38:
-            vic.cycle19to54();
-            EXECUTE(38);
-            break;
-        case 39:
-            vic.cycle19to54();
-            EXECUTE(39);
-            break;
-        case 40:
-            vic.cycle19to54();
-            EXECUTE(40);
-            break;
-        case 41:
-            vic.cycle19to54();
-            EXECUTE(41);
-            break;
-        case 42:
-            vic.cycle19to54();
-            EXECUTE(42);
-            break;
-        case 43:
-            vic.cycle19to54();
-            EXECUTE(43);
-            break;
-        case 44:
-            vic.cycle19to54();
-            EXECUTE(44);
-            break;
-        case 45:
-            vic.cycle19to54();
-            EXECUTE(45);
-            break;
-        case 46:
-            vic.cycle19to54();
-            EXECUTE(46);
-            break;
-        case 47:
-            vic.cycle19to54();
-            EXECUTE(47);
-            break;
-        case 48:
-            vic.cycle19to54();
-            EXECUTE(48);
-            break;
-        case 49:
-            vic.cycle19to54();
-            EXECUTE(49);
-            break;
-        case 50:
-            vic.cycle19to54();
-            EXECUTE(50);
-            break;
-        case 51:
-            vic.cycle19to54();
-            EXECUTE(51);
-            break;
-        case 52:
-            vic.cycle19to54();
-            EXECUTE(52);
-            break;
-        case 53:
-            vic.cycle19to54();
-            EXECUTE(53);
-            break;
-        case 54:
-            vic.cycle19to54();
-            EXECUTE(54);
-            break;
-        case 55:
-            vic.cycle55();
-            EXECUTE(55);
-            break;
-        case 56:
-            vic.cycle56();
-            EXECUTE(56);
-            break;
-        case 57: 
-            vic.cycle57();
-            EXECUTE(57);
-            break;
-        case 58: 
-            vic.cycle58();
-            EXECUTE(58);
-            break;
-        case 59: 
-            vic.cycle59();
-            EXECUTE(59);
-            break;
-        case 60: 
-            vic.cycle60();
-            EXECUTE(60);
-            break;
-        case 61: 
-            vic.cycle61();
-            EXECUTE(61);
-            break;
-        case 62: 
-            vic.cycle62();
-            EXECUTE(62);
-            break;
-        case 63: 
-            vic.cycle63();
-            EXECUTE(63);
-            if (vic.getCyclesPerRasterline() == 63) {
-                // last cycle for PAL machines
-                endOfRasterline();
-            }			
-            break;
-        case 64: 
-            vic.cycle64();
-            EXECUTE(64);			
-            break;
-        case 65: 
-            vic.cycle65();
-            EXECUTE(65);
-            endOfRasterline();
-            break;
-            
-        default:
-            // can't reach
-            assert(false);
-            return false;
-    }
+    if (isFirstCycle) beginOfRasterline();
+    (vic.*vicfunc[vic.getChipModel()][rasterlineCycle])();
+    bool result = _executeOneCycle();
+    if (isLastCycle) endOfRasterline();
     
     return result;
 }
@@ -621,19 +427,83 @@ C64::executeOneCycle()
 bool
 C64::executeOneLine()
 {
-    uint8_t lastCycle = vic.getCyclesPerRasterline();
+    void (VIC::**table)(void) = vicfunc[vic.getChipModel()];
+    unsigned lastCycle = vic.getCyclesPerRasterline();
+    
+    if (rasterlineCycle == 1)
+        beginOfRasterline();
+    
     for (unsigned i = rasterlineCycle; i <= lastCycle; i++) {
-        if (!executeOneCycle())
+        
+        (vic.*table[i])();
+        if (!_executeOneCycle()) {
+            if (i == lastCycle)
+                endOfRasterline();
             return false;
+        }
     }
+    
+    endOfRasterline();
     return true;
 }
 
+bool
+C64::runFrames(uint64_t n)
+{
+    assert(isHalted());
+    if (!isHalted())
+        return false;
+    
+    bool result = true;
+    uint64_t targetFrame = frame + n;
+    
+    cpu.clearErrorState();
+    floppy.cpu.clearErrorState();
+    
+    batchMode = true;
+    while (frame < targetFrame) {
+        if (!executeOneLine()) {
+            result = false;
+            break;
+        }
+    }
+    batchMode = false;
+    
+    return result;
+}
+
+bool
+C64::runUntilCycle(uint64_t c)
+{
+    assert(isHalted());
+    if (!isHalted())
+        return false;
+    
+    bool result = true;
+    
+    cpu.clearErrorState();
+    floppy.cpu.clearErrorState();
+    
+    batchMode = true;
+    while (cycle < c) {
+        if (!executeOneCycle()) {
+            result = false;
+            break;
+        }
+    }
+    batchMode = false;
+    
+    return result;
+}
+
 void
 C64::beginOfRasterline()
 {
     // First cycle of rasterline
     if (rasterline == 0) {
+        
+        // Decide if this frame is synthesized or skipped
+        vic.setSilent(silent || (warp && frame % warpRenderInterval != 0));
         vic.beginFrame();
     }
     vic.beginRasterline(rasterline);
@@ -642,6 +512,8 @@ C64::beginOfRasterline()
 void
 C64::endOfRasterline()
 {
+    bool endOfFrame = false;
+    
     vic.endRasterline();
     rasterlineCycle = 1;
     rasterline++;
@@ -649,6 +521,7 @@ C64::endOfRasterline()
     if (rasterline >= vic.getRasterlinesPerFrame()) {
         
         // Last rasterline of frame
+        endOfFrame = true;
         rasterline = 0;
         vic.endFrame();
         frame++;
@@ -659,11 +532,6 @@ C64::endOfRasterline()
             cia2.incrementTOD();
         }
         
-        // Take a snapshot once in a while
-        if (frame % (vic.getFramesPerSecond() * 4) == 0) {
-            takeTimeTravelSnapshot();
-        }
-        
         // Execute remaining SID cycles
         sid.executeUntil(cycle);
         
@@ -672,10 +540,21 @@ C64::endOfRasterline()
         expansionport.execute();
         
         // Count some sheep (zzzzzz) ...
-        if (!getWarp()) {
+        if (!getWarp() && !batchMode) {
             synchronizeTiming();
         } 
     }
+    
+    // Apply recorded or pending user input
+    if (recording || replaying) {
+        processInputs();
+    }
+    
+    // Take a snapshot once in a while. Nothing is left to do for this rasterline, hence
+    // continuing from a restored snapshot is the same as having never left.
+    if (endOfFrame && timeTravelInterval && frame % timeTravelInterval == 0) {
+        takeTimeTravelSnapshot();
+    }
 }
 
 
@@ -711,6 +590,9 @@ C64::setWarp(bool b)
 void
 C64::setAlwaysWarp(bool b)
 {
+    if (interceptInput(INPUT_ALWAYS_WARP, b))
+        return;
+    
     if (alwaysWarp == b)
         return;
     
@@ -724,13 +606,24 @@ C64::setAlwaysWarp(bool b)
 void
 C64::setWarpLoad(bool b)
 {
+    if (interceptInput(INPUT_WARP_LOAD, b))
+        return;
+    
 	warpLoad = b;
 }
 
+void
+C64::setSilent(bool b)
+{
+    silent = b;
+    vic.setSilent(b);
+    sid.setSilent(b);
+}
+
 void
 C64::restartTimer()
 {
-    uint64_t kernelNow = mach_absolute_time();
+    uint64_t kernelNow = kernelTime();
     uint64_t nanoNow = abs_to_nanos(kernelNow);
     
     nanoTargetTime = nanoNow + vic.getFrameDelay();
@@ -745,7 +638,7 @@ C64::synchronizeTiming()
     int64_t kernelTargetTime = nanos_to_abs(nanoTargetTime);
     
     // Check how long we're supposed to sleep
-    int64_t timediff = kernelTargetTime - (int64_t)mach_absolute_time();
+    int64_t timediff = kernelTargetTime - (int64_t)kernelTime();
     if (timediff > 200000000 /* 0.2 sec */) {
         
         // The emulator seems to be out of sync, so we better reset the synchronization timer
@@ -756,7 +649,7 @@ C64::synchronizeTiming()
     }
     
     // Sleep and update target timer
-    // debug(2, "%p Sleeping for %lld\n", this, kernelTargetTime - mach_absolute_time());
+    // debug(2, "%p Sleeping for %lld\n", this, kernelTargetTime - kernelTime());
     int64_t jitter = sleepUntil(kernelTargetTime, earlyWakeup);
     nanoTargetTime += vic.getFrameDelay();
     
@@ -840,25 +733,52 @@ C64::loadRom(const char *filename)
 //! @functiongroup Loading and saving snapshots
 //
 
-void C64::loadFromSnapshotUnsafe(Snapshot *snapshot)
+bool C64::loadFromSnapshotUnsafe(Snapshot *snapshot)
 {    
-    uint8_t *ptr;
+    if (snapshot == NULL || snapshot->getData() == NULL || !loadStateUnsafe(snapshot))
+        return false;
     
-    if (snapshot && (ptr = snapshot->getData())) {
-        loadFromBuffer(&ptr);
-        keyboard.releaseAll(); // Avoid constantly pressed keys
-        ping();
-    }
+    keyboard.releaseAll(); // Avoid constantly pressed keys
+    beginEpoch();
+    ping();
+    return true;
 }
 
-void
+bool
 C64::loadFromSnapshotSafe(Snapshot *snapshot)
 {
     debug(1, "C64::loadFromSnapshotSafe\n");
 
+    bool result;
+    
     suspend();
-    loadFromSnapshotUnsafe(snapshot);
+    result = loadFromSnapshotUnsafe(snapshot);
     resume();
+    
+    return result;
+}
+
+bool
+C64::loadStateUnsafe(Snapshot *snapshot)
+{
+    uint8_t *ptr = snapshot->getData();
+    
+    if (!loadBlobTable(&ptr, snapshot->getDataSize())) {
+        warn("Snapshot contains a malformed image table\n");
+        return false;
+    }
+    setForeignByteOrder(snapshot->hasForeignByteOrder());
+    loadFromBuffer(&ptr);
+    setForeignByteOrder(false);
+    mem.updatePeekPokeLookupTables(); // Lookup tables are not part of the snapshot
+    return true;
+}
+
+void
+C64::beginEpoch()
+{
+    epoch++;
+    firstEpochEvent = recording ? recording.load()->numEvents() : replaying ? replayPosition : 0;
 }
 
 bool
@@ -871,6 +791,9 @@ C64::restoreHistoricSnapshotUnsafe(unsigned nr)
     
     loadFromSnapshotUnsafe(s);
     
+    // Rewinding may continue from here
+    epoch = history.getEpoch(nr);
+    
     return true;
 }
 
@@ -888,27 +811,228 @@ C64::restoreHistoricSnapshotSafe(unsigned nr)
     return result;
 }
 
-void
+bool
+C64::rewindUnsafe(uint64_t targetCycle)
+{
+    worker.waitUntilIdle();
+    
+    int nr = history.find(targetCycle, epoch);
+    if (nr < 0 || !history.restore(nr, historicSnapshot))
+        return false;
+    
+    debug(2, "Rewinding from cycle %llu to %llu\n", cycle, targetCycle);
+    
+    if (!loadStateUnsafe(historicSnapshot))
+        return false;
+    
+    // The future is going to be rewritten
+    history.discardLatest(nr);
+    
+    // Replay the input of the current epoch that has been applied after the snapshot
+    pthread_mutex_lock(&inputLock);
+    InputLog *recorded = recording;
+    InputLog *log = recording ? recording : replaying;
+    if (log) {
+        replayPosition = firstEpochEvent;
+        while (replayPosition < log->numEvents() && log->getEvent(replayPosition)->cycle <= cycle)
+            replayPosition++;
+        replaying = replayPosition < log->numEvents() ? log : NULL;
+    }
+    recording = NULL;
+    pthread_mutex_unlock(&inputLock);
+    
+    // Re-execute silently, except for the two frames preceding the target
+    uint64_t frameCycles = (uint64_t)vic.getCyclesPerRasterline() * vic.getRasterlinesPerFrame();
+    uint64_t renderCycle = targetCycle > 2 * frameCycles ? targetCycle - 2 * frameCycles : 0;
+    bool wasSilent = silent;
+    bool wasBatchMode = batchMode;
+    unsigned interval = timeTravelInterval;
+    bool result = true;
+    
+    cpu.clearErrorState();
+    floppy.cpu.clearErrorState();
+    
+    // The restored history is complete. Taking snapshots again would only slow us down.
+    batchMode = true;
+    timeTravelInterval = 0;
+    setSilent(true);
+    while (result && cycle < targetCycle) {
+        if (cycle >= renderCycle && silent != wasSilent)
+            setSilent(wasSilent);
+        result = executeOneCycle();
+    }
+    setSilent(wasSilent);
+    timeTravelInterval = interval;
+    batchMode = wasBatchMode;
+    
+    // Recorded events following the target are discarded
+    pthread_mutex_lock(&inputLock);
+    if (recorded) {
+        recorded->truncate(replaying ? replayPosition : recorded->numEvents());
+        recording = recorded;
+        replaying = NULL;
+    }
+    pthread_mutex_unlock(&inputLock);
+    
+    // Keys held at the target are released like any other (recorded) input
+    for (uint8_t row = 0; row < 8; row++)
+        for (uint8_t col = 0; col < 8; col++)
+            if (keyboard.keyIsPressed(row, col))
+                keyboard.releaseKey(row, col);
+    
+    ping();
+    return result;
+}
+
+bool
+C64::rewindSafe(uint64_t targetCycle)
+{
+    debug(1, "C64::rewindSafe (%llu)\n", targetCycle);
+    
+    bool result;
+    
+    suspend();
+    result = rewindUnsafe(targetCycle);
+    resume();
+    
+    return result;
+}
+
+bool
 C64::saveToSnapshotUnsafe(Snapshot *snapshot)
 {
     if (snapshot == NULL)
-        return;
+        return false;
+    
+    // Snapshots leaving the process need to carry the referenced ROM and cartridge images
+    BlobList blobs;
+    blobs.count = 0;
+    if (!collectBlobs(&blobs)) {
+        warn("Cannot save the state: A memory image could not be added to the blob store\n");
+        return false;
+    }
     
     snapshot->setTimestamp(time(NULL));
-    snapshot->takeScreenshot((uint32_t *)vic.screenBuffer(), isPAL());
+    snapshot->takeScreenshot(vic.screenIndexBuffer(), vic.getColors(), isPAL());
     
-    snapshot->alloc(stateSize());
+    snapshot->alloc(blobTableSize(&blobs) + stateSize());
     uint8_t *ptr = snapshot->getData();
+    saveBlobTable(&ptr, &blobs);
     saveToBuffer(&ptr);
+    return true;
+}
+
+bool
+C64::updateSnapshotUnsafe(Snapshot *snapshot)
+{
+    assert(snapshot != NULL);
+    
+    // The images referenced by the state are kept in the blob store
+    BlobList blobs;
+    blobs.count = 0;
+    if (!collectBlobs(&blobs)) {
+        warn("Cannot save the state: A memory image could not be added to the blob store\n");
+        return false;
+    }
+    blobs.count = 0;
+    
+    snapshot->setTimestamp(time(NULL));
+    
+    // Time travel snapshots are only displayed as small previews
+    snapshot->takeScreenshot(vic.screenIndexBuffer(), vic.getColors(), isPAL(), 2);
+    
+    // The state layout changes if a cartridge or tape is attached or detached
+    size_t size = blobTableSize(&blobs) + stateSize();
+    if (snapshot->getData() == NULL || snapshot->getDataSize() != size) {
+        snapshot->alloc(size);
+        markAllPagesDirty();
+    }
+    
+    uint8_t *ptr = snapshot->getData();
+    saveBlobTable(&ptr, &blobs);
+    setIncrementalSave(true);
+    saveToBuffer(&ptr);
+    setIncrementalSave(false);
+    return true;
+}
+
+size_t
+C64::blobTableSize(BlobList *list)
+{
+    size_t result = 4;
+    
+    for (unsigned i = 0; i < list->count; i++)
+        result += 12 + list->size[i];
+    
+    return result;
 }
 
 void
+C64::saveBlobTable(uint8_t **buffer, BlobList *list)
+{
+    write32(buffer, list->count);
+    
+    for (unsigned i = 0; i < list->count; i++) {
+        write64(buffer, list->hash[i]);
+        write32(buffer, list->size[i]);
+        bool found = BlobStore::get(list->hash[i], list->size[i], *buffer);
+        assert(found); (void)found;
+        *buffer += list->size[i];
+    }
+}
+
+bool
+C64::loadBlobTable(uint8_t **buffer, size_t length)
+{
+    if (length < 4)
+        return false;
+    
+    uint32_t count = read32(buffer);
+    length -= 4;
+    
+    for (unsigned i = 0; i < count; i++) {
+        
+        if (length < 12)
+            return false;
+        uint64_t hash = read64(buffer);
+        uint32_t size = read32(buffer);
+        length -= 12;
+        
+        if (size > length)
+            return false;
+        
+        uint64_t stored;
+        if (!BlobStore::add(*buffer, size, &stored) || stored != hash) {
+            warn("Snapshot contains a corrupted memory image (%016llX)\n", (unsigned long long)hash);
+            return false;
+        }
+        *buffer += size;
+        length -= size;
+    }
+    
+    return true;
+}
+
+bool
 C64::saveToSnapshotSafe(Snapshot *snapshot)
 {
     debug(1, "C64::saveToSnapshotSafe\n");
 
     suspend();
-    saveToSnapshotUnsafe(snapshot);
+    bool result = saveToSnapshotUnsafe(snapshot);
+    resume();
+    
+    return result;
+}
+
+void
+C64::saveSnapshotFileSafe(const char *path)
+{
+    assert(path != NULL);
+    
+    suspend();
+    if (saveToSnapshotUnsafe(fileSnapshot))
+        worker.writeToFile(fileSnapshot, path);
     resume();
 }
 
@@ -916,7 +1040,11 @@ Snapshot *
 C64::takeSnapshotUnsafe()
 {
     Snapshot *snapshot = new Snapshot;
-    saveToSnapshotUnsafe(snapshot);
+    
+    if (!saveToSnapshotUnsafe(snapshot)) {
+        delete snapshot;
+        return NULL;
+    }
     return snapshot;
 }
 
@@ -935,38 +1063,35 @@ C64::takeSnapshotSafe()
 void
 C64::takeTimeTravelSnapshot()
 {
-    debug(3, "Taking time-travel snapshop %d\n", backInTimeWritePtr);
+    debug(3, "Taking time-travel snapshop %d\n", history.numSnapshots());
     
-    saveToSnapshotUnsafe(backInTimeHistory[backInTimeWritePtr]);
-    putMessage(MSG_SNAPSHOT_TAKEN);
-
-    backInTimeWritePtr = (backInTimeWritePtr + 1) % BACK_IN_TIME_BUFFER_SIZE;
+    // The snapshot is dropped if the worker is still busy with the previous ones
+    if (updateSnapshotUnsafe(timeTravelSnapshot) &&
+        worker.addToHistory(timeTravelSnapshot, cycle, epoch))
+        putMessage(MSG_SNAPSHOT_TAKEN);
 }
 
 unsigned
 C64::numHistoricSnapshots()
 {
-    for (int i = BACK_IN_TIME_BUFFER_SIZE - 1; i >= 0; i--) {
-        if (!backInTimeHistory[i]->isEmpty())
-            return i + 1;
-    }
-    return 0;
+    worker.waitUntilIdle();
+    return history.numSnapshots();
 }
 
 Snapshot *
 C64::getHistoricSnapshot(int nr)
 {
-    if (nr >= BACK_IN_TIME_BUFFER_SIZE)
-        return NULL;
-    
-    int pos = (BACK_IN_TIME_BUFFER_SIZE + backInTimeWritePtr - 1 - nr) % BACK_IN_TIME_BUFFER_SIZE;
-    Snapshot *snapshot = backInTimeHistory[pos];
-    assert(snapshot != NULL);
-    
-    if (snapshot->isEmpty())
+    worker.waitUntilIdle();
+    if (nr < 0 || !history.restore(nr, historicSnapshot))
         return NULL;
     
-    return snapshot;
+    return historicSnapshot;
+}
+
+void
+C64::setTimeTravelBudget(unsigned mb)
+{
+    history.setBudget((size_t)mb * 1024 * 1024);
 }
 
 
@@ -1002,6 +1127,9 @@ C64::insertDisk(Archive *a)
 {
     assert(a != NULL);
     
+    if (interceptInput(INPUT_INSERT_DISK, 0, 0, a))
+        return true;
+    
     floppy.insertDisk(a);
     return true;
     
@@ -1013,8 +1141,7 @@ C64::mountArchive(Archive *a)
 	if (a == NULL)
 		return false;
 		
-	floppy.insertDisk(a);
-	return true;
+	return insertDisk(a);
 }
 
 bool
@@ -1023,6 +1150,9 @@ C64::insertTape(TAPContainer *a)
     if (a == NULL)
         return false;
     
+    if (interceptInput(INPUT_INSERT_TAPE, 0, 0, a))
+        return true;
+    
     debug(1, "Inserting TAP archive into datasette\n");
     
     suspend();
@@ -1041,6 +1171,11 @@ C64::attachCartridgeAndReset(CRTContainer *container)
     if (!cartridge)
         return false;
     
+    if (interceptInput(INPUT_ATTACH_CARTRIDGE, 0, 0, container)) {
+        delete cartridge;
+        return true;
+    }
+    
     suspend();
     expansionport.attachCartridge(cartridge);
     reset();
@@ -1051,6 +1186,9 @@ C64::attachCartridgeAndReset(CRTContainer *container)
 void
 C64::detachCartridgeAndReset()
 {
+    if (interceptInput(INPUT_DETACH_CARTRIDGE))
+        return;
+    
     if (expansionport.getCartridgeAttached()) {
         suspend();
         expansionport.detachCartridge();
@@ -1064,3 +1202,330 @@ C64::isCartridgeAttached()
 {
     return expansionport.getCartridgeAttached();
 }
+
+
+//
+//! @functiongroup Recording and replaying user input
+//
+
+void
+C64::startRecording()
+{
+    suspend();
+    
+    stopReplay();
+    delete stopRecording();
+    
+    // Loading a snapshot releases all keys. Hence, recording must start that way, too.
+    keyboard.releaseAll();
+    
+    Snapshot *anchor = takeSnapshotUnsafe();
+    if (anchor != NULL) {
+        
+        InputLog *log = new InputLog();
+        log->setAnchor(anchor);
+        
+        pthread_mutex_lock(&inputLock);
+        recording = log;
+        beginEpoch();
+        pthread_mutex_unlock(&inputLock);
+    }
+    
+    resume();
+}
+
+InputLog *
+C64::stopRecording()
+{
+    pthread_mutex_lock(&inputLock);
+    
+    InputLog *result = recording;
+    recording = NULL;
+    
+    // Inputs that have not been applied yet are discarded
+    for (unsigned i = 0; i < numPendingInputs; i++)
+        free(pendingInputs[i].payload);
+    numPendingInputs = 0;
+    
+    pthread_mutex_unlock(&inputLock);
+    return result;
+}
+
+bool
+C64::startReplay(InputLog *log)
+{
+    assert(log != NULL);
+    
+    if (isRecording() || log->getAnchor() == NULL)
+        return false;
+    
+    suspend();
+    if (!loadFromSnapshotUnsafe(log->getAnchor())) {
+        resume();
+        return false;
+    }
+    
+    pthread_mutex_lock(&inputLock);
+    replaying = log;
+    replayPosition = 0;
+    firstEpochEvent = 0;
+    pthread_mutex_unlock(&inputLock);
+    
+    resume();
+    return true;
+}
+
+void
+C64::stopReplay()
+{
+    pthread_mutex_lock(&inputLock);
+    replaying = NULL;
+    pthread_mutex_unlock(&inputLock);
+}
+
+bool
+C64::startCapture(const char *path)
+{
+    suspend();
+    bool result = capture.start(path, vic.getFramesPerSecond(), sid.getSampleRate(), vic.getColors());
+    resume();
+    
+    return result;
+}
+
+void
+C64::stopCapture()
+{
+    suspend();
+    capture.stop();
+    resume();
+}
+
+bool
+C64::interceptInput(InputEventType type, uint8_t param1, uint8_t param2, Container *media)
+{
+    // Fast path
+    if (recording == NULL && replaying == NULL)
+        return false;
+    
+    pthread_mutex_lock(&inputLock);
+    
+    // Inputs applied by processInputs() pass through
+    bool result = !applyingInput && (recording || replaying);
+    
+    // While replaying, live input is discarded. While recording, it is queued.
+    if (result && recording) {
+        
+        if (numPendingInputs == MAX_PENDING_INPUTS) {
+            
+            warn("Too many pending inputs. Input is lost.\n");
+            
+        } else {
+            
+            InputEvent *event = &pendingInputs[numPendingInputs];
+            event->cycle = 0;
+            event->type = type;
+            event->param[0] = param1;
+            event->param[1] = param2;
+            event->payload = NULL;
+            event->payloadSize = 0;
+            
+            if (media) {
+                
+                // Disks that cannot be encoded directly are recorded as converted by VC1541
+                D64Archive *converted = NULL;
+                if (type == INPUT_INSERT_DISK) {
+                    ContainerType t = media->type();
+                    if (t != D64_CONTAINER && t != G64_CONTAINER && t != NIB_CONTAINER)
+                        media = converted = D64Archive::makeD64ArchiveWithAnyArchive((Archive *)media);
+                    if (media)
+                        event->param[0] = (uint8_t)media->type();
+                }
+                
+                if (media && (event->payloadSize = media->writeToBuffer(NULL)) != 0) {
+                    event->payload = (uint8_t *)malloc(event->payloadSize);
+                    media->writeToBuffer(event->payload);
+                }
+                delete converted;
+            }
+            
+            numPendingInputs++;
+        }
+    }
+    
+    pthread_mutex_unlock(&inputLock);
+    return result;
+}
+
+void
+C64::processInputs()
+{
+    pthread_mutex_lock(&inputLock);
+    applyingInput = true;
+    
+    if (InputLog *log = recording) {
+        
+        for (unsigned i = 0; i < numPendingInputs; i++) {
+            
+            // Each event is tagged with the cycle it is applied in (reset clears the counter).
+            // It is recorded first, because a reset starts a new epoch behind the event.
+            pendingInputs[i].cycle = cycle;
+            if (log->append(&pendingInputs[i])) {
+                applyInput(&pendingInputs[i]);
+            } else {
+                warn("Input log is out of memory. Input is lost.\n");
+                free(pendingInputs[i].payload);
+            }
+        }
+        numPendingInputs = 0;
+    }
+    
+    if (InputLog *log = replaying) {
+        
+        while (replayPosition < log->numEvents() && log->getEvent(replayPosition)->cycle <= cycle) {
+            applyInput(log->getEvent(replayPosition++));
+        }
+        
+        if (replayPosition == log->numEvents()) {
+            debug(1, "Replay finished at cycle %llu\n", cycle);
+            replaying = NULL;
+        }
+    }
+    
+    applyingInput = false;
+    pthread_mutex_unlock(&inputLock);
+}
+
+void
+C64::applyInput(InputEvent *event)
+{
+    uint8_t p1 = event->param[0];
+    uint8_t p2 = event->param[1];
+    
+    switch (event->type) {
+            
+        case INPUT_KEY_PRESS:
+            keyboard.pressKey(p1, p2);
+            break;
+            
+        case INPUT_KEY_RELEASE:
+            keyboard.releaseKey(p1, p2);
+            break;
+            
+        case INPUT_RESTORE_PRESS:
+            keyboard.pressRestoreKey();
+            break;
+            
+        case INPUT_RESTORE_RELEASE:
+            keyboard.releaseRestoreKey();
+            break;
+            
+        case INPUT_JOYSTICK:
+            (p1 ? joystickB : joystickA).trigger((JoystickEvent)p2);
+            break;
+            
+        case INPUT_ALWAYS_WARP:
+            setAlwaysWarp(p1);
+            break;
+            
+        case INPUT_WARP_LOAD:
+            setWarpLoad(p1);
+            break;
+            
+        case INPUT_INSERT_DISK:
+        {
+            Archive *archive = NULL;
+            
+            switch (p1) {
+                case D64_CONTAINER:
+                    archive = D64Archive::makeD64ArchiveWithBuffer(event->payload, event->payloadSize);
+                    break;
+                case G64_CONTAINER:
+                    archive = G64Archive::makeG64ArchiveWithBuffer(event->payload, event->payloadSize);
+                    break;
+                case NIB_CONTAINER:
+                    archive = NIBArchive::makeNIBArchiveWithBuffer(event->payload, event->payloadSize);
+                    break;
+                default:
+                    break;
+            }
+            if (archive) {
+                floppy.insertDisk(archive);
+                delete archive;
+            } else {
+                warn("Failed to replay disk insertion\n");
+            }
+            break;
+        }
+            
+        case INPUT_EJECT_DISK:
+            floppy.ejectDisk();
+            break;
+            
+        case INPUT_INSERT_TAPE:
+        {
+            TAPContainer *tape = TAPContainer::makeTAPContainerWithBuffer(event->payload, event->payloadSize);
+            if (tape) {
+                datasette.insertTape(tape);
+                delete tape;
+            } else {
+                warn("Failed to replay tape insertion\n");
+            }
+            break;
+        }
+            
+        case INPUT_EJECT_TAPE:
+            datasette.ejectTape();
+            break;
+            
+        case INPUT_ATTACH_CARTRIDGE:
+        {
+            CRTContainer *container = CRTContainer::makeCRTContainerWithBuffer(event->payload, event->payloadSize);
+            Cartridge *cartridge = container ? Cartridge::makeCartridgeWithCRTContainer(this, container) : NULL;
+            if (cartridge) {
+                expansionport.attachCartridge(cartridge);
+                resetReplayable();
+            } else {
+                warn("Failed to replay cartridge attachment\n");
+            }
+            delete container;
+            break;
+        }
+            
+        case INPUT_DETACH_CARTRIDGE:
+            if (expansionport.getCartridgeAttached()) {
+                expansionport.detachCartridge();
+                resetReplayable();
+            }
+            break;
+            
+        case INPUT_RESET:
+            resetReplayable();
+            break;
+            
+        default:
+            warn("Unknown input event type %d\n", event->type);
+    }
+}
+
+void
+C64::resetReplayable()
+{
+    // TOD::reset() reads the host clock which differs between recording and replay
+    CIA *cias[] = { &cia1, &cia2 };
+    uint8_t hours[2], minutes[2], seconds[2];
+    
+    for (unsigned i = 0; i < 2; i++) {
+        hours[i] = cias[i]->tod.getTodHours();
+        minutes[i] = cias[i]->tod.getTodMinutes();
+        seconds[i] = cias[i]->tod.getTodSeconds();
+    }
+    
+    reset();
+    
+    for (unsigned i = 0; i < 2; i++) {
+        cias[i]->tod.setTodHours(hours[i]);
+        cias[i]->tod.setTodMinutes(minutes[i]);
+        cias[i]->tod.setTodSeconds(seconds[i]);
+    }
+}
@@ -63,9 +63,13 @@
 
 // General
 #include "Message.h"
+#include <atomic>
 
 // Loading and saving
 #include "Snapshot.h"
+#include "SnapshotWorker.h"
+#include "InputLog.h"
+#include "Capture.h"
 #include "T64Archive.h"
 #include "D64Archive.h"
 #include "G64Archive.h"
@@ -201,8 +205,6 @@ It has the same effect as switching a real C64 off and on again. Note that a
 
 
 
-#define BACK_IN_TIME_BUFFER_SIZE 16
-
 //! @class    A complete virtual C64
 class C64 : public VirtualComponent {
 
@@ -265,10 +267,18 @@ private:
     //! @brief    The emulators execution thread
     pthread_t p;
     
+    /*! @brief    Indicates if the execution thread is alive
+     *  @details  The thread handle p is only valid while this flag is set. The flag is cleared
+     *            by the thread itself when it terminates (see threadCleanup()).
+     */
+    std::atomic<bool> running;
+    
     /*! @brief    System timer information
-     *  @details  Used to put the emulation thread to sleep for the proper amount of time
+     *  @details  Used to put the emulation thread to sleep for the proper amount of time.
+     *            One kernel time unit equals numer / denom nanoseconds.
+     *  @see      kernelTimebase
      */
-    mach_timebase_info_data_t timebase;
+    struct { uint32_t numer; uint32_t denom; } timebase;
     
     /*! @brief    Wake-up time of the synchronization timer in nanoseconds
      *  @details  This value is recomputed each time the emulator thread is put to sleep
@@ -284,6 +294,25 @@ private:
     //! Indicates that we should run as fast as possible at least during disk operations
     bool warpLoad;
     
+    /*! @brief    Indicates that the emulator is driven synchronously by the caller
+     *  @details  The flag is set while runFrames() or runUntilCycle() is executing. In this mode,
+     *            timing synchronization is skipped and no messages are sent to the GUI.
+     */
+    bool batchMode;
+    
+    /*! @brief    Indicates if the emulator runs without producing any output
+     *  @details  In silent mode, the pixel engine synthesizes no pixels and ReSID computes no
+     *            samples. The emulated state evolves exactly as in normal mode.
+     */
+    bool silent;
+    
+    /*! @brief    Number of emulated frames per synthesized frame in warp mode
+     *  @details  While warping, the pixel engine runs silently in all frames except every n-th
+     *            one, which keeps the GUI updated without paying for frames nobody sees. The VIC
+     *            still executes its full timing logic in skipped frames. 1 renders all frames.
+     */
+    unsigned warpRenderInterval;
+    
     
     //
     // Message queue
@@ -299,6 +328,17 @@ private:
     // Executed cycle, rasterline, and frame
     //
 
+    //
+    // Cycle dispatching
+    //
+    
+    /*! @brief    VIC cycle handlers
+     *  @details  vicfunc[model][c] is the VIC function that is executed in rasterline cycle c
+     *            of a chip with the specified model. The tables are set up once in the
+     *            constructor and replace a big switch statement in the execution loop.
+     */
+    void (VIC::*vicfunc[2][66])(void);
+    
 	//! @brief    Elapsed C64 clock cycles since power up
 	uint64_t cycle;
     
@@ -329,11 +369,78 @@ private:
     // Time travel ring buffer
     //
     
-    //! @brief    Ring buffer for storing the time travel snapshot images
-    Snapshot *backInTimeHistory[BACK_IN_TIME_BUFFER_SIZE];
+    //! @brief    Delta compressed ring buffer storing the time travel snapshots
+    SnapshotHistory history;
+    
+    //! @brief    Background thread encoding time travel snapshots and writing snapshot files
+    SnapshotWorker worker;
+    
+public:
+    
+    //! @brief    Lossless recorder of the video and audio output
+    Capture capture;
+    
+private:
+    
+    //! @brief    Snapshot object used by saveSnapshotFileSafe()
+    Snapshot *fileSnapshot;
+    
+    /*! @brief    Snapshot object time travel snapshots are taken into
+     *  @details  The object is updated incrementally. It must not be written by any other function.
+     */
+    Snapshot *timeTravelSnapshot;
+    
+    //! @brief    Snapshot object returned by getHistoricSnapshot()
+    Snapshot *historicSnapshot;
+    
+    /*! @brief    Number of frames between two time travel snapshots
+     *  @details  Defaults to four seconds. A value of 0 disables time travel snapshots.
+     */
+    unsigned timeTravelInterval;
+    
+    /*! @brief    Number of the current epoch
+     *  @details  The epoch changes whenever the emulated timeline is interrupted, i.e., on reset,
+     *            when a snapshot is loaded, and when recording starts. Time travel snapshots are
+     *            tagged with the epoch, because cycle values of different epochs are unrelated
+     *            and rewinding cannot re-simulate across an interruption.
+     */
+    unsigned epoch;
+    
+    
+    //
+    // Input recording and replay
+    //
+    
+    //! @brief    Maximum number of inputs waiting to be recorded
+    static const unsigned MAX_PENDING_INPUTS = 256;
+    
+    /*! @brief    Input log that is currently recorded or NULL
+     *  @details  Only changed while holding inputLock. It is atomic, because user input is
+     *            checked against it without taking the lock (see interceptInput()).
+     */
+    std::atomic<InputLog *> recording;
+    
+    //! @brief    Input log that is currently replayed or NULL (see recording)
+    std::atomic<InputLog *> replaying;
     
-    //! @brief    Write pointer of the time travel ring buffer
-    unsigned backInTimeWritePtr;
+    //! @brief    Index of the next event to replay
+    unsigned replayPosition;
+    
+    //! @brief    Index of the first event of the current epoch in the recorded or replayed log
+    unsigned firstEpochEvent;
+    
+    /*! @brief    Inputs waiting to be applied by the emulation thread
+     *  @details  While recording, user inputs are not applied immediately. They are applied
+     *            and recorded at the end of the next rasterline which makes them reproducible.
+     */
+    InputEvent pendingInputs[MAX_PENDING_INPUTS];
+    unsigned numPendingInputs;
+    
+    //! @brief    Indicates that the emulation thread is applying a recorded or pending input
+    bool applyingInput;
+    
+    //! @brief    Protects the members above (recursive, because applying an input reenters)
+    pthread_mutex_t inputLock;
     
 
  
@@ -351,7 +458,9 @@ public:
 	//! @brief    Destructor
 	~C64();
 
-	//! @brief    Resets the virtual C64 and all of its sub components.
+	/*! @brief    Resets the virtual C64 and all of its sub components.
+     *  @details  The reset is not recorded as user input. The GUI resets the C64 via powerUp().
+     */
     void reset();
      
     //! @brief    Dumps current configuration into message queue
@@ -413,6 +522,15 @@ public:
     
     //! @brief    Sets the SID chip model
     void setChipModel(chip_model value) { sid.setChipModel(value); }
+    
+    //! @brief    Returns true iff the TOD clocks start with the time of the host
+    bool getHostClock() { return cia1.tod.getHostClock(); }
+    
+    /*! @brief    Makes the TOD clocks start with the time of the host or at 00:00:00
+     *  @details  Takes effect on the next reset. Headless runs should use the fixed start
+     *            time, so that two runs of the same workload end up in the same state.
+     */
+    void setHostClock(bool value) { cia1.tod.setHostClock(value); cia2.tod.setHostClock(value); }
 
     
     //
@@ -421,7 +539,8 @@ public:
 
     //! @brief    Cold starts the virtual C64
     /*! @details  The emulator and all of its sub components are reset and
-     *            the execution thread is started.
+     *            the execution thread is started. While recording, the reset is
+     *            recorded like any other user input.
      */
     void powerUp();
     
@@ -459,11 +578,54 @@ public:
 	//! @brief    Executes until the end of the rasterline
 	bool executeOneLine();
     
+    /*! @brief    Executes a certain number of frames in the calling thread
+     *  @details  Emulation stops when n frame boundaries have been crossed, i.e., when the
+     *            emulator has reached the first cycle of frame getFrame() + n. The function
+     *            runs as fast as possible without any timing synchronization and without
+     *            generating message queue traffic. It can only be used on halted emulators.
+     *  @result   false, if emulation stopped prematurely (breakpoint or CPU error).
+     */
+    bool runFrames(uint64_t n);
+    
+    /*! @brief    Executes until the cycle counter has reached a certain value
+     *  @details  Behaves like runFrames(), but stops at cycle granularity.
+     *  @result   false, if emulation stopped prematurely (breakpoint or CPU error).
+     */
+    bool runUntilCycle(uint64_t c);
+    
+    //! @brief    Returns true iff the emulator is driven by runFrames() or runUntilCycle()
+    bool getBatchMode() { return batchMode; }
+    
 private:
 	
+    //! @brief    Sets up the VIC cycle dispatch tables
+    void initVicFunctionTable();
+    
     //! @brief    Executes virtual C64 for one cycle
     bool executeOneCycle();
     
+    /*! @brief    Executes all components except VIC for one cycle
+     *  @details  Used by executeOneCycle() and executeOneLine() after the VIC function
+     *            of the current cycle has been invoked.
+     */
+    bool _executeOneCycle();
+    
+    /*! @brief    Returns the size of a blob table in bytes
+     *  @details  Each snapshot starts with a table of embedded ROM and cartridge images. Snapshots
+     *            written by saveToSnapshotUnsafe() embed all images the state refers to. Time travel
+     *            snapshots embed none, because the images are kept in the BlobStore anyway.
+     */
+    size_t blobTableSize(BlobList *list);
+    
+    //! @brief    Writes a blob table
+    void saveBlobTable(uint8_t **buffer, BlobList *list);
+    
+    /*! @brief    Reads a blob table and adds all images to the BlobStore
+     *  @param    length Number of bytes available in the buffer
+     *  @result   false, if the table exceeds the buffer or an image does not match its hash
+     */
+    bool loadBlobTable(uint8_t **buffer, size_t length);
+    
 	//! @brief    Invoked before executing the first cycle of rasterline
 	void beginOfRasterline();
 	
@@ -501,6 +663,18 @@ public:
     //! @brief    Setter for warpLoad.
     void setWarpLoad(bool b);
     
+    //! @brief    Returns true iff the emulator runs without producing video and audio output.
+    bool getSilent() { return silent; }
+    
+    //! @brief    Setter for silent.
+    void setSilent(bool b);
+    
+    //! @brief    Returns the number of emulated frames per synthesized frame in warp mode.
+    unsigned getWarpRenderInterval() { return warpRenderInterval; }
+    
+    //! @brief    Setter for warpRenderInterval.
+    void setWarpRenderInterval(unsigned n) { warpRenderInterval = n ? n : 1; }
+    
     /*! @brief    Restarts the synchronization timer
      *  @details  The function is invoked at launch time to initialize the timer and reinvoked
      *            when the synchronization timer gets out of sync.
@@ -559,14 +733,31 @@ public:
     /*! @brief    Loads the current state from a snapshot container
      *  @note     THIS FUNCTION IS NOT THREAD SAFE. 
      *            Only use on halted emulators or within the emulation thread
+     *  @result   false, if the snapshot is empty or malformed. The state is left untouched.
      *  @seealso  loadFromSnapshotSafe
      */
-    void loadFromSnapshotUnsafe(Snapshot *snapshot);
+    bool loadFromSnapshotUnsafe(Snapshot *snapshot);
 
     /*! @brief    Thread-safe version of loadFromSnapshotUnsafe
      *  @details  A running emulator is paused before performing the operation
      */
-    void loadFromSnapshotSafe(Snapshot *snapshot);
+    bool loadFromSnapshotSafe(Snapshot *snapshot);
+
+    /*! @brief    Overwrites the current state with the state stored in a snapshot
+     *  @details  Other than loadFromSnapshotUnsafe(), no keys are released and the epoch
+     *            does not change. Hence, the state is exactly the one stored.
+     *  @result   false, if the snapshot is malformed. The state is left untouched in that case.
+     *  @note     THIS FUNCTION IS NOT THREAD SAFE.
+     */
+    bool loadStateUnsafe(Snapshot *snapshot);
+    
+private:
+    
+    //! @brief    Starts a new epoch (see epoch)
+    void beginEpoch();
+    
+public:
+    
 
     /*! @brief    Overwrites current state with a snapshot stored in the time travel ringbuffer
      *  @details  Returns true iff the snapshot was found and restored successfully 
@@ -581,19 +772,57 @@ public:
      */
     bool restoreHistoricSnapshotSafe(unsigned nr);
 
+    /*! @brief    Rewinds the emulator to a previous cycle
+     *  @details  The latest time travel snapshot taken at or before the target cycle is restored
+     *            and the emulator re-executes in silent mode up to the target. Only the last two
+     *            frames are rendered. Recorded or replayed input is applied again. Without a
+     *            recording, user input from this period is unknown and the re-simulated past
+     *            may differ from the original one. All time travel snapshots and recorded events
+     *            following the target are discarded. No snapshots are taken while re-executing.
+     *            Restoring the snapshot takes about 2 ms, re-execution about 25 to 40 ms per
+     *            emulated second (see vc64bench rewind). With the default interval of four
+     *            seconds, a rewind hence takes up to 100 to 160 ms. Smaller intervals reduce the
+     *            latency accordingly.
+     *  @param    targetCycle  A cycle of the current epoch (see getCycles())
+     *  @result   false, if no time travel snapshot of the current epoch precedes the target or
+     *            if re-execution stopped prematurely (breakpoint or CPU error)
+     *  @note     THIS FUNCTION IS NOT THREAD SAFE.
+     *            Only use on halted emulators or within the emulation thread
+     *  @seealso  rewindSafe
+     */
+    bool rewindUnsafe(uint64_t targetCycle);
+
+    /*! @brief    Thread-safe version of rewindUnsafe
+     *  @details  A running emulator is paused before performing the operation
+     */
+    bool rewindSafe(uint64_t targetCycle);
+
     /*! @brief    Saves the current state into an existing snapshot.
      *  @note     Use this function inside the execution thread.
+     *  @result   false, if a referenced memory image could not be added to the blob store
      *  @seealso  saveToSnapshotSafe
      */
-    void saveToSnapshotUnsafe(Snapshot *snapshot);
+    bool saveToSnapshotUnsafe(Snapshot *snapshot);
     
     /*! @brief    Saves the current state into an existing snapshot.
      *  @note     Use this function outside the execution thread.
      *  @seealso  saveToSnapshotUnsafe
      */
-    void saveToSnapshotSafe(Snapshot *snapshot);
+    bool saveToSnapshotSafe(Snapshot *snapshot);
+    
+    /*! @brief    Updates a snapshot incrementally
+     *  @details  Only memory pages that have been modified since the previous incremental update
+     *            are written (C64 RAM, drive RAM, disk halftracks). All other state is written in
+     *            full. The snapshot must have been updated by this function before and must not have
+     *            been changed in between. Otherwise, the first update writes the complete state.
+     *  @result   false, if a referenced memory image could not be added to the blob store. The
+     *            snapshot is left untouched in that case.
+     *  @note     Use this function inside the execution thread.
+     */
+    bool updateSnapshotUnsafe(Snapshot *snapshot);
 
     /*! @brief    Creates a new snapshot object storing the current state.
+     *  @result   NULL, if the state could not be saved (see saveToSnapshotUnsafe())
      *  @note     Use this function inside the execution thread.
      *  @seealso  takeSnapshotSafe
      */
@@ -606,7 +835,15 @@ public:
     Snapshot *takeSnapshotSafe();
 
     
+    /*! @brief    Saves the current state into a compressed snapshot file
+     *  @details  The emulator is only paused while the state is copied. Compressing and
+     *            writing the file is done in the background.
+     *  @note     Use this function outside the execution thread.
+     */
+    void saveSnapshotFileSafe(const char *path);
+    
     /*! @brief    Takes a snapshot and stores it into the time travel ringbuffer
+     *  @details  The snapshot is copied into a pooled buffer and encoded in the background.
      *  @note     This function does not halt the emulator and must therefore be
      *            called inside the execution thread, only.
      */
@@ -618,16 +855,29 @@ public:
     // void takeSnapshotSafe();
 
     /*! @brief    Returns the number of previously taken snapshots
-     *  @result   Value between 0 and BACK_IN_TIME_BUFFER_SIZE
+     *  @result   Value between 0 and SnapshotHistory::MAX_SNAPSHOTS
      */
     unsigned numHistoricSnapshots();
     
     /*! @brief    Reads a snapshopt from the time travel ringbuffer
-     *  @details  The latest snapshot is indexed 0.
+     *  @details  The latest snapshot is indexed 0. The snapshot is decoded into an object
+     *            that is reused by the next call.
      *  @result   A reference to a snapshot, if present. NULL, otherwise.
      */
     Snapshot *getHistoricSnapshot(int nr);
     
+    //! @brief    Returns the memory budget of the time travel ringbuffer in MB
+    unsigned getTimeTravelBudget() { return (unsigned)(history.getBudget() / (1024 * 1024)); }
+    
+    //! @brief    Sets the memory budget of the time travel ringbuffer in MB
+    void setTimeTravelBudget(unsigned mb);
+    
+    //! @brief    Returns the number of frames between two time travel snapshots
+    unsigned getTimeTravelInterval() { return timeTravelInterval; }
+    
+    //! @brief    Sets the number of frames between two time travel snapshots (0 = off)
+    void setTimeTravelInterval(unsigned frames) { timeTravelInterval = frames; }
+    
 
     //
     //! @functiongroup Handling disks, tapes, and cartridges
@@ -663,6 +913,85 @@ public:
 	bool isCartridgeAttached();
 
     
+    //
+    //! @functiongroup Recording and replaying user input
+    //
+    
+    /*! @brief    Starts recording all user input
+     *  @details  The current state is saved as the starting point of the recording. All keys
+     *            are released beforehand, just as they are when a snapshot is loaded. Nothing is
+     *            recorded if the state cannot be saved.
+     */
+    void startRecording();
+    
+    /*! @brief    Stops recording
+     *  @result   The recorded log. The caller takes ownership.
+     */
+    InputLog *stopRecording();
+    
+    //! @brief    Returns true iff user input is being recorded
+    bool isRecording() { return recording != NULL; }
+    
+    /*! @brief    Restores the starting point of a recording and replays the recorded input
+     *  @details  User input is ignored until all events have been replayed. The log is
+     *            not copied and must not be deleted before replaying has finished.
+     *  @result   false, if input is being recorded or if the starting point cannot be restored
+     */
+    bool startReplay(InputLog *log);
+    
+    //! @brief    Stops replaying before all events have been replayed
+    void stopReplay();
+    
+    //! @brief    Returns true iff recorded input is being replayed
+    bool isReplaying() { return replaying != NULL; }
+    
+    /*! @brief    Checks if a user input needs to be deferred
+     *  @details  All functions handling user input call this function first. While recording,
+     *            the input is queued and applied by the emulation thread. While replaying,
+     *            the input is discarded.
+     *  @param    media   Disk, tape, or cartridge the input refers to (or NULL)
+     *  @result   true, if the caller must not apply the input itself
+     */
+    bool interceptInput(InputEventType type, uint8_t param1 = 0, uint8_t param2 = 0,
+                        Container *media = NULL);
+    
+private:
+    
+    /*! @brief    Applies pending or replays recorded input events
+     *  @note     Called by the emulation thread at the end of each rasterline while recording
+     *            or replaying.
+     */
+    void processInputs();
+    
+    //! @brief    Applies a single input event
+    void applyInput(InputEvent *event);
+    
+    /*! @brief    Resets the C64 as part of an input event
+     *  @details  Other than reset(), the time of day clocks keep their values, because seeding
+     *            them from the host clock would let the replay diverge from the recording.
+     */
+    void resetReplayable();
+    
+public:
+    
+    
+    //
+    //! @functiongroup Capturing video and audio
+    //
+    
+    /*! @brief    Starts writing all synthesized frames and audio samples into a capture file
+     *  @details  Frames skipped in silent mode or in warp mode are missing in the capture
+     *            (see warpRenderInterval). vc64capture converts the file into Y4M and WAV.
+     */
+    bool startCapture(const char *path);
+    
+    //! @brief    Finishes writing the capture file
+    void stopCapture();
+    
+    //! @brief    Returns true iff the video and audio output is being captured
+    bool isCapturing() { return capture.isCapturing(); }
+    
+    
     //
     //! @functiongroup Accessing the message queue
     //
@@ -677,7 +1006,7 @@ public:
     //! @brief    Feeds a notification message into message queue
     void putMessage(VC64Message msg) {
         
-       queue.putMessage(msg);
+        if (!batchMode) queue.putMessage(msg);
     }
 };
 
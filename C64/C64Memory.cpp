@@ -35,21 +35,24 @@ C64Memory::C64Memory()
     // Register snapshot items
     SnapshotItem items[] = {
         
-        { ram,          sizeof(ram),        KEEP_ON_RESET },
-        { colorRam,     sizeof(colorRam),   KEEP_ON_RESET },
-        { &rom[0xA000], 0x2000,             KEEP_ON_RESET  }, /* Basic ROM */
-        { &rom[0xD000], 0x1000,             KEEP_ON_RESET  }, /* Character ROM */
-        { &rom[0xE000], 0x2000,             KEEP_ON_RESET  }, /* Kernel ROM */
-        { &peekSrc,     sizeof(peekSrc),    KEEP_ON_RESET },
-        { &pokeTarget,  sizeof(pokeTarget), KEEP_ON_RESET },
-        { NULL,         0,                  0 }};
+        { "ram",       ram,          sizeof(ram),        KEEP_ON_RESET, ramDirty, 0x100 },
+        { "colorRam",  colorRam,     sizeof(colorRam),   KEEP_ON_RESET },
+        { "basicRom",  &rom[0xA000], 0x2000,             KEEP_ON_RESET | BLOB_REFERENCE, &romDirty[0] }, /* Basic ROM */
+        { "charRom",   &rom[0xD000], 0x1000,             KEEP_ON_RESET | BLOB_REFERENCE, &romDirty[1] }, /* Character ROM */
+        { "kernalRom", &rom[0xE000], 0x2000,             KEEP_ON_RESET | BLOB_REFERENCE, &romDirty[2] }, /* Kernel ROM */
+        { NULL,        NULL,         0,                  0 }};
     
     registerSnapshotItems(items, sizeof(items));
+    memset(ramDirty, 1, sizeof(ramDirty));
 }
 
 C64Memory::~C64Memory()
 {
 	debug(3, "  Releasing main memory at address %p...\n", this);
+    
+    free(charRomFile);
+    free(kernelRomFile);
+    free(basicRomFile);
 }
 
 void
@@ -67,21 +70,19 @@ C64Memory::reset()
     // Clear out initially visible screen memory to make it look nicer on startup
     for (unsigned i = 0; i < 1000; i++)
         ram[0x400+i] = 0x00;
+    memset(ramDirty, 1, sizeof(ramDirty));
     
     // Initialize color RAM with random numbers
+    randomSeed = 0;
     for (unsigned i = 0; i < sizeof(colorRam); i++) {
-        colorRam[i] = (rand() & 0xFF);
+        colorRam[i] = (rand_r(&randomSeed) & 0xFF);
     }
     
-    // Initialize peek source lookup table
-    for (unsigned i = 0x1; i <= 0xF; i++)
-        peekSrc[i] = M_RAM;
-    peekSrc[0x0] = M_PP;
-    
-    // Initialize poke source lookup table
+    // Initialize peek and poke lookup tables (processor port page takes the slow path)
     for (unsigned i = 0x1; i <= 0xF; i++)
-        pokeTarget[i] = M_RAM;
-    pokeTarget[0x0] = M_PP;
+        readBase[i] = writeBase[i] = vicReadBase[i] = ram;
+    readBase[0x0] = writeBase[0x0] = NULL;
+    vicReadBase[0x0] = ram;
 }
 
 
@@ -168,6 +169,7 @@ bool
 C64Memory::loadBasicRom(const char *filename)
 {
 	if (isBasicRom(filename)) {
+		free(basicRomFile);
 		basicRomFile = strdup(filename);
 		flashRom(filename, 0xA000);
 		return true;
@@ -179,6 +181,7 @@ bool
 C64Memory::loadCharRom(const char *filename)
 {
 	if (isCharRom(filename)) {
+		free(charRomFile);
 		charRomFile = strdup(filename);
 		flashRom(filename, 0xD000);
 		return true;
@@ -190,6 +193,7 @@ bool
 C64Memory::loadKernelRom(const char *filename)
 {
 	if (isKernelRom(filename)) {
+		free(kernelRomFile);
 		kernelRomFile = strdup(filename);
 		flashRom(filename, 0xE000);
 		return true;
@@ -228,44 +232,67 @@ C64Memory::updatePeekPokeLookupTables()
     // Set ultimax flag
     c64->setUltimax(exrom && !game);
 
-    // Set peek sources
+    // Set read base pointers
     MemorySource source;
     source = BankMap[index][0]; // 0x1000 - 0x7FFF (RAM or open)
     assert(source == M_RAM || source == M_NONE);
-    peekSrc[0x1] = source;
-    peekSrc[0x2] = source;
-    peekSrc[0x3] = source;
-    peekSrc[0x4] = source;
-    peekSrc[0x5] = source;
-    peekSrc[0x6] = source;
-    peekSrc[0x7] = source;
+    for (unsigned i = 0x1; i <= 0x7; i++)
+        readBase[i] = baseForSource(source);
 
     source = BankMap[index][1]; // 0x8000 - 0x9FFF (CRT or RAM)
     assert(source == M_CRTLO || source == M_CRTHI || source == M_RAM);
-    peekSrc[0x8] = source;
-    peekSrc[0x9] = source;
+    readBase[0x8] = readBase[0x9] = baseForSource(source);
 
     source = BankMap[index][2]; // 0xA000 - 0xBFFF (CRT, Basic ROM, RAM, or open)
     assert(source == M_CRTLO || source == M_CRTHI || source == M_BASIC ||
            source == M_RAM   || source == M_NONE);
-    peekSrc[0xA] = source;
-    peekSrc[0xB] = source;
+    readBase[0xA] = readBase[0xB] = baseForSource(source);
 
     source = BankMap[index][3]; // 0xC000 - 0xCFFF (RAM or open)
     assert(source == M_RAM || source == M_NONE);
-    peekSrc[0xC] = source;
+    readBase[0xC] = baseForSource(source);
 
     source = BankMap[index][4]; // 0xD000 - 0xDFFF (I/O, Character ROM, or RAM)
-    peekSrc[0xD] = source;
+    readBase[0xD] = baseForSource(source);
 
     source = BankMap[index][5]; // 0xE000 - 0xFFFF (CRT, Kernel ROM, or RAM)
-    peekSrc[0xE] = source;
-    peekSrc[0xF] = source;
+    readBase[0xE] = readBase[0xF] = baseForSource(source);
 
-    // Set poke targets
-    MemorySource target;
-    target = BankMap[index][4]; // 0xD000 - 0xDFFF (I/O or RAM)
-    pokeTarget[0xD] = (target == M_IO ? M_IO : M_RAM);
+    // Set write base pointers
+    source = BankMap[index][4]; // 0xD000 - 0xDFFF (I/O or RAM)
+    writeBase[0xD] = (source == M_IO ? NULL : ram);
+    
+    // Set the VIC's read base pointers (see VIC::memAccess)
+    for (unsigned i = 0x0; i <= 0xF; i++) {
+        if (c64->getUltimax()) {
+            // Cartridge ROM (ROMH) in the upper 4KB of each VIC bank
+            vicReadBase[i] = ((i & 0x3) == 0x3) ? NULL : ram;
+        } else {
+            vicReadBase[i] = ram;
+        }
+    }
+    if (!c64->getUltimax()) {
+        // Character ROM at 0x1000 - 0x1FFF in VIC banks 0 and 2
+        vicReadBase[0x1] = rom + 0xC000;
+        vicReadBase[0x9] = rom + 0x4000;
+    }
+}
+
+uint8_t *
+C64Memory::baseForSource(MemorySource source)
+{
+    switch (source) {
+            
+        case M_RAM:
+        case M_NONE: // what happens if RAM is unmapped?
+            return ram;
+            
+        case M_ROM:
+            return rom;
+            
+        default:
+            return NULL;
+    }
 }
 
 
@@ -323,42 +350,17 @@ uint8_t C64Memory::peekIO(uint16_t addr)
 	return 0;
 }
 
-uint8_t C64Memory::peek(uint16_t addr)
+uint8_t C64Memory::peekSlow(uint16_t addr)
 {
-    MemorySource src = peekSrc[addr >> 12];
-
-    /*
-    if (addr == 0x91) {
-        if (tmp == 2) c64->cpu.setTraceMode(true);
-        tmp++;
-        printf("Peek 0x91 PC: %04X\n", c64->cpu.getPC());
-    }
-    */
-    
-    switch(src) {
+    switch(addr >> 12) {
             
-        case M_RAM:
-            return ram[addr];
-            
-        case M_ROM:
-            return rom[addr];
-            
-        case M_IO:
-            return peekIO(addr);
-            
-        case M_CRTLO:
-        case M_CRTHI:
-
-            return c64->expansionport.peek(addr);
-            
-        case M_PP:
+        case 0x0: // Processor port
             
             uint8_t dir, ext, result;
             
             if (addr > 0x0001)
                 return ram[addr];
             
-            // Processor port
             dir = cpu->getPortDirection();
             ext = cpu->getExternalPortBits();
             
@@ -368,13 +370,13 @@ uint8_t C64Memory::peek(uint16_t addr)
             result = (addr == 0x0000) ? dir : (dir & cpu->getPort()) | (~dir & ext);
             return result;
 
-        case M_NONE:
-            // what happens if RAM is unmapped?
-            return ram[addr];
-
-        default:
-            assert(0);
-            return 0;
+        case 0xD: // I/O space
+            
+            return peekIO(addr);
+            
+        default: // Cartridge ROM
+            
+            return c64->expansionport.peek(addr);
     }
 }
 
@@ -414,7 +416,7 @@ void C64Memory::pokeIO(uint16_t addr, uint8_t value)
         case 0xA: // Color RAM
         case 0xB: // Color RAM
             
-            colorRam[addr - 0xD800] = (value & 0x0F) | (rand() & 0xF0);
+            colorRam[addr - 0xD800] = (value & 0x0F) | (rand_r(&randomSeed) & 0xF0);
             return;
             
         case 0xC: // CIA 1
@@ -466,7 +468,7 @@ void C64Memory::pokeIO(uint16_t addr, uint8_t value)
 	if (addr < 0xDC00) {
 		// Note: The color RAM only saves 4 Bit per address (one nibble)
 		// When reading the color RAM, the upper 4 bits will contain random values
-		colorRam[addr - 0xD800] = (value & 0x0F) | (rand() & 0xF0);
+		colorRam[addr - 0xD800] = (value & 0x0F) | (rand_r(&randomSeed) & 0xF0);
 		return;
 	}	
 
@@ -499,29 +501,18 @@ void C64Memory::pokeIO(uint16_t addr, uint8_t value)
 }
 #endif
 
-void C64Memory::poke(uint16_t addr, uint8_t value)
+void C64Memory::pokeSlow(uint16_t addr, uint8_t value)
 {	
-
-	MemorySource target = pokeTarget[addr >> 12];
-	
-	switch(target) {
+	switch(addr >> 12) {
 			
-		case M_RAM:
-			ram[addr] = value;
-			return;
-			
-		case M_IO:
-			pokeIO(addr, value);
-			return;
-			
-		case M_PP:
+		case 0x0: // Processor port
 			
 			if (addr > 0x0001) {
 				ram[addr] = value;
+				ramDirty[addr >> 8] = 1;
 				return;
 			}
 			
-			// Processor port
 			if (addr == 0x0000) {
 				cpu->setPortDirection(value);
                 updatePeekPokeLookupTables();
@@ -531,6 +522,10 @@ void C64Memory::poke(uint16_t addr, uint8_t value)
 			}
 			return;
 
+		case 0xD: // I/O space
+			pokeIO(addr, value);
+			return;
+			
 		default:
 			assert(0);
 			return;
@@ -101,12 +101,25 @@ public:
 	//! @brief    The C64s Random Access Memory
 	uint8_t ram[65536];
 
+    /*! @brief    Dirty map of the Random Access Memory
+     *  @details  ramDirty[i] is set whenever RAM page i (256 bytes) is written to. The map is
+     *            consumed by incremental snapshots.
+     *  @see      VirtualComponent::setIncrementalSave
+     */
+    uint8_t ramDirty[256];
+
     /*! @brief    The C64s color RAM
      *  @details  The color RAM is located in the I/O space, starting at $D800 and ending at $DBFF
      *            Only the lower four bits are accessible, the upper four bits are open and can show any value.
      */
     uint8_t colorRam[1024];
 
+    /*! @brief    Seed of the random number generator
+     *  @details  The generator provides the values of the open bits in color RAM. Each C64 instance
+     *            owns its own seed to keep multiple emulator instances independent of each other.
+     */
+    unsigned randomSeed;
+
     //! @brief    The C64s Read Only Memory
 	/*! @details  Only specific memory cells are valid ROM locations. In total, the C64 has three ROMs that
      *            are located at different addresses in the ROM space. Note, that the ROMs do not span over
@@ -114,6 +127,12 @@ public:
      */
     uint8_t rom[65536];
     
+    /*! @brief    Indicates that the Basic, Character, or Kernal ROM has been modified
+     *  @details  Modified ROMs are rehashed when the next snapshot is taken.
+     *  @see      BlobStore
+     */
+    uint8_t romDirty[3];
+    
 public:
     
     /*! @brief    Checks the integrity of a Basic ROM image.
@@ -221,14 +240,30 @@ public:
 
 private:
     
-    //! @brief    Lookup table for peek()
-    MemorySource peekSrc[16];
+    /*! @brief    Read base pointers for each 4KB page
+     *  @details  If a pointer is set, peek() serves the access directly from the referenced memory (RAM or
+     *            ROM) by indexing it with the full address. NULL selects the slow path, which is taken for
+     *            the processor port page, the I/O space, and cartridge ROM.
+     */
+    uint8_t *readBase[16];
     
-    //! @brief    Lookup table for poke()
-    MemorySource pokeTarget[16];
+    /*! @brief    Write base pointers for each 4KB page
+     *  @details  If a pointer is set, poke() writes directly into the referenced memory (always RAM).
+     *            NULL selects the slow path, which is taken for the processor port page and the I/O space.
+     */
+    uint8_t *writeBase[16];
+    
+    //! @brief    Returns the read base pointer for a page that is mapped to the specified source
+    uint8_t *baseForSource(MemorySource source);
     
 public:
     
+    /*! @brief    Read base pointers for the VIC's view of memory
+     *  @details  Same as readBase, but reflecting the memory mapping seen by the VIC chip. NULL selects
+     *            cartridge ROM which is visible in ultimax mode, only.
+     */
+    uint8_t *vicReadBase[16];
+    
     /*! @brief    Updates the peek and poke lookup tables.
      *  @details  The lookup values depend on three processor port bits and the cartridge exrom and game lines 
      */
@@ -247,23 +282,36 @@ public:
     uint8_t peekIO(uint16_t addr);
 
     /*! @brief    Reads a byte from memory.
-     *  @details  The memory source (RAM, ROM, or I/O space) is read from the poke lookup table.
+     *  @details  RAM and ROM accesses are served via the read base pointer table. All other accesses
+     *            are handled by peekSlow().
      */
-    uint8_t peek(uint16_t addr);
+    inline uint8_t peek(uint16_t addr) {
+        uint8_t *base = readBase[addr >> 12];
+        return base ? base[addr] : peekSlow(addr); }
+
+    //! @brief    Reads a byte from the processor port, the I/O space, or a cartridge.
+    uint8_t peekSlow(uint16_t addr);
 
     //! @brief    Write a byte into RAM.
-    void pokeRam(uint16_t addr, uint8_t value) { ram[addr] = value; }
+    void pokeRam(uint16_t addr, uint8_t value) { ram[addr] = value; ramDirty[addr >> 8] = 1; }
 
     //! @brief    Write a byte into ROM.
-    void pokeRom(uint16_t addr, uint8_t value) { rom[addr] = value; }
+    void pokeRom(uint16_t addr, uint8_t value) {
+        rom[addr] = value; romDirty[0] = romDirty[1] = romDirty[2] = 1; }
 
     //! @brief    Write a byte into I/O space.
     void pokeIO(uint16_t addr, uint8_t value);
 
     /*! @brief    Writes a byte into memory.
-     *  @details  The memory target (RAM, ROM, or I/O space) is read from the poke lookup table. 
+     *  @details  RAM accesses are served via the write base pointer table. All other accesses
+     *            are handled by pokeSlow().
      */
-    void poke(uint16_t addr, uint8_t value);
+    inline void poke(uint16_t addr, uint8_t value) {
+        uint8_t *base = writeBase[addr >> 12];
+        if (base) { base[addr] = value; ramDirty[addr >> 8] = 1; } else pokeSlow(addr, value); }
+
+    //! @brief    Writes a byte into the processor port or the I/O space.
+    void pokeSlow(uint16_t addr, uint8_t value);
 };
 
 #endif
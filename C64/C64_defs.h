@@ -12,7 +12,7 @@
 //! @brief Snapshot version number of this release
 #define V_MAJOR 1
 #define V_MINOR 7
-#define V_SUBMINOR 0
+#define V_SUBMINOR 4
 
 
 /*! @brief    Color schemes
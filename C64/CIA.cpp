@@ -22,6 +22,11 @@ CIA::CIA()
 {
 	setDescription("CIA");
     
+    sleeping = false;
+    idleCycles = 0;
+    wakeUpCycle = 0;
+    idleSleep = true;
+    
     // Register sub components
     VirtualComponent *subcomponents[] = { &tod, NULL };
     registerSubComponents(subcomponents, sizeof(subcomponents));
@@ -29,29 +34,29 @@ CIA::CIA()
     // Register snapshot items
     SnapshotItem items[] = {
         
-        { &delay,           sizeof(delay),          CLEAR_ON_RESET },
-        { &feed,            sizeof(feed),           CLEAR_ON_RESET },
-        { &CRA,             sizeof(CRA),            CLEAR_ON_RESET },
-        { &CRB,             sizeof(CRB),            CLEAR_ON_RESET },
-        { &ICR,             sizeof(ICR),            CLEAR_ON_RESET },
-        { &IMR,             sizeof(IMR),            CLEAR_ON_RESET },
-        { &PB67TimerMode,   sizeof(PB67TimerMode),  CLEAR_ON_RESET },
-        { &PB67TimerOut,    sizeof(PB67TimerOut),   CLEAR_ON_RESET },
-        { &PB67Toggle,      sizeof(PB67Toggle),     CLEAR_ON_RESET },
-        { &PALatch,         sizeof(PALatch),        CLEAR_ON_RESET },
-        { &PBLatch,         sizeof(PBLatch),        CLEAR_ON_RESET },
-        { &DDRA,            sizeof(DDRA),           CLEAR_ON_RESET },
-        { &DDRB,            sizeof(DDRB),           CLEAR_ON_RESET },
-        { &PA,              sizeof(PA),             CLEAR_ON_RESET },
-        { &PB,              sizeof(PB),             CLEAR_ON_RESET },
-        { &CNT,             sizeof(CNT),            CLEAR_ON_RESET },
-        { &INT,             sizeof(INT),            CLEAR_ON_RESET },
-        { &readICR,         sizeof(readICR),        CLEAR_ON_RESET },
-        { &counterA,        sizeof(counterA),       CLEAR_ON_RESET },
-        { &latchA,          sizeof(latchA),         CLEAR_ON_RESET },
-        { &counterB,        sizeof(counterB),       CLEAR_ON_RESET },
-        { &latchB,          sizeof(latchB),         CLEAR_ON_RESET },
-        { NULL,             0,                      0 }};
+        { "delay",         &delay,           sizeof(delay),          CLEAR_ON_RESET },
+        { "feed",          &feed,            sizeof(feed),           CLEAR_ON_RESET },
+        { "CRA",           &CRA,             sizeof(CRA),            CLEAR_ON_RESET },
+        { "CRB",           &CRB,             sizeof(CRB),            CLEAR_ON_RESET },
+        { "ICR",           &ICR,             sizeof(ICR),            CLEAR_ON_RESET },
+        { "IMR",           &IMR,             sizeof(IMR),            CLEAR_ON_RESET },
+        { "PB67TimerMode", &PB67TimerMode,   sizeof(PB67TimerMode),  CLEAR_ON_RESET },
+        { "PB67TimerOut",  &PB67TimerOut,    sizeof(PB67TimerOut),   CLEAR_ON_RESET },
+        { "PB67Toggle",    &PB67Toggle,      sizeof(PB67Toggle),     CLEAR_ON_RESET },
+        { "PALatch",       &PALatch,         sizeof(PALatch),        CLEAR_ON_RESET },
+        { "PBLatch",       &PBLatch,         sizeof(PBLatch),        CLEAR_ON_RESET },
+        { "DDRA",          &DDRA,            sizeof(DDRA),           CLEAR_ON_RESET },
+        { "DDRB",          &DDRB,            sizeof(DDRB),           CLEAR_ON_RESET },
+        { "PA",            &PA,              sizeof(PA),             CLEAR_ON_RESET },
+        { "PB",            &PB,              sizeof(PB),             CLEAR_ON_RESET },
+        { "CNT",           &CNT,             sizeof(CNT),            CLEAR_ON_RESET },
+        { "INT",           &INT,             sizeof(INT),            CLEAR_ON_RESET },
+        { "readICR",       &readICR,         sizeof(readICR),        CLEAR_ON_RESET },
+        { "counterA",      &counterA,        sizeof(counterA),       CLEAR_ON_RESET },
+        { "latchA",        &latchA,          sizeof(latchA),         CLEAR_ON_RESET },
+        { "counterB",      &counterB,        sizeof(counterB),       CLEAR_ON_RESET },
+        { "latchB",        &latchB,          sizeof(latchB),         CLEAR_ON_RESET },
+        { NULL,            NULL,             0,                      0 }};
 
     registerSnapshotItems(items, sizeof(items));
 }
@@ -60,6 +65,24 @@ CIA::~CIA()
 {
 }
 
+void
+CIA::loadFromBuffer(uint8_t **buffer)
+{
+    VirtualComponent::loadFromBuffer(buffer);
+    
+    // The restored state is executed cycle by cycle until the CIA falls asleep again
+    sleeping = false;
+    idleCycles = 0;
+    wakeUpCycle = 0;
+}
+
+void
+CIA::saveToBuffer(uint8_t **buffer)
+{
+    wakeUp();
+    VirtualComponent::saveToBuffer(buffer);
+}
+
 void
 CIA::reset()
 {
@@ -67,6 +90,10 @@ CIA::reset()
     
     clearInterruptLine();
 
+    sleeping = false;
+    idleCycles = 0;
+    wakeUpCycle = 0;
+
     
     // PB67TimerMode = 0x80;
     /*
@@ -93,6 +120,8 @@ CIA::triggerRisingEdgeOnFlagPin()
 void
 CIA::triggerFallingEdgeOnFlagPin()
 {
+    wakeUp();
+    
     ICR |= 0x10; // Note: FLAG pin is inverted
         
     // Trigger interrupt, if enabled
@@ -448,6 +477,8 @@ void CIA::poke(uint16_t addr, uint8_t value)
 void 
 CIA::incrementTOD()
 {
+    wakeUp();
+    
 	if (tod.increment()) {
 		// Set interrupt source
 		ICR |= 0x04; 
@@ -501,6 +532,8 @@ void CIA::dumpTrace()
 
 void CIA::dumpState()
 {
+    wakeUp();
+    
 	msg("              Counter A : %02X\n", getCounterA());
 	msg("                Latch A : %02X\n", getLatchA());
 	msg("            Data port A : %02X\n", getDataPortA());
@@ -523,6 +556,9 @@ void CIA::dumpState()
 
 void CIA::executeOneCycle()
 {	
+    // Account for the cycles skipped while sleeping
+    wakeUp();
+    
 	//
 	// Layout of timer (A and B)
 	//
@@ -752,6 +788,50 @@ void CIA::executeOneCycle()
 
 	// move delay flags left and feed in new bits
 	delay = ((delay << 1) & DelayMask) | feed;
+    
+    // Go idle if the next cycle won't change the delay pipeline
+    if (delay == (((delay << 1) & DelayMask) | feed))
+        sleep();
+}
+
+void
+CIA::sleep()
+{
+    if (!idleSleep)
+        return;
+    
+    // Determine the number of cycles until the next timer underflow
+    uint64_t cycles = UINT64_MAX;
+    
+    if (delay & CountA3)
+        cycles = counterA;
+    if ((delay & CountB3) && counterB < cycles)
+        cycles = counterB;
+    
+    // The underflow cycle has to be executed. Don't bother with short periods.
+    if (cycles < 3)
+        return;
+    
+    sleeping = true;
+    idleCycles = 0;
+    wakeUpCycle = (cycles == UINT64_MAX) ? UINT64_MAX : c64->getCycles() + cycles;
+}
+
+void
+CIA::wakeUp()
+{
+    if (!sleeping)
+        return;
+    
+    // In a stable state, running timers have been decremented in each skipped cycle
+    if (delay & CountA3)
+        counterA -= idleCycles;
+    if (delay & CountB3)
+        counterB -= idleCycles;
+    
+    sleeping = false;
+    idleCycles = 0;
+    wakeUpCycle = 0;
 }
 
 
@@ -843,6 +923,8 @@ uint8_t
 CIA1::peek(uint16_t addr)
 {
 	uint8_t result;
+	
+    wakeUp();
     uint8_t rows, columnBits, columns, rowBits;
     
 	assert(addr <= CIA1_END_ADDR - CIA1_START_ADDR);
@@ -900,6 +982,8 @@ CIA1::poke(uint16_t addr, uint8_t value)
 {
     uint8_t PBold;
     
+    wakeUp();
+    
 	assert(addr <= CIA1_END_ADDR - CIA1_START_ADDR);
 	
 	// The following registers need special handling	
@@ -1015,6 +1099,8 @@ CIA2::peek(uint16_t addr)
 {
 	uint8_t result;
 	
+    wakeUp();
+	
 	assert(addr <= CIA_END_ADDR - CIA_START_ADDR);
 	
 	switch(addr) {
@@ -1046,6 +1132,8 @@ CIA2::peek(uint16_t addr)
 void 
 CIA2::poke(uint16_t addr, uint8_t value)
 {
+    wakeUp();
+    
 	assert(addr <= CIA2_END_ADDR - CIA2_START_ADDR);
 	
 	switch(addr) {
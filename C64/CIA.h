@@ -158,6 +158,27 @@ public:
     //! @brief    Indicates if ICR register is currently read
 	bool readICR;
 
+    //
+    // Sleep logic
+    //
+
+    /*! @brief    Indicates if the CIA is currently idle
+     *  @details  The CIA is put to sleep when the delay pipeline has reached a stable state. In this
+     *            state, the only thing that changes from cycle to cycle are the counters of running
+     *            timers. Hence, execution can be suspended until the next underflow is due and the
+     *            skipped cycles can be accounted for in a single step when the CIA wakes up.
+     */
+    bool sleeping;
+
+    //! @brief    Number of cycles skipped since the CIA went to sleep
+    uint64_t idleCycles;
+
+    //! @brief    First cycle in which the CIA needs to be executed again
+    uint64_t wakeUpCycle;
+
+    //! @brief    Indicates if the CIA may go to sleep (for benchmarking)
+    bool idleSleep;
+
 	/*! @brief    Activates the interrupt line
 	 *  @details  The function is abstract and will be implemented differently by the CIA 1 and CIA 2 class.
      *            Whereas the CIA 1 activates the IRQ line, the CIA 2 activates clears the NMI line.
@@ -188,6 +209,12 @@ public:
 	
 	//! @brief    Bring the CIA back to its initial state
 	void reset();
+
+    //! @brief    Restores the internal state and wakes the CIA up
+    void loadFromBuffer(uint8_t **buffer);
+
+    //! @brief    Wakes the CIA up and saves the internal state
+    void saveToBuffer(uint8_t **buffer);
     	
 	//! @brief    Dump internal state
 	void dumpState();	
@@ -481,6 +508,31 @@ public:
 	//! @brief    Executes the CIA for one cycle
 	void executeOneCycle();
 
+    /*! @brief    Executes the CIA for one cycle if it is due
+     *  @details  While sleeping, the CIA only counts the skipped cycles.
+     */
+    inline void execute(uint64_t cycle) {
+        if (cycle >= wakeUpCycle) executeOneCycle(); else idleCycles++; }
+
+    /*! @brief    Puts the CIA to sleep if possible
+     *  @details  The function is called at the end of each executed cycle. It checks if the delay pipeline
+     *            is stable and computes the number of cycles that can be skipped without missing a timer
+     *            underflow.
+     */
+    void sleep();
+
+    //! @brief    Returns true iff the CIA may go to sleep
+    bool getIdleSleep() { return idleSleep; }
+
+    //! @brief    Enables or disables sleeping (the CIA is woken up if necessary)
+    void setIdleSleep(bool b) { if (!b) wakeUp(); idleSleep = b; }
+
+    /*! @brief    Wakes the CIA up
+     *  @details  The function needs to be called before the internal state is accessed from the outside.
+     *            It is safe to call the function if the CIA is not sleeping.
+     */
+    void wakeUp();
+
 	//! Increments the TOD clock by one tenth of a second
 	void incrementTOD();
 };
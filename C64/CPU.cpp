@@ -25,9 +25,19 @@ CPU::CPU()
 	
     // Chip model
     chipModel = MOS_6510;
+    
+    // Memory is connected later
+    mem = NULL;
+    c64Mem = NULL;
+    driveMem = NULL;
 
 	// Establish callback for each instruction
 	registerInstructions();
+#ifdef VC64_THREADED_CPU
+    for (unsigned i = 0; i < 256; i++)
+        actionIndex[i] = callbackIndex(actionFunc[i]);
+    SET_NEXT(fetch);
+#endif
 		
 	// Clear all breakpoint tags
 	for (int i = 0; i <  65536; i++) {
@@ -38,47 +48,47 @@ CPU::CPU()
     SnapshotItem items[] = {
         
         // Lifetime items
-        { &chipModel,               sizeof(chipModel), KEEP_ON_RESET },
+        { "chipModel",            &chipModel,               sizeof(chipModel), KEEP_ON_RESET },
 
          // Internal state
-        { &A,                       sizeof(A),                      CLEAR_ON_RESET },
-        { &X,                       sizeof(X),                      CLEAR_ON_RESET },
-        { &Y,                       sizeof(Y),                      CLEAR_ON_RESET },
-        { &PC,                      sizeof(PC),                     CLEAR_ON_RESET },
-        { &PC_at_cycle_0,           sizeof(PC_at_cycle_0),          CLEAR_ON_RESET },
-        { &SP,                      sizeof(SP),                     CLEAR_ON_RESET },
-        { &N,                       sizeof(N),                      CLEAR_ON_RESET },
-        { &V,                       sizeof(V),                      CLEAR_ON_RESET },
-        { &B,                       sizeof(B),                      CLEAR_ON_RESET },
-        { &D,                       sizeof(D),                      CLEAR_ON_RESET },
-        { &I,                       sizeof(I),                      CLEAR_ON_RESET },
-        { &Z,                       sizeof(Z),                      CLEAR_ON_RESET },
-        { &C,                       sizeof(C),                      CLEAR_ON_RESET },
-        { &opcode,                  sizeof(opcode),                 CLEAR_ON_RESET },
-        { &addr_lo,                 sizeof(addr_lo),                CLEAR_ON_RESET },
-        { &addr_hi,                 sizeof(addr_hi),                CLEAR_ON_RESET },
-        { &ptr,                     sizeof(ptr),                    CLEAR_ON_RESET },
-        { &pc_lo,                   sizeof(pc_lo),                  CLEAR_ON_RESET },
-        { &pc_hi,                   sizeof(pc_hi),                  CLEAR_ON_RESET },
-        { &overflow,                sizeof(overflow),               CLEAR_ON_RESET },
-        { &data,                    sizeof(data),                   CLEAR_ON_RESET },
-        { &port,                    sizeof(port),                   CLEAR_ON_RESET },
-        { &port_direction,          sizeof(port_direction),         CLEAR_ON_RESET },
+        { "A",                    &A,                       sizeof(A),                      CLEAR_ON_RESET },
+        { "X",                    &X,                       sizeof(X),                      CLEAR_ON_RESET },
+        { "Y",                    &Y,                       sizeof(Y),                      CLEAR_ON_RESET },
+        { "PC",                   &PC,                      sizeof(PC),                     CLEAR_ON_RESET },
+        { "PC_at_cycle_0",        &PC_at_cycle_0,           sizeof(PC_at_cycle_0),          CLEAR_ON_RESET },
+        { "SP",                   &SP,                      sizeof(SP),                     CLEAR_ON_RESET },
+        { "N",                    &N,                       sizeof(N),                      CLEAR_ON_RESET },
+        { "V",                    &V,                       sizeof(V),                      CLEAR_ON_RESET },
+        { "B",                    &B,                       sizeof(B),                      CLEAR_ON_RESET },
+        { "D",                    &D,                       sizeof(D),                      CLEAR_ON_RESET },
+        { "I",                    &I,                       sizeof(I),                      CLEAR_ON_RESET },
+        { "Z",                    &Z,                       sizeof(Z),                      CLEAR_ON_RESET },
+        { "C",                    &C,                       sizeof(C),                      CLEAR_ON_RESET },
+        { "opcode",               &opcode,                  sizeof(opcode),                 CLEAR_ON_RESET },
+        { "addr_lo",              &addr_lo,                 sizeof(addr_lo),                CLEAR_ON_RESET },
+        { "addr_hi",              &addr_hi,                 sizeof(addr_hi),                CLEAR_ON_RESET },
+        { "ptr",                  &ptr,                     sizeof(ptr),                    CLEAR_ON_RESET },
+        { "pc_lo",                &pc_lo,                   sizeof(pc_lo),                  CLEAR_ON_RESET },
+        { "pc_hi",                &pc_hi,                   sizeof(pc_hi),                  CLEAR_ON_RESET },
+        { "overflow",             &overflow,                sizeof(overflow),               CLEAR_ON_RESET },
+        { "data",                 &data,                    sizeof(data),                   CLEAR_ON_RESET },
+        { "port",                 &port,                    sizeof(port),                   CLEAR_ON_RESET },
+        { "port_direction",       &port_direction,          sizeof(port_direction),         CLEAR_ON_RESET },
 //        { &port,                    sizeof(port),                   KEEP_ON_RESET },  // Reset in C64Memory::reset
 //        { &port_direction,          sizeof(port_direction),         KEEP_ON_RESET },  // Reset in C64Memory::reset
-        { &external_port_bits,      sizeof(external_port_bits),     CLEAR_ON_RESET },
-        { &rdyLine,                 sizeof(rdyLine),                CLEAR_ON_RESET },
-        { &irqLine,                 sizeof(irqLine),                CLEAR_ON_RESET },
-        { &nmiLine,                 sizeof(nmiLine),                CLEAR_ON_RESET },
-        { &nmiEdge,                 sizeof(nmiEdge),                CLEAR_ON_RESET },
-        { &interruptsPending,       sizeof(interruptsPending),      CLEAR_ON_RESET },
-        { &nextPossibleIrqCycle,    sizeof(nextPossibleIrqCycle),   CLEAR_ON_RESET },
-        { &nextPossibleNmiCycle,    sizeof(nextPossibleNmiCycle),   CLEAR_ON_RESET },
-        { &errorState,              sizeof(errorState),             CLEAR_ON_RESET },
-        { &callStack,               sizeof(callStack),              CLEAR_ON_RESET | WORD_FORMAT },
-        { &callStackPointer,        sizeof(callStackPointer),       CLEAR_ON_RESET },
-        { &oldI,                    sizeof(oldI),                   CLEAR_ON_RESET },
-        { NULL,                     0,                              0 }};
+        { "external_port_bits",   &external_port_bits,      sizeof(external_port_bits),     CLEAR_ON_RESET },
+        { "rdyLine",              &rdyLine,                 sizeof(rdyLine),                CLEAR_ON_RESET },
+        { "irqLine",              &irqLine,                 sizeof(irqLine),                CLEAR_ON_RESET },
+        { "nmiLine",              &nmiLine,                 sizeof(nmiLine),                CLEAR_ON_RESET },
+        { "nmiEdge",              &nmiEdge,                 sizeof(nmiEdge),                CLEAR_ON_RESET },
+        { "interruptsPending",    &interruptsPending,       sizeof(interruptsPending),      CLEAR_ON_RESET },
+        { "nextPossibleIrqCycle", &nextPossibleIrqCycle,    sizeof(nextPossibleIrqCycle),   CLEAR_ON_RESET },
+        { "nextPossibleNmiCycle", &nextPossibleNmiCycle,    sizeof(nextPossibleNmiCycle),   CLEAR_ON_RESET },
+        { "errorState",           &errorState,              sizeof(errorState),             CLEAR_ON_RESET },
+        { "callStack",            &callStack,               sizeof(callStack),              CLEAR_ON_RESET | WORD_FORMAT },
+        { "callStackPointer",     &callStackPointer,        sizeof(callStackPointer),       CLEAR_ON_RESET },
+        { "oldI",                 &oldI,                    sizeof(oldI),                   CLEAR_ON_RESET },
+        { NULL,                   NULL,                     0,                              0 }};
     
     registerSnapshotItems(items, sizeof(items));
 }
@@ -96,7 +106,7 @@ CPU::reset()
     B = 1; 
 	external_port_bits = 0x1F;
 	rdyLine = true;
-	next = &CPU::fetch;
+	SET_NEXT(fetch);
 }
 
 size_t
@@ -109,22 +119,18 @@ void
 CPU::loadFromBuffer(uint8_t **buffer) 
 {
     VirtualComponent::loadFromBuffer(buffer);
-	next = CPU::callbacks[read16(buffer)];
+    uint16_t index = read16(buffer);
+	next = CPU::callbacks[index];
+#ifdef VC64_THREADED_CPU
+    nextIndex = index;
+#endif
 }
 
 void
 CPU::saveToBuffer(uint8_t **buffer) 
 {
     VirtualComponent::saveToBuffer(buffer);
-	for (uint16_t i = 0;; i++) {
-		if (callbacks[i] == NULL) {
-			panic("ERROR while saving state: Callback pointer not found!\n");
-		}
-		if (callbacks[i] == next) {
-			write16(buffer, i);
-			break;
-		}
-	}
+    write16(buffer, callbackIndex(next));
 }
 
 void 
@@ -21,7 +21,8 @@
 #ifndef _CPU_INC
 #define _CPU_INC
 
-#include "Memory.h"
+#include "C64Memory.h"
+#include "VC1541Memory.h"
 
 /*! @class  The virtual 6510 processor
  */
@@ -55,6 +56,18 @@ public:
 	//! @brief    Reference to the connected virtual memory
 	Memory *mem;
 
+private:
+
+    /*! @brief    Statically typed references to the connected memory
+     *  @details  Exactly one of both references is set. Instruction handlers access memory via
+     *            peekMem() and pokeMem() which call the memory implementation directly instead of
+     *            going through the virtual functions of class Memory.
+     */
+    C64Memory *c64Mem;
+    VC1541Memory *driveMem;
+
+public:
+
     /*! @brief    Selected chip model
      *  @abstract Right now, this atrribute is only used to distinguish the C64 CPU (MOS6510) from the
      *            VC1541 CPU (MOS6502). Hardware differences between the two processors are not emulated.
@@ -211,6 +224,16 @@ private:
 	 
 	//! @brief    Callback function array pointing to the execution function of each instruction
 	void (CPU::*actionFunc[256])(void);
+
+#ifdef VC64_THREADED_CPU
+    
+    //! @brief    Index of the next micro-instruction (mirrors next)
+    uint16_t nextIndex;
+    
+    //! @brief    Index of the first micro-instruction of each instruction (mirrors actionFunc)
+    uint16_t actionIndex[256];
+    
+#endif
 	
 	//! @brief    Breakpoint tag for each memory cell
 	uint8_t breakpoint[65536];
@@ -256,6 +279,25 @@ public:
     bool isC64CPU() { return strcmp(getDescription(), "CPU") == 0; /* VC1541 CPU is calles "1541CPU" */ }
 
     
+    //
+    //! @functiongroup Accessing memory
+    //
+
+    //! @brief    Connects the CPU with the memory of the C64.
+    void connectMemory(C64Memory *m) { mem = c64Mem = m; driveMem = NULL; }
+
+    //! @brief    Connects the CPU with the memory of the VC1541.
+    void connectMemory(VC1541Memory *m) { mem = driveMem = m; c64Mem = NULL; }
+
+    //! @brief    Reads a value from the connected memory without a virtual function call.
+    inline uint8_t peekMem(uint16_t addr) {
+        return c64Mem ? c64Mem->C64Memory::peek(addr) : driveMem->VC1541Memory::peek(addr); }
+
+    //! @brief    Writes a value into the connected memory without a virtual function call.
+    inline void pokeMem(uint16_t addr, uint8_t value) {
+        if (c64Mem) c64Mem->C64Memory::poke(addr, value); else driveMem->VC1541Memory::poke(addr, value); }
+
+    
     //
     //! @functiongroup Managing the processor port
     //
@@ -357,7 +399,7 @@ public:
     void setPC(uint16_t pc) { PC = pc; }
     
 	//! @brief    Writes value to the freezend program counter.
-    void setPC_at_cycle_0(uint16_t pc) { PC_at_cycle_0 = PC = pc; next = &CPU::fetch;}
+    void setPC_at_cycle_0(uint16_t pc) { PC_at_cycle_0 = PC = pc; SET_NEXT(fetch); }
     
 	//! @brief    Changes low byte of the program counter only.
     void setPCL(uint8_t lo) { PC = (PC & 0xff00) | lo; }
@@ -419,7 +461,7 @@ public:
     void loadSP(uint8_t s) { SP = s; N = s & 128; Z = (s == 0); }
     
 	//! @brief    Loads a value into memory. The Z- and N-flag may change.
-    void loadM(uint16_t addr, uint8_t s) { mem->poke(addr, s); N = s & 128; Z = (s == 0); }
+    void loadM(uint16_t addr, uint8_t s) { pokeMem(addr, s); N = s & 128; Z = (s == 0); }
 
     
     //
@@ -558,7 +600,11 @@ public:
 	/*! @brief    Executes the device for one cycle.
 	 *  @details  This is the normal operation mode. Interrupt requests are handled. 
      */
+#ifdef VC64_THREADED_CPU
+    bool executeOneCycle() { executeThreaded(); return errorState == CPU_OK; }
+#else
     bool executeOneCycle() { (*this.*next)(); return errorState == CPU_OK; }
+#endif
 
 	//! @brief    Returns the current error state.
     ErrorState getErrorState() { return errorState; }
@@ -62,6 +62,7 @@ CRTContainer::dealloc()
             free(data);
             data = NULL;
         }
+        size = 0;
         
         for (unsigned i = 0; i < 64; i++)
             chips[i] = NULL;
@@ -105,6 +106,7 @@ CRTContainer::readFromBuffer(const uint8_t *buffer, size_t length)
         return false;
     }
     memcpy(data, buffer, length);
+    size = length;
     
     // Scan cartridge header
     if (memcmp("C64 CARTRIDGE   ", data, 16) != 0) {
@@ -146,6 +148,15 @@ CRTContainer::readFromBuffer(const uint8_t *buffer, size_t length)
     return true;	
 }
 
+size_t
+CRTContainer::writeToBuffer(uint8_t *buffer)
+{
+    if (buffer && data)
+        memcpy(buffer, data, size);
+    
+    return data ? size : 0;
+}
+
 const char *
 CRTContainer::cartridgeTypeName()
 {
@@ -46,6 +46,9 @@ private:
     //! @brief    Raw data of CRT container file
     uint8_t *data;
     
+    //! @brief    Size of the CRT container file in bytes
+    size_t size;
+    
     //! @brief    Number of chips contained in cartridge file
     unsigned int numberOfChips;
     
@@ -141,6 +144,9 @@ public:
     //! Read container data from memory buffer
     bool readFromBuffer(const uint8_t *buffer, size_t length);
 
+    //! Write container data into memory buffer
+    size_t writeToBuffer(uint8_t *buffer);
+
 };
 
 #endif
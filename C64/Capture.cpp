@@ -0,0 +1,412 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "Capture.h"
+
+const uint8_t Capture::magicBytes[] = { 'V', 'C', 'A', 'P', 0x00 };
+
+static void
+put16(uint8_t **ptr, uint16_t value)
+{
+    *(*ptr)++ = (uint8_t)(value >> 8);
+    *(*ptr)++ = (uint8_t)value;
+}
+
+static void
+put32(uint8_t **ptr, uint32_t value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+        *(*ptr)++ = (uint8_t)(value >> shift);
+}
+
+Capture::Capture()
+{
+    setDescription("Capture");
+
+    memset(jobs, 0, sizeof(jobs));
+    first = 0;
+    count = 0;
+    file = NULL;
+    numSamples = 0;
+    previous = NULL;
+    encoded = NULL;
+    sinceKeyframe = 0;
+    failed = false;
+    droppedFrames = 0;
+    droppedSamples = 0;
+    pendingSilence = 0;
+    capturing = false;
+    terminate = false;
+
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&submitted, NULL);
+}
+
+Capture::~Capture()
+{
+    stop();
+
+    pthread_cond_destroy(&submitted);
+    pthread_mutex_destroy(&lock);
+}
+
+bool
+Capture::start(const char *path, unsigned fps, unsigned sampleRate, const uint32_t *palette)
+{
+    assert(path != NULL);
+    assert(palette != NULL);
+
+    stop();
+
+    if ((file = fopen(path, "w")) == NULL) {
+        warn("Cannot create capture file %s\n", path);
+        return false;
+    }
+
+    // Write header
+    uint8_t header[HEADER_SIZE], *ptr = header;
+    memcpy(ptr, magicBytes, 4);
+    ptr[4] = V_MAJOR;
+    ptr[5] = V_MINOR;
+    ptr[6] = V_SUBMINOR;
+    ptr[7] = 0;
+    ptr += 8;
+    put16(&ptr, NTSC_PIXELS);
+    put16(&ptr, PAL_RASTERLINES);
+    put16(&ptr, (uint16_t)fps);
+    put32(&ptr, sampleRate);
+    for (unsigned i = 0; i < 16; i++) {
+        *ptr++ = (uint8_t)palette[i];
+        *ptr++ = (uint8_t)(palette[i] >> 8);
+        *ptr++ = (uint8_t)(palette[i] >> 16);
+    }
+    assert(ptr == header + HEADER_SIZE);
+
+    if (fwrite(header, 1, HEADER_SIZE, file) != HEADER_SIZE) {
+        warn("Cannot write capture file %s\n", path);
+        fclose(file);
+        file = NULL;
+        return false;
+    }
+
+    // Allocate all buffers up front to keep the emulation thread free of allocations
+    bool success = true;
+    for (unsigned i = 0; i < POOL_SIZE; i++)
+        success &= (jobs[i].data = (uint8_t *)malloc(FRAME_SIZE)) != NULL;
+    success &= (previous = (uint8_t *)malloc(FRAME_SIZE)) != NULL;
+    success &= (encoded = (uint8_t *)malloc(maxEncodedSize(FRAME_SIZE))) != NULL;
+
+    first = 0;
+    count = 0;
+    numSamples = 0;
+    sinceKeyframe = 0;
+    failed = false;
+    droppedFrames = 0;
+    droppedSamples = 0;
+    pendingSilence = 0;
+    terminate = false;
+
+    if (!success || pthread_create(&thread, NULL, threadMain, (void *)this) != 0) {
+        warn("Failed to start the capture thread\n");
+        capturing = true;
+        terminate = true;
+        stop();
+        return false;
+    }
+
+    capturing = true;
+    return true;
+}
+
+void
+Capture::stop()
+{
+    if (!capturing)
+        return;
+
+    if (!terminate) {
+
+        flushSamples();
+
+        // The worker thread finishes all pending jobs before it terminates
+        pthread_mutex_lock(&lock);
+        terminate = true;
+        pthread_cond_signal(&submitted);
+        pthread_mutex_unlock(&lock);
+        pthread_join(thread, NULL);
+
+        // Samples dropped after the last audio chunk
+        if (!failed && pendingSilence)
+            failed = !writeSilence(pendingSilence);
+        pendingSilence = 0;
+    }
+    capturing = false;
+
+    if (fclose(file) != 0 || failed)
+        warn("Failed to write the capture file\n");
+    file = NULL;
+
+    for (unsigned i = 0; i < POOL_SIZE; i++) {
+        free(jobs[i].data);
+        jobs[i].data = NULL;
+    }
+    free(previous);
+    free(encoded);
+    previous = NULL;
+    encoded = NULL;
+}
+
+void
+Capture::recordFrame(const uint8_t *indices, uint64_t frame)
+{
+    assert(indices != NULL);
+
+    if (!submit(CHUNK_FRAME, frame, indices, FRAME_SIZE))
+        droppedFrames++;
+}
+
+void
+Capture::recordSamples(const short *data, size_t count)
+{
+    assert(data != NULL);
+
+    while (count) {
+
+        size_t chunk = MIN(count, AUDIO_CHUNK_SIZE - numSamples);
+        memcpy(samples + numSamples, data, chunk * sizeof(short));
+        numSamples += chunk;
+        data += chunk;
+        count -= chunk;
+
+        if (numSamples == AUDIO_CHUNK_SIZE)
+            flushSamples();
+    }
+}
+
+void
+Capture::flushSamples()
+{
+    if (numSamples && !submit(CHUNK_AUDIO, 0, samples, numSamples * sizeof(short))) {
+        droppedSamples += numSamples;
+        pendingSilence += numSamples;
+    }
+    numSamples = 0;
+}
+
+bool
+Capture::submit(uint8_t type, uint64_t frame, const void *data, size_t size)
+{
+    assert(size <= FRAME_SIZE);
+
+    pthread_mutex_lock(&lock);
+    if (count == POOL_SIZE) {
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+
+    // The slot is owned by this thread until count is increased
+    Job *job = &jobs[(first + count) % POOL_SIZE];
+    pthread_mutex_unlock(&lock);
+
+    job->type = type;
+    job->frame = frame;
+    job->size = size;
+    job->silence = 0;
+    memcpy(job->data, data, size);
+
+    if (type == CHUNK_AUDIO) {
+        job->silence = pendingSilence;
+        pendingSilence = 0;
+    }
+
+    pthread_mutex_lock(&lock);
+    count++;
+    pthread_cond_signal(&submitted);
+    pthread_mutex_unlock(&lock);
+    return true;
+}
+
+bool
+Capture::writeChunk(uint8_t type, const uint8_t *header, size_t headerSize,
+                    const uint8_t *payload, size_t payloadSize)
+{
+    uint8_t chunk[5], *ptr = chunk;
+    *ptr++ = type;
+    put32(&ptr, (uint32_t)(headerSize + payloadSize));
+
+    bool success = fwrite(chunk, 1, sizeof(chunk), file) == sizeof(chunk);
+    if (headerSize)
+        success &= fwrite(header, 1, headerSize, file) == headerSize;
+    success &= fwrite(payload, 1, payloadSize, file) == payloadSize;
+    return success;
+}
+
+bool
+Capture::writeSilence(uint64_t samples)
+{
+    // The encoder output buffer is large enough for a full audio chunk
+    memset(encoded, 0, AUDIO_CHUNK_SIZE * sizeof(short));
+
+    while (samples) {
+        size_t chunk = samples < AUDIO_CHUNK_SIZE ? (size_t)samples : AUDIO_CHUNK_SIZE;
+        if (!writeChunk(CHUNK_AUDIO, NULL, 0, encoded, chunk * sizeof(short)))
+            return false;
+        samples -= chunk;
+    }
+    return true;
+}
+
+void
+Capture::process(Job *job)
+{
+    if (failed)
+        return;
+
+    if (job->type == CHUNK_AUDIO) {
+
+        // Fill the gap left by dropped samples to keep audio and video in sync
+        if (job->silence && !writeSilence(job->silence)) {
+            failed = true;
+            return;
+        }
+
+        // Convert samples to big endian in place
+        for (size_t i = 0; i < job->size; i += 2) {
+            short sample;
+            memcpy(&sample, job->data + i, 2);
+            job->data[i] = (uint8_t)((uint16_t)sample >> 8);
+            job->data[i + 1] = (uint8_t)sample;
+        }
+        failed = !writeChunk(CHUNK_AUDIO, NULL, 0, job->data, job->size);
+        return;
+    }
+
+    // Encode the difference to the previously written frame
+    bool keyframe = (sinceKeyframe == 0);
+    if (keyframe)
+        memset(previous, 0, FRAME_SIZE);
+    sinceKeyframe = (sinceKeyframe + 1) % KEYFRAME_INTERVAL;
+
+    for (size_t i = 0; i < FRAME_SIZE; i++) {
+        uint8_t pixel = job->data[i];
+        job->data[i] ^= previous[i];
+        previous[i] = pixel;
+    }
+    size_t size = encodeRLE(job->data, FRAME_SIZE, encoded);
+
+    uint8_t header[9], *ptr = header;
+    put32(&ptr, (uint32_t)(job->frame >> 32));
+    put32(&ptr, (uint32_t)job->frame);
+    *ptr++ = keyframe;
+    failed = !writeChunk(CHUNK_FRAME, header, sizeof(header), encoded, size);
+}
+
+void
+Capture::run()
+{
+    pthread_mutex_lock(&lock);
+
+    while (true) {
+
+        while (count == 0 && !terminate)
+            pthread_cond_wait(&submitted, &lock);
+
+        if (count == 0)
+            break;
+
+        // The oldest job is owned by this thread until count is decreased
+        Job *job = &jobs[first];
+        pthread_mutex_unlock(&lock);
+        process(job);
+        pthread_mutex_lock(&lock);
+
+        first = (first + 1) % POOL_SIZE;
+        count--;
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+void *
+Capture::threadMain(void *capture)
+{
+    ((Capture *)capture)->run();
+    return NULL;
+}
+
+size_t
+Capture::encodeRLE(const uint8_t *src, size_t length, uint8_t *dst)
+{
+    size_t i = 0, out = 0;
+
+    while (i < length) {
+
+        // Emit a run if the next byte repeats at least three times
+        size_t run = 1;
+        while (i + run < length && run < 130 && src[i + run] == src[i])
+            run++;
+
+        if (run >= 3) {
+            dst[out++] = (uint8_t)(run + 125);
+            dst[out++] = src[i];
+            i += run;
+            continue;
+        }
+
+        // Collect literals until the next run starts
+        size_t start = i;
+        while (i < length && i - start < 128) {
+            if (i + 2 < length && src[i] == src[i + 1] && src[i] == src[i + 2])
+                break;
+            i++;
+        }
+        dst[out++] = (uint8_t)(i - start - 1);
+        memcpy(dst + out, src + start, i - start);
+        out += i - start;
+    }
+
+    return out;
+}
+
+bool
+Capture::decodeRLE(const uint8_t *src, size_t length, uint8_t *dst, size_t expected)
+{
+    size_t i = 0, out = 0;
+
+    while (i < length) {
+
+        uint8_t header = src[i++];
+
+        if (header < 128) {
+            size_t literals = header + 1;
+            if (literals > length - i || literals > expected - out)
+                return false;
+            memcpy(dst + out, src + i, literals);
+            i += literals;
+            out += literals;
+        } else {
+            size_t run = header - 125;
+            if (i == length || run > expected - out)
+                return false;
+            memset(dst + out, src[i++], run);
+            out += run;
+        }
+    }
+
+    return out == expected;
+}
@@ -0,0 +1,220 @@
+/*!
+ * @header      Capture.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _CAPTURE_INC
+#define _CAPTURE_INC
+
+#include "VC64Object.h"
+#include "VIC_globals.h"
+#include "C64_defs.h"
+
+/*! @class    Capture
+ *  @brief    Lossless recording of the video and audio output
+ *  @details  The pixel engine hands over each synthesized frame as palette indices and ReSID
+ *            hands over all computed samples. The emulation thread only copies the data into
+ *            one of POOL_SIZE pooled buffers. Encoding and writing the data is done by a
+ *            separate thread. If all buffers are in use, the data is dropped and counted
+ *            instead of waiting for the disk. Dropped samples are written as silence in
+ *            front of the next audio chunk, dropped frames are filled in by vc64capture.
+ *            Each frame is XORed with the previously written frame and run length encoded,
+ *            which reduces a static screen to a few kilobytes. Every KEYFRAME_INTERVAL frames,
+ *            the frame is encoded on its own. Audio is stored as raw 16 bit mono PCM.
+ *            vc64capture converts capture files into Y4M and WAV files.
+ *
+ *            File format (all numbers big endian):
+ *
+ *                'V','C','A','P', major, minor, subminor, 0
+ *                u16 width, u16 height, u16 frames per second, u32 sample rate
+ *                16 palette entries: u8 red, u8 green, u8 blue
+ *                chunks: u8 type, u32 payload size, payload
+ *
+ *                CHUNK_FRAME: u64 frame number, u8 keyframe flag, encodeRLE(indices XOR previous)
+ *                CHUNK_AUDIO: s16 samples
+ */
+class Capture : public VC64Object {
+
+public:
+
+    //! @brief    Number of pooled buffers
+    static const unsigned POOL_SIZE = 8;
+
+    //! @brief    Number of frames per keyframe
+    static const unsigned KEYFRAME_INTERVAL = 250;
+
+    //! @brief    Number of audio samples collected before they are handed over
+    static const size_t AUDIO_CHUNK_SIZE = 4096;
+
+    //! @brief    Size of a frame in bytes (one palette index per pixel)
+    static const size_t FRAME_SIZE = PAL_RASTERLINES * NTSC_PIXELS;
+
+    //! @brief    Chunk types
+    static const uint8_t CHUNK_FRAME = 'F';
+    static const uint8_t CHUNK_AUDIO = 'A';
+
+    //! @brief    Header signature
+    static const uint8_t magicBytes[];
+
+    //! @brief    Size of the file header in bytes
+    static const size_t HEADER_SIZE = 8 + 10 + 16 * 3;
+
+private:
+
+    //! @brief    A pending job
+    typedef struct {
+
+        //! @brief    Chunk type
+        uint8_t type;
+
+        //! @brief    Frame number (frame chunks only)
+        uint64_t frame;
+
+        //! @brief    Palette indices or audio samples
+        uint8_t *data;
+        size_t size;
+
+        //! @brief    Number of dropped samples preceding the samples (audio chunks only)
+        uint64_t silence;
+
+    } Job;
+
+    //! @brief    Ring buffer of jobs
+    Job jobs[POOL_SIZE];
+
+    //! @brief    Ring buffer position of the oldest pending job
+    unsigned first;
+
+    //! @brief    Number of submitted jobs that have not been finished yet
+    unsigned count;
+
+    //! @brief    The capture file
+    FILE *file;
+
+    //! @brief    Audio samples that have not been handed over yet (emulation thread only)
+    short samples[AUDIO_CHUNK_SIZE];
+    size_t numSamples;
+
+    //! @brief    Most recently written frame (worker thread only)
+    uint8_t *previous;
+
+    //! @brief    Encoder output (worker thread only)
+    uint8_t *encoded;
+
+    //! @brief    Number of frames written since the last keyframe (worker thread only)
+    unsigned sinceKeyframe;
+
+    //! @brief    Indicates if a write error has occurred (worker thread only)
+    bool failed;
+
+    //! @brief    Number of frames and samples that have been dropped
+    uint64_t droppedFrames;
+    uint64_t droppedSamples;
+
+    //! @brief    Number of dropped samples not yet handed over as silence (emulation thread only)
+    uint64_t pendingSilence;
+
+    //! @brief    The worker thread
+    pthread_t thread;
+
+    //! @brief    Indicates if a capture is in progress
+    bool capturing;
+
+    //! @brief    Asks the worker thread to terminate
+    bool terminate;
+
+    //! @brief    Protects first, count, and terminate
+    pthread_mutex_t lock;
+
+    //! @brief    Signaled when a job has been submitted
+    pthread_cond_t submitted;
+
+public:
+
+    //! @brief    Constructor
+    Capture();
+
+    //! @brief    Destructor
+    ~Capture();
+
+    /*! @brief    Creates a capture file and starts the worker thread
+     *  @details  The palette is expected in the format returned by VIC::getColors().
+     */
+    bool start(const char *path, unsigned fps, unsigned sampleRate, const uint32_t *palette);
+
+    //! @brief    Writes all pending data, terminates the worker thread, and closes the file
+    void stop();
+
+    //! @brief    Returns true iff a capture is in progress
+    bool isCapturing() { return capturing; }
+
+    //! @brief    Hands over a synthesized frame (emulation thread only)
+    void recordFrame(const uint8_t *indices, uint64_t frame);
+
+    //! @brief    Hands over audio samples (emulation thread only)
+    void recordSamples(const short *data, size_t count);
+
+    //! @brief    Returns the number of frames that have been dropped because the disk was busy
+    uint64_t getDroppedFrames() { return droppedFrames; }
+
+    //! @brief    Returns the number of samples that have been dropped because the disk was busy
+    uint64_t getDroppedSamples() { return droppedSamples; }
+
+    //
+    //! @functiongroup Run length encoding
+    //
+
+    //! @brief    Returns the maximum size of encodeRLE() output
+    static size_t maxEncodedSize(size_t length) { return length + (length + 127) / 128; }
+
+    /*! @brief    Run length encodes a buffer
+     *  @details  Each block starts with a header byte h. If h < 128, h + 1 literal bytes
+     *            follow. Otherwise, the next byte is repeated h - 125 times.
+     *  @result   Number of bytes written into dst
+     */
+    static size_t encodeRLE(const uint8_t *src, size_t length, uint8_t *dst);
+
+    //! @brief    Decodes the output of encodeRLE(). Returns false if src is malformed.
+    static bool decodeRLE(const uint8_t *src, size_t length, uint8_t *dst, size_t expected);
+
+private:
+
+    //! @brief    Copies data into the next free pool buffer. Returns false if there is none.
+    bool submit(uint8_t type, uint64_t frame, const void *data, size_t size);
+
+    //! @brief    Hands over the collected audio samples
+    void flushSamples();
+
+    //! @brief    Writes a chunk header and its payload
+    bool writeChunk(uint8_t type, const uint8_t *header, size_t headerSize,
+                    const uint8_t *payload, size_t payloadSize);
+
+    //! @brief    Writes audio chunks of silent samples (worker thread only)
+    bool writeSilence(uint64_t samples);
+
+    //! @brief    Encodes and writes a single job (called without holding the lock)
+    void process(Job *job);
+
+    //! @brief    Main loop of the worker thread
+    void run();
+
+    //! @brief    Entry point of the worker thread
+    static void *threadMain(void *capture);
+};
+
+#endif
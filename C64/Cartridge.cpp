@@ -22,6 +22,8 @@ Cartridge::Cartridge(C64 *c64)
         chip[i] = NULL;
         chipStartAddress[i] = 0;
         chipSize[i] = 0;
+        chipHash[i] = 0;
+        chipDirty[i] = 1;
     }
 }
 
@@ -128,7 +130,7 @@ Cartridge::stateSize()
     uint32_t size = 2;
     
     for (unsigned i = 0; i < 64; i++) {
-        size += 4 + chipSize[i];
+        size += 4 + (chipSize[i] ? 8 : 0);
     }
 
     size += sizeof(blendedIn);
@@ -146,13 +148,27 @@ Cartridge::loadFromBuffer(uint8_t **buffer)
     
     for (unsigned i = 0; i < 64; i++) {
         chipStartAddress[i] = read16(buffer);
-        chipSize[i] = read16(buffer);
+        uint16_t size = read16(buffer);
         
-        if (chipSize[i] > 0) {
-            chip[i] = (uint8_t *)malloc(chipSize[i]);
-            readBlock(buffer, chip[i], chipSize[i]);
+        if (size == 0) {
+            allocChip(i, 0);
+            continue;
+        }
+        
+        // Chip images are fetched from the blob store unless they are already in place
+        uint64_t hash = read64(buffer);
+        if (chip[i] && chipSize[i] == size && !chipDirty[i] && chipHash[i] == hash)
+            continue;
+        
+        if (!allocChip(i, size)) {
+            warn("Failed to allocate memory for chip %d\n", i);
+            continue;
+        }
+        if (BlobStore::get(hash, size, chip[i])) {
+            chipHash[i] = hash;
+            chipDirty[i] = 0;
         } else {
-            chip[i] = NULL;
+            warn("Snapshot refers to an unknown chip image (%016llX)\n", (unsigned long long)hash);
         }
     }
     
@@ -175,7 +191,7 @@ Cartridge::saveToBuffer(uint8_t **buffer)
         write16(buffer, chipSize[i]);
         
         if (chipSize[i] > 0) {
-            writeBlock(buffer, chip[i], chipSize[i]);
+            write64(buffer, chipReference(i));
         }
     }
     
@@ -316,14 +332,10 @@ Cartridge::loadChip(unsigned nr, CRTContainer *c)
         return;
     }
     
-    if (chip[nr])
-        free(chip[nr]);
-    
-    if (!(chip[nr] = (uint8_t *)malloc(size)))
+    if (!allocChip(nr, size))
         return;
     
     chipStartAddress[nr] = start;
-    chipSize[nr]         = size;
     memcpy(chip[nr], data, size);
     
     /*
@@ -332,6 +344,46 @@ Cartridge::loadChip(unsigned nr, CRTContainer *c)
     */
 }
 
+bool
+Cartridge::allocChip(unsigned nr, uint16_t size)
+{
+    assert(nr < 64);
+    
+    chipDirty[nr] = 1;
 
+    if (chipSize[nr] == size && (chip[nr] != NULL || size == 0))
+        return true;
+    
+    free(chip[nr]);
+    chip[nr] = size ? (uint8_t *)malloc(size) : NULL;
+    chipSize[nr] = chip[nr] ? size : 0;
+    
+    return chipSize[nr] == size;
+}
 
+uint64_t
+Cartridge::chipReference(unsigned nr)
+{
+    assert(nr < 64);
+    assert(chip[nr] != NULL);
+    
+    if (chipDirty[nr] && BlobStore::add(chip[nr], chipSize[nr], &chipHash[nr]))
+        chipDirty[nr] = 0;
+    
+    return chipHash[nr];
+}
 
+bool
+Cartridge::collectBlobs(BlobList *list)
+{
+    bool result = true;
+    
+    for (unsigned i = 0; i < 64; i++) {
+        if (chipSize[i] > 0) {
+            BlobStore::addReference(list, chipReference(i), chipSize[i]);
+            result &= !chipDirty[i];
+        }
+    }
+    
+    return result;
+}
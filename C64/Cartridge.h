@@ -60,6 +60,15 @@ public:
     //! @brief    Array containing the chip sizes of all chips
     uint16_t chipSize[64];
     
+    /*! @brief    Content hashes of all chips
+     *  @details  Snapshots refer to the chip images in the BlobStore via these hashes.
+     *            The hash of chip i is only valid if chipDirty[i] is 0.
+     */
+    uint64_t chipHash[64];
+    
+    //! @brief    Indicates which chips have been modified since they were hashed
+    uint8_t chipDirty[64];
+    
     /*! @brief    Indicates which ROM chip blended it
      *  @details  Each array item represents a 4 KB block above $8000
      */
@@ -107,8 +116,13 @@ public:
     void loadFromBuffer(uint8_t **buffer);
     
     //! @brief    Save the current state into a buffer
+    /*! @details  The chip images are not saved. They are referenced via the BlobStore.
+     */
     void saveToBuffer(uint8_t **buffer);
     
+    //! @brief    Collects the blob store references of all chips
+    bool collectBlobs(BlobList *list);
+    
     //! @brief    Prints debugging information
     void dumpState();
     
@@ -166,6 +180,18 @@ public:
     //! @brief    Reads in chip stored in the provided CRT container
     void loadChip(unsigned nr, CRTContainer *c);    
 
+    /*! @brief    Provides memory for a chip
+     *  @details  The existing chip memory is reused if the size matches. Otherwise, it is
+     *            replaced by a newly allocated block. The chip contents are undefined afterwards.
+     *  @return   false, if memory could not be allocated
+     */
+    bool allocChip(unsigned nr, uint16_t size);
+    
+    /*! @brief    Returns the blob store reference of a chip
+     *  @details  If the blob store rejects the image, the chip stays dirty.
+     */
+    uint64_t chipReference(unsigned nr);
+
     //! @brief    Press button on cartridge
     /*! @details  By default nothing is done here as most cartridges do not have any
      *            button. Some special cartriges such aus Final Cartridge III
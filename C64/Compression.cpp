@@ -0,0 +1,187 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "Compression.h"
+
+//! @brief    Minimum match length
+#define LZ_MIN_MATCH 4
+
+//! @brief    Maximum match offset
+#define LZ_MAX_OFFSET 0xFFFF
+
+static inline uint32_t
+read32LE(const uint8_t *p)
+{
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+static inline unsigned
+lzHash(uint32_t sequence)
+{
+    return (sequence * 2654435761U) >> (32 - LZ_HASH_BITS);
+}
+
+static inline uint8_t *
+putLength(uint8_t *out, size_t length)
+{
+    for (; length >= 255; length -= 255)
+        *out++ = 255;
+    *out++ = (uint8_t)length;
+    return out;
+}
+
+static uint8_t *
+putSequence(uint8_t *out, const uint8_t *literals, size_t numLiterals, size_t offset, size_t matchLength)
+{
+    uint8_t *token = out++;
+    
+    *token = (uint8_t)((numLiterals < 15 ? numLiterals : 15) << 4);
+    if (numLiterals >= 15)
+        out = putLength(out, numLiterals - 15);
+    memcpy(out, literals, numLiterals);
+    out += numLiterals;
+    
+    if (matchLength) {
+        size_t code = matchLength - LZ_MIN_MATCH;
+        *token |= (uint8_t)(code < 15 ? code : 15);
+        *out++ = (uint8_t)offset;
+        *out++ = (uint8_t)(offset >> 8);
+        if (code >= 15)
+            out = putLength(out, code - 15);
+    }
+    
+    return out;
+}
+
+size_t
+lzMaxCompressedSize(size_t size)
+{
+    return size + size / 255 + 16;
+}
+
+size_t
+lzCompress(const uint8_t *src, size_t size, uint8_t *dst, uint32_t *table)
+{
+    uint32_t *temporary = NULL;
+    uint8_t *out = dst;
+    size_t anchor = 0, pos = 0;
+    
+    if (table == NULL)
+        table = temporary = (uint32_t *)malloc(LZ_TABLE_ENTRIES * sizeof(uint32_t));
+    if (table == NULL)
+        return 0;
+    memset(table, 0, LZ_TABLE_ENTRIES * sizeof(uint32_t));
+    
+    // Positions are stored with an offset of 1 to let 0 mark an empty slot
+    while (size >= LZ_MIN_MATCH && pos <= size - LZ_MIN_MATCH) {
+        
+        uint32_t sequence = read32LE(src + pos);
+        unsigned h = lzHash(sequence);
+        size_t candidate = table[h];
+        table[h] = (uint32_t)(pos + 1);
+        
+        if (candidate == 0 || pos + 1 - candidate > LZ_MAX_OFFSET ||
+            read32LE(src + candidate - 1) != sequence) {
+            
+            // Speed up on incompressible data by taking larger steps
+            pos += 1 + ((pos - anchor) >> 6);
+            continue;
+        }
+        
+        // Extend the match
+        size_t match = candidate - 1;
+        size_t length = LZ_MIN_MATCH;
+        while (pos + length < size && src[match + length] == src[pos + length])
+            length++;
+        
+        out = putSequence(out, src + anchor, pos - anchor, pos - match, length);
+        pos += length;
+        anchor = pos;
+        
+        // Remember a position inside the match to improve the next search
+        if (pos >= 2 && pos - 2 <= size - LZ_MIN_MATCH)
+            table[lzHash(read32LE(src + pos - 2))] = (uint32_t)(pos - 1);
+    }
+    
+    // Remaining literals
+    out = putSequence(out, src + anchor, size - anchor, 0, 0);
+    
+    free(temporary);
+    return out - dst;
+}
+
+bool
+lzDecompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize)
+{
+    const uint8_t *end = src + srcSize;
+    size_t pos = 0;
+    
+    while (src < end) {
+        
+        uint8_t token = *src++;
+        
+        // Copy literals
+        size_t numLiterals = token >> 4;
+        if (numLiterals == 15) {
+            uint8_t b;
+            do {
+                if (src == end) return false;
+                numLiterals += (b = *src++);
+            } while (b == 255);
+        }
+        if ((size_t)(end - src) < numLiterals || dstSize - pos < numLiterals)
+            return false;
+        memcpy(dst + pos, src, numLiterals);
+        src += numLiterals;
+        pos += numLiterals;
+        
+        // The last token has no match
+        if (src == end)
+            break;
+        
+        // Copy match
+        if (end - src < 2) return false;
+        size_t offset = src[0] | (src[1] << 8);
+        src += 2;
+        
+        size_t length = (token & 0x0F) + LZ_MIN_MATCH;
+        if ((token & 0x0F) == 15) {
+            uint8_t b;
+            do {
+                if (src == end) return false;
+                length += (b = *src++);
+            } while (b == 255);
+        }
+        if (offset == 0 || offset > pos || dstSize - pos < length)
+            return false;
+        
+        // Overlapping matches repeat a pattern. The copied part doubles in each step.
+        uint8_t *from = dst + pos - offset, *to = dst + pos;
+        for (size_t copied = 0; copied < length;) {
+            size_t chunk = MIN(offset + copied, length - copied);
+            memcpy(to + copied, from, chunk);
+            copied += chunk;
+        }
+        pos += length;
+    }
+    
+    return pos == dstSize;
+}
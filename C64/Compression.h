@@ -0,0 +1,62 @@
+/*!
+ * @header      Compression.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _COMPRESSION_INC
+#define _COMPRESSION_INC
+
+#include "basic.h"
+
+/* LZ block format
+ *
+ * A compressed block is a sequence of tokens. Each token starts with a byte whose upper four bits
+ * hold the number of literals and whose lower four bits hold the match length minus 4. A value of
+ * 15 indicates that the length continues in the following bytes (each byte is added, a byte
+ * smaller than 255 terminates the length). The literals follow, then the match offset (16 bit,
+ * little endian) and the match length continuation bytes. The last token of a block consists of
+ * literals only. This is the block format of LZ4, which makes the data easy to inspect with
+ * existing tools.
+ */
+
+//! @brief    Number of bits used to index the match finder's hash table
+#define LZ_HASH_BITS 14
+
+//! @brief    Number of entries of the match finder's hash table
+#define LZ_TABLE_ENTRIES (1 << LZ_HASH_BITS)
+
+//! @brief    Returns the maximum size of a compressed block
+size_t lzMaxCompressedSize(size_t size);
+
+/*! @brief    Compresses a memory block
+ *  @param    dst   Target buffer of at least lzMaxCompressedSize(size) bytes
+ *  @param    table Hash table with LZ_TABLE_ENTRIES entries. It is cleared before use. Callers
+ *                  compressing repeatedly should provide one to avoid an allocation per call.
+ *                  If NULL, a temporary table is allocated.
+ *  @result   Size of the compressed block (at least one byte) or 0, if the temporary table
+ *            could not be allocated
+ */
+size_t lzCompress(const uint8_t *src, size_t size, uint8_t *dst, uint32_t *table = NULL);
+
+/*! @brief    Decompresses a memory block
+ *  @param    dstSize  Expected size of the decompressed data
+ *  @result   false, if the compressed block is malformed or does not decompress to dstSize bytes
+ */
+bool lzDecompress(const uint8_t *src, size_t srcSize, uint8_t *dst, size_t dstSize);
+
+#endif
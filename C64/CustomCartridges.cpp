@@ -46,9 +46,8 @@ FinalIII::reset()
         
         assert(chip[i] != NULL);
         chipStartAddress[i+4] = 0xE000;
-        chipSize[i+4]         = 0x2000;
-        chip[i+4]             = (uint8_t *)malloc(0x2000);
-        memcpy(chip[i+4], chip[i] + 0x2000, 0x2000);
+        if (allocChip(i+4, 0x2000))
+            memcpy(chip[i+4], chip[i] + 0x2000, 0x2000);
     }
     
     // c64->cpu.setNMILineExpansionPort();
@@ -30,20 +30,20 @@ Datasette::Datasette()
     SnapshotItem items[] = {
         
         // Tape properties (will survive reset)
-        { &size,                    sizeof(size),                   KEEP_ON_RESET },
-        { &type,                    sizeof(type),                   KEEP_ON_RESET },
-        { &durationInCycles,        sizeof(durationInCycles),       KEEP_ON_RESET },
+        { "size",             &size,                    sizeof(size),                   KEEP_ON_RESET },
+        { "type",             &type,                    sizeof(type),                   KEEP_ON_RESET },
+        { "durationInCycles", &durationInCycles,        sizeof(durationInCycles),       KEEP_ON_RESET },
         
         // Internal state (will be cleared on reset)
-        { &head,                    sizeof(head),                   CLEAR_ON_RESET },
-        { &headInCycles,            sizeof(headInCycles),           CLEAR_ON_RESET },
-        { &headInSeconds,           sizeof(headInSeconds),          CLEAR_ON_RESET },
-        { &nextRisingEdge,          sizeof(nextRisingEdge),         CLEAR_ON_RESET },
-        { &nextFallingEdge,         sizeof(nextFallingEdge),        CLEAR_ON_RESET },
-        { &playKey,                 sizeof(playKey),                CLEAR_ON_RESET },
-        { &motor,                   sizeof(motor),                  CLEAR_ON_RESET },
+        { "head",             &head,                    sizeof(head),                   CLEAR_ON_RESET },
+        { "headInCycles",     &headInCycles,            sizeof(headInCycles),           CLEAR_ON_RESET },
+        { "headInSeconds",    &headInSeconds,           sizeof(headInSeconds),          CLEAR_ON_RESET },
+        { "nextRisingEdge",   &nextRisingEdge,          sizeof(nextRisingEdge),         CLEAR_ON_RESET },
+        { "nextFallingEdge",  &nextFallingEdge,         sizeof(nextFallingEdge),        CLEAR_ON_RESET },
+        { "playKey",          &playKey,                 sizeof(playKey),                CLEAR_ON_RESET },
+        { "motor",            &motor,                   sizeof(motor),                  CLEAR_ON_RESET },
         
-        { NULL,                     0,                              0 }};
+        { NULL,               NULL,                     0,                              0 }};
     
     registerSnapshotItems(items, sizeof(items));
     
@@ -166,6 +166,9 @@ Datasette::ejectTape()
     if (!hasTape())
         return;
     
+    if (c64->interceptInput(INPUT_EJECT_TAPE))
+        return;
+    
     pressStop();
     
     assert(data != NULL);
@@ -28,14 +28,15 @@ Disk525::Disk525()
 
     // Register snapshot items
     SnapshotItem items[] = {        
-        { data.track[0],    sizeof(data.track),     KEEP_ON_RESET },
-        { length.track[0],  sizeof(length.track),   KEEP_ON_RESET | WORD_FORMAT },
-        { &numTracks,       sizeof(numTracks),      KEEP_ON_RESET },
-        { &writeProtected,  sizeof(writeProtected), KEEP_ON_RESET },
-        { &modified,        sizeof(modified),       KEEP_ON_RESET },
-        { NULL,             0,                      0 }};
+        { "data.track",     data.track[0],    sizeof(data.track),     KEEP_ON_RESET, halftrackDirty, 7928 },
+        { "length.track",   length.track[0],  sizeof(length.track),   KEEP_ON_RESET | WORD_FORMAT },
+        { "numTracks",      &numTracks,       sizeof(numTracks),      KEEP_ON_RESET },
+        { "writeProtected", &writeProtected,  sizeof(writeProtected), KEEP_ON_RESET },
+        { "modified",       &modified,        sizeof(modified),       KEEP_ON_RESET },
+        { NULL,             NULL,             0,                      0 }};
     
     registerSnapshotItems(items, sizeof(items));
+    memset(halftrackDirty, 1, sizeof(halftrackDirty));
 
     // Create inverse GCR lookup table
     memset(invgcr, 0, sizeof(invgcr));
@@ -142,6 +143,7 @@ Disk525::clearHalftrack(Halftrack ht)
 {
     assert(isHalftrackNumber(ht));
     memset(data.halftrack[ht], 0x55, sizeof(data.halftrack[ht]));
+    halftrackDirty[ht + 1] = 1;
 }
 
 
@@ -142,6 +142,14 @@ public:
         uint16_t track[43][2];
     } length;
 
+    /*! @brief    Dirty map of the disk data
+     *  @details  The map divides data.track into pages of halftrack size. Hence, halftrackDirty[i + 1]
+     *            is set whenever halftrack i is written to. The first two entries refer to the unused
+     *            padding area and halftrack 0.
+     *  @see      VirtualComponent::setIncrementalSave
+     */
+    uint8_t halftrackDirty[86];
+
     /*! @brief       Total number of tracks on this disk
      *  @deprecated  Add method bool emptyTrack(Track nr) as a replacement
      */
@@ -262,7 +270,8 @@ public:
      *  @param  bit    0 for a '0' bit, every other value for a '1' bit
      */
     inline void writeBitToHalftrack(Halftrack ht, unsigned offset, uint8_t bit) {
-        assert(isHalftrackNumber(ht)); writeBit(data.halftrack[ht], offset % length.halftrack[ht], bit); }
+        assert(isHalftrackNumber(ht)); writeBit(data.halftrack[ht], offset % length.halftrack[ht], bit);
+        halftrackDirty[ht + 1] = 1; }
  
     /*! @brief  Writes a single byte to disk
      *  @param  data   Pointer to the first data byte of a track
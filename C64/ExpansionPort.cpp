@@ -102,6 +102,17 @@ ExpansionPort::saveToBuffer(uint8_t **buffer)
     assert(*buffer - old == stateSize());
 }
 
+bool
+ExpansionPort::collectBlobs(BlobList *list)
+{
+    bool result = VirtualComponent::collectBlobs(list);
+    
+    if (cartridge != NULL)
+        result &= cartridge->collectBlobs(list);
+    
+    return result;
+}
+
 void
 ExpansionPort::dumpState()
 {
@@ -81,6 +81,9 @@ public:
     //! @brief    Save the current state into a buffer
     void saveToBuffer(uint8_t **buffer);
     
+    //! @brief    Collects the blob store references of the attached cartridge
+    bool collectBlobs(BlobList *list);
+    
     //! @brief    Prints debugging information
     void dumpState();	
     
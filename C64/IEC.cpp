@@ -26,27 +26,27 @@ IEC::IEC()
     // Register snapshot items
     SnapshotItem items[] = {
         
-        { &driveConnected,      sizeof(driveConnected),         CLEAR_ON_RESET },
-        { &atnLine,             sizeof(atnLine),                CLEAR_ON_RESET },
-        { &oldAtnLine,          sizeof(oldAtnLine),             CLEAR_ON_RESET },
-        { &clockLine,           sizeof(clockLine),              CLEAR_ON_RESET },
-        { &oldClockLine,        sizeof(oldClockLine),           CLEAR_ON_RESET },
-        { &dataLine,            sizeof(dataLine),               CLEAR_ON_RESET },
-        { &oldDataLine,         sizeof(oldDataLine),            CLEAR_ON_RESET },
-        { &deviceAtnPin,        sizeof(deviceAtnPin),           CLEAR_ON_RESET },
-        { &deviceAtnIsOutput,   sizeof(deviceAtnIsOutput),      CLEAR_ON_RESET },
-        { &deviceDataPin,       sizeof(deviceDataPin),          CLEAR_ON_RESET },
-        { &deviceDataIsOutput,  sizeof(deviceDataIsOutput),     CLEAR_ON_RESET },
-        { &deviceClockPin,      sizeof(deviceClockPin),         CLEAR_ON_RESET },
-        { &deviceClockIsOutput, sizeof(deviceClockIsOutput),    CLEAR_ON_RESET },
-        { &ciaDataPin,          sizeof(ciaDataPin),             CLEAR_ON_RESET },
-        { &ciaDataIsOutput,     sizeof(ciaDataIsOutput),        CLEAR_ON_RESET },
-        { &ciaClockPin,         sizeof(ciaClockPin),            CLEAR_ON_RESET },
-        { &ciaClockIsOutput,    sizeof(ciaClockIsOutput),       CLEAR_ON_RESET },
-        { &ciaAtnPin,           sizeof(ciaAtnPin),              CLEAR_ON_RESET },
-        { &ciaAtnIsOutput,      sizeof(ciaAtnIsOutput),         CLEAR_ON_RESET },
-        { &busActivity,         sizeof(busActivity),            CLEAR_ON_RESET },
-        { NULL,                 0,                              0 }};
+        { "driveConnected",      &driveConnected,      sizeof(driveConnected),         CLEAR_ON_RESET },
+        { "atnLine",             &atnLine,             sizeof(atnLine),                CLEAR_ON_RESET },
+        { "oldAtnLine",          &oldAtnLine,          sizeof(oldAtnLine),             CLEAR_ON_RESET },
+        { "clockLine",           &clockLine,           sizeof(clockLine),              CLEAR_ON_RESET },
+        { "oldClockLine",        &oldClockLine,        sizeof(oldClockLine),           CLEAR_ON_RESET },
+        { "dataLine",            &dataLine,            sizeof(dataLine),               CLEAR_ON_RESET },
+        { "oldDataLine",         &oldDataLine,         sizeof(oldDataLine),            CLEAR_ON_RESET },
+        { "deviceAtnPin",        &deviceAtnPin,        sizeof(deviceAtnPin),           CLEAR_ON_RESET },
+        { "deviceAtnIsOutput",   &deviceAtnIsOutput,   sizeof(deviceAtnIsOutput),      CLEAR_ON_RESET },
+        { "deviceDataPin",       &deviceDataPin,       sizeof(deviceDataPin),          CLEAR_ON_RESET },
+        { "deviceDataIsOutput",  &deviceDataIsOutput,  sizeof(deviceDataIsOutput),     CLEAR_ON_RESET },
+        { "deviceClockPin",      &deviceClockPin,      sizeof(deviceClockPin),         CLEAR_ON_RESET },
+        { "deviceClockIsOutput", &deviceClockIsOutput, sizeof(deviceClockIsOutput),    CLEAR_ON_RESET },
+        { "ciaDataPin",          &ciaDataPin,          sizeof(ciaDataPin),             CLEAR_ON_RESET },
+        { "ciaDataIsOutput",     &ciaDataIsOutput,     sizeof(ciaDataIsOutput),        CLEAR_ON_RESET },
+        { "ciaClockPin",         &ciaClockPin,         sizeof(ciaClockPin),            CLEAR_ON_RESET },
+        { "ciaClockIsOutput",    &ciaClockIsOutput,    sizeof(ciaClockIsOutput),       CLEAR_ON_RESET },
+        { "ciaAtnPin",           &ciaAtnPin,           sizeof(ciaAtnPin),              CLEAR_ON_RESET },
+        { "ciaAtnIsOutput",      &ciaAtnIsOutput,      sizeof(ciaAtnIsOutput),         CLEAR_ON_RESET },
+        { "busActivity",         &busActivity,         sizeof(busActivity),            CLEAR_ON_RESET },
+        { NULL,                  NULL,                 0,                              0 }};
     
     registerSnapshotItems(items, sizeof(items));
 }
@@ -192,6 +192,11 @@ void IEC::updateIecLines()
 	// Update port lines
 	signals_changed = _updateIecLines(&atn_edge);	
 
+	// Wake up the drive if it has been parked in its idle loop
+	if (signals_changed) {
+		drive->wakeUp();
+	}
+
 	// Check if ATN edge occurred
 	if (atn_edge) {
 		drive->simulateAtnInterrupt();
@@ -145,6 +145,9 @@ public:
 
 	//! Returns true, iff a virtual disk drive is connected
 	bool driveIsConnected() { return driveConnected; }
+
+	//! Returns true, iff data has been transferred recently
+	bool isBusy() { return busActivity > 0; }
 		
 	//! Change/Update the value of all three bus lines 
 	void updateIecLines();
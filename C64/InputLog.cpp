@@ -0,0 +1,299 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "InputLog.h"
+
+const uint8_t InputLog::magicBytes[] = { 'V', 'C', 'I', 'L', 0x00 };
+
+//! @brief    Size of a serialized event without payload
+#define EVENT_SIZE 15
+
+static void
+put32(uint8_t **ptr, uint32_t value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8)
+        *(*ptr)++ = (uint8_t)(value >> shift);
+}
+
+static uint32_t
+get32(const uint8_t **ptr)
+{
+    uint32_t value = 0;
+    for (unsigned i = 0; i < 4; i++)
+        value = (value << 8) | *(*ptr)++;
+    return value;
+}
+
+InputLog::InputLog()
+{
+    setDescription("InputLog");
+
+    anchor = NULL;
+    events = NULL;
+    count = 0;
+    capacity = 0;
+}
+
+InputLog *
+InputLog::makeInputLogWithBuffer(const uint8_t *buffer, size_t length)
+{
+    InputLog *log = new InputLog();
+
+    if (!log->readFromBuffer(buffer, length)) {
+        delete log;
+        return NULL;
+    }
+    return log;
+}
+
+InputLog *
+InputLog::makeInputLogWithFile(const char *filename)
+{
+    InputLog *log = new InputLog();
+
+    if (!log->readFromFile(filename)) {
+        delete log;
+        return NULL;
+    }
+    return log;
+}
+
+InputLog::~InputLog()
+{
+    dealloc();
+}
+
+void
+InputLog::dealloc()
+{
+    delete anchor;
+    anchor = NULL;
+
+    for (unsigned i = 0; i < count; i++)
+        free(events[i].payload);
+    free(events);
+    events = NULL;
+    count = 0;
+    capacity = 0;
+}
+
+bool
+InputLog::isInputLog(const uint8_t *buffer, size_t length)
+{
+    assert(buffer != NULL);
+
+    if (length < 16) return false;
+    return checkBufferHeader(buffer, length, magicBytes);
+}
+
+bool
+InputLog::isInputLogFile(const char *path)
+{
+    assert(path != NULL);
+
+    return checkFileHeader(path, magicBytes);
+}
+
+void
+InputLog::setAnchor(Snapshot *snapshot)
+{
+    delete anchor;
+    anchor = snapshot;
+}
+
+bool
+InputLog::append(InputEvent *event)
+{
+    assert(event != NULL);
+
+    if (count == capacity) {
+        unsigned newCapacity = capacity ? 2 * capacity : 256;
+        InputEvent *newEvents = (InputEvent *)realloc(events, newCapacity * sizeof(InputEvent));
+        if (newEvents == NULL)
+            return false;
+        events = newEvents;
+        capacity = newCapacity;
+    }
+
+    events[count++] = *event;
+    return true;
+}
+
+bool
+InputLog::isValidEvent(const InputEvent *event)
+{
+    switch (event->type) {
+            
+        case INPUT_KEY_PRESS:
+        case INPUT_KEY_RELEASE:
+            return event->param[0] < 8 && event->param[1] < 8;
+            
+        case INPUT_JOYSTICK:
+            return event->param[0] < 2 && event->param[1] <= RELEASE_FIRE;
+            
+        default:
+            return event->type <= INPUT_RESET;
+    }
+}
+
+bool
+InputLog::resetsCycle(const InputEvent *event)
+{
+    return (event->type == INPUT_ATTACH_CARTRIDGE ||
+            event->type == INPUT_DETACH_CARTRIDGE ||
+            event->type == INPUT_RESET);
+}
+
+void
+InputLog::truncate(unsigned nr)
+{
+    while (count > nr)
+        free(events[--count].payload);
+}
+
+bool
+InputLog::readFromBuffer(const uint8_t *buffer, size_t length)
+{
+    const uint8_t *ptr = buffer, *end = buffer + length;
+
+    if (!isInputLog(buffer, length))
+        return false;
+
+    if (buffer[4] != V_MAJOR || buffer[5] != V_MINOR || buffer[6] != V_SUBMINOR) {
+        warn("Input log has been recorded with an incompatible snapshot version\n");
+        return false;
+    }
+    ptr += 8;
+
+    // Read snapshot
+    uint32_t size = get32(&ptr);
+    if (size > (size_t)(end - ptr))
+        return false;
+
+    Snapshot *snapshot = Snapshot::makeSnapshotWithBuffer(ptr, size);
+    if (snapshot == NULL)
+        return false;
+    setAnchor(snapshot);
+    ptr += size;
+
+    // Read events
+    if (end - ptr < 4)
+        return false;
+    uint32_t numEvents = get32(&ptr);
+    uint64_t minCycle = 0;
+
+    for (unsigned i = 0; i < numEvents; i++) {
+
+        InputEvent event;
+
+        if (end - ptr < EVENT_SIZE)
+            return false;
+        event.cycle = (uint64_t)get32(&ptr) << 32;
+        event.cycle |= get32(&ptr);
+        event.type = *ptr++;
+        event.param[0] = *ptr++;
+        event.param[1] = *ptr++;
+        event.payloadSize = get32(&ptr);
+        event.payload = NULL;
+
+        // Events are applied as they are. Hence, they have to be checked here.
+        if (!isValidEvent(&event) || event.cycle < minCycle) {
+            warn("Input log contains an invalid event (%u)\n", i);
+            return false;
+        }
+        minCycle = resetsCycle(&event) ? 0 : event.cycle;
+
+        if (event.payloadSize > (size_t)(end - ptr))
+            return false;
+
+        if (event.payloadSize) {
+            if ((event.payload = (uint8_t *)malloc(event.payloadSize)) == NULL)
+                return false;
+            memcpy(event.payload, ptr, event.payloadSize);
+            ptr += event.payloadSize;
+        }
+        if (!append(&event)) {
+            free(event.payload);
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t
+InputLog::writeToBuffer(uint8_t *buffer)
+{
+    if (anchor == NULL)
+        return 0;
+
+    // Compress the snapshot
+    size_t imageSize = anchor->writeToBuffer(NULL);
+    uint8_t *image = (uint8_t *)malloc(imageSize);
+    uint8_t *container = (uint8_t *)malloc(Snapshot::maxContainerSize(imageSize));
+    if (image == NULL || container == NULL) {
+        free(image);
+        free(container);
+        return 0;
+    }
+    anchor->writeToBuffer(image);
+    size_t containerSize = Snapshot::compressImage(image, imageSize, container);
+    if (containerSize == 0) {
+        free(image);
+        free(container);
+        return 0;
+    }
+
+    size_t result = 8 + 4 + containerSize + 4;
+    for (unsigned i = 0; i < count; i++)
+        result += EVENT_SIZE + events[i].payloadSize;
+
+    if (buffer) {
+
+        uint8_t *ptr = buffer;
+
+        memcpy(ptr, magicBytes, 4);
+        ptr[4] = V_MAJOR;
+        ptr[5] = V_MINOR;
+        ptr[6] = V_SUBMINOR;
+        ptr[7] = 0;
+        ptr += 8;
+
+        put32(&ptr, (uint32_t)containerSize);
+        memcpy(ptr, container, containerSize);
+        ptr += containerSize;
+
+        put32(&ptr, count);
+        for (unsigned i = 0; i < count; i++) {
+            put32(&ptr, (uint32_t)(events[i].cycle >> 32));
+            put32(&ptr, (uint32_t)events[i].cycle);
+            *ptr++ = events[i].type;
+            *ptr++ = events[i].param[0];
+            *ptr++ = events[i].param[1];
+            put32(&ptr, (uint32_t)events[i].payloadSize);
+            if (events[i].payloadSize)
+                memcpy(ptr, events[i].payload, events[i].payloadSize);
+            ptr += events[i].payloadSize;
+        }
+        assert((size_t)(ptr - buffer) == result);
+    }
+
+    free(image);
+    free(container);
+    return result;
+}
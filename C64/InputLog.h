@@ -0,0 +1,169 @@
+/*!
+ * @header      InputLog.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _INPUTLOG_INC
+#define _INPUTLOG_INC
+
+#include "Snapshot.h"
+
+/*! @enum     InputEventType
+ *  @brief    Kinds of user input recorded in an input log
+ *  @details  The meaning of the two parameter bytes depends on the event type:
+ *
+ *                INPUT_KEY_PRESS, INPUT_KEY_RELEASE : Row and column in the keyboard matrix
+ *                INPUT_JOYSTICK                     : Joystick (0 = A, 1 = B) and JoystickEvent
+ *                INPUT_ALWAYS_WARP, INPUT_WARP_LOAD : New value (0 or 1)
+ *                INPUT_INSERT_DISK                  : ContainerType of the payload
+ *
+ *            Disk, tape, and cartridge events carry the media file as payload. INPUT_RESET
+ *            is recorded when the user powers up the C64 via C64::powerUp().
+ */
+typedef enum {
+    INPUT_KEY_PRESS = 0,
+    INPUT_KEY_RELEASE,
+    INPUT_RESTORE_PRESS,
+    INPUT_RESTORE_RELEASE,
+    INPUT_JOYSTICK,
+    INPUT_ALWAYS_WARP,
+    INPUT_WARP_LOAD,
+    INPUT_INSERT_DISK,
+    INPUT_EJECT_DISK,
+    INPUT_INSERT_TAPE,
+    INPUT_EJECT_TAPE,
+    INPUT_ATTACH_CARTRIDGE,
+    INPUT_DETACH_CARTRIDGE,
+    INPUT_RESET
+} InputEventType;
+
+//! @brief    A single input event
+typedef struct {
+
+    //! @brief    Value of C64::cycle at which the event took effect
+    uint64_t cycle;
+
+    //! @brief    Event type (InputEventType)
+    uint8_t type;
+
+    //! @brief    Event parameters
+    uint8_t param[2];
+
+    //! @brief    Media file (disk, tape, or cartridge) or NULL
+    uint8_t *payload;
+    size_t payloadSize;
+
+} InputEvent;
+
+/*! @class    InputLog
+ *  @brief    A recorded emulator session (movie file)
+ *  @details  An input log consists of a snapshot the session starts with and a list of all
+ *            user inputs, each tagged with the cycle at which it took effect. Replaying the
+ *            inputs on top of the snapshot reproduces the session exactly. Note that cycle
+ *            values start over at 0 after a cartridge has been attached or detached, because
+ *            both events reset the C64.
+ *            Recording and replaying is done by class C64 (see C64::startRecording()).
+ *
+ *            File format (all numbers big endian):
+ *
+ *                'V','C','I','L', major, minor, subminor, 0
+ *                u32 size of the snapshot, compressed snapshot container
+ *                u32 number of events
+ *                per event: u64 cycle, u8 type, u8 param[2], u32 payload size, payload
+ */
+class InputLog : public Container {
+
+private:
+
+    //! @brief    Header signature
+    static const uint8_t magicBytes[];
+
+    //! @brief    Snapshot the recorded session starts with
+    Snapshot *anchor;
+
+    //! @brief    Recorded events in chronological order
+    InputEvent *events;
+
+    //! @brief    Number of recorded events
+    unsigned count;
+
+    //! @brief    Number of events the events array can hold
+    unsigned capacity;
+
+    /*! @brief    Checks the event type and the parameters of an event read from a file
+     *  @details  Out of range parameters must never reach C64::applyInput().
+     */
+    static bool isValidEvent(const InputEvent *event);
+
+    //! @brief    Returns true iff the event resets the C64, which starts the cycle count over
+    static bool resetsCycle(const InputEvent *event);
+
+public:
+
+    //! @brief    Constructor
+    InputLog();
+
+    //! @brief    Factory method
+    static InputLog *makeInputLogWithBuffer(const uint8_t *buffer, size_t length);
+
+    //! @brief    Factory method
+    static InputLog *makeInputLogWithFile(const char *filename);
+
+    //! @brief    Destructor
+    ~InputLog();
+
+    //! @brief    Frees the allocated memory
+    void dealloc();
+
+    //! @brief    Returns true iff buffer contains an input log
+    static bool isInputLog(const uint8_t *buffer, size_t length);
+
+    //! @brief    Returns true iff path points to an input log
+    static bool isInputLogFile(const char *path);
+
+    //! @brief    Returns the snapshot the session starts with
+    Snapshot *getAnchor() { return anchor; }
+
+    //! @brief    Sets the snapshot the session starts with (the log takes ownership)
+    void setAnchor(Snapshot *snapshot);
+
+    //! @brief    Returns the number of recorded events
+    unsigned numEvents() { return count; }
+
+    //! @brief    Returns an event
+    InputEvent *getEvent(unsigned nr) { assert(nr < count); return &events[nr]; }
+
+    /*! @brief    Appends an event (the log takes ownership of the payload)
+     *  @result   false, if memory is exhausted. The payload stays with the caller then.
+     */
+    bool append(InputEvent *event);
+
+    //! @brief    Discards all events starting with the specified one
+    void truncate(unsigned nr);
+
+    //
+    // Virtual functions from Container class
+    //
+
+    const char *typeAsString() { return "VCIL"; }
+    bool hasSameType(const char *filename) { return isInputLogFile(filename); }
+    bool readFromBuffer(const uint8_t *buffer, size_t length);
+    size_t writeToBuffer(uint8_t *buffer);
+};
+
+#endif
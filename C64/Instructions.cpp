@@ -19,8 +19,6 @@
 #include "C64.h"
 
 // DIRK DEBUG, REMOVE ASAP
-extern unsigned dirktrace;
-extern unsigned dirkcnt;
 
 // Cycle 0
 void 
@@ -40,19 +38,22 @@ CPU::fetch() {
         if (tracingEnabled())
             debug(1, "NMI (source = %02X)\n", nmiLine);
         nmiEdge = false;
-        next = &CPU::nmi_2;
+        SET_NEXT(nmi_2);
         return;
 
     } else if (irqLine && !IRQsAreBlocked() && IRQLineRaisedLongEnough()) {
         if (tracingEnabled())
             debug(1, "IRQ (source = %02X)\n", irqLine);
-        next = &CPU::irq_2;
+        SET_NEXT(irq_2);
         return;
     }
 
     // Execute fetch phase
     FETCH_OPCODE
     next = actionFunc[opcode];
+#ifdef VC64_THREADED_CPU
+    nextIndex = actionIndex[opcode];
+#endif
 
     // Disassemble command if requested
     if (tracingEnabled()) {
@@ -406,7 +407,7 @@ void CPU::registerInstructions()
 void CPU::JAM()
 {
 	setErrorState(CPU_ILLEGAL_INSTRUCTION);
-	next = &CPU::JAM_2;
+	SET_NEXT(JAM_2);
 }
 
 void CPU::JAM_2()
@@ -420,39 +421,39 @@ void CPU::JAM_2()
 void CPU::irq()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::irq_2;
+	SET_NEXT(irq_2);
 }
 void CPU::irq_2()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::irq_3;
+	SET_NEXT(irq_3);
 }
 void CPU::irq_3()
 {
-	mem->poke(0x100+(SP--), HI_BYTE(PC));
-	next = &CPU::irq_4;
+	pokeMem(0x100+(SP--), HI_BYTE(PC));
+	SET_NEXT(irq_4);
 }
 void CPU::irq_4()
 {
-	mem->poke(0x100+(SP--), LO_BYTE(PC));
-	next = &CPU::irq_5;
+	pokeMem(0x100+(SP--), LO_BYTE(PC));
+	SET_NEXT(irq_5);
 }
 void CPU::irq_5()
 {
 	uint8_t p = getPWithClearedB();
-	mem->poke(0x100+(SP--), p);	
+	pokeMem(0x100+(SP--), p);	
 	setI(1);
-	next = &CPU::irq_6;
+	SET_NEXT(irq_6);
 }
 void CPU::irq_6()
 {
-	data = mem->peek(0xFFFE);
-	next = &CPU::irq_7;
+	data = peekMem(0xFFFE);
+	SET_NEXT(irq_7);
 }
 void CPU::irq_7()
 {
 	setPCL(data);
-	setPCH(mem->peek(0xFFFF));
+	setPCH(peekMem(0xFFFF));
 	DONE;
 }
 
@@ -463,38 +464,38 @@ void CPU::irq_7()
 void CPU::nmi()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::nmi_2;
+	SET_NEXT(nmi_2);
 }
 void CPU::nmi_2()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::nmi_3;
+	SET_NEXT(nmi_3);
 }
 void CPU::nmi_3()
 {
-	mem->poke(0x100+(SP--), HI_BYTE(PC));
-	next = &CPU::nmi_4;
+	pokeMem(0x100+(SP--), HI_BYTE(PC));
+	SET_NEXT(nmi_4);
 }
 void CPU::nmi_4()
 {
-	mem->poke(0x100+(SP--), LO_BYTE(PC));
-	next = &CPU::nmi_5;
+	pokeMem(0x100+(SP--), LO_BYTE(PC));
+	SET_NEXT(nmi_5);
 }
 void CPU::nmi_5()
 {
-	mem->poke(0x100+(SP--), getPWithClearedB());	
+	pokeMem(0x100+(SP--), getPWithClearedB());	
 	setI(1);
-	next = &CPU::nmi_6;
+	SET_NEXT(nmi_6);
 }
 void CPU::nmi_6()
 {
-	data = mem->peek(0xFFFA);
-	next = &CPU::nmi_7;
+	data = peekMem(0xFFFA);
+	SET_NEXT(nmi_7);
 }
 void CPU::nmi_7()
 {
 	setPCL(data);
-	setPCH(mem->peek(0xFFFB));
+	setPCH(peekMem(0xFFFB));
     // printf("\n\nNMI: Jumping to %04X\n\n", PC);
 	DONE;
 }
@@ -570,7 +571,7 @@ void CPU::ADC_immediate()
 void CPU::ADC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_zero_page_2;
+	SET_NEXT(ADC_zero_page_2);
 }
 
 void CPU::ADC_zero_page_2() 
@@ -584,13 +585,13 @@ void CPU::ADC_zero_page_2()
 void CPU::ADC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_zero_page_x_2;
+	SET_NEXT(ADC_zero_page_x_2);
 }
 void CPU::ADC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ADC_zero_page_x_3;
+	SET_NEXT(ADC_zero_page_x_3);
 }
 void CPU::ADC_zero_page_x_3() 
 {
@@ -603,12 +604,12 @@ void CPU::ADC_zero_page_x_3()
 void CPU::ADC_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::ADC_absolute_2; 
+	SET_NEXT(ADC_absolute_2); 
 }
 void CPU::ADC_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::ADC_absolute_3; 
+	SET_NEXT(ADC_absolute_3); 
 }
 void CPU::ADC_absolute_3() 
 { 
@@ -621,20 +622,20 @@ void CPU::ADC_absolute_3()
 void CPU::ADC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_absolute_x_2;
+	SET_NEXT(ADC_absolute_x_2);
 }
 void CPU::ADC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ADC_absolute_x_3;
+	SET_NEXT(ADC_absolute_x_3);
 }
 void CPU::ADC_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ADC_absolute_x_4;
+		SET_NEXT(ADC_absolute_x_4);
 	} else {
 		adc(data);
 		DONE;
@@ -651,20 +652,20 @@ void CPU::ADC_absolute_x_4()
 void CPU::ADC_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ADC_absolute_y_2;
+	SET_NEXT(ADC_absolute_y_2);
 }
 void CPU::ADC_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::ADC_absolute_y_3;
+	SET_NEXT(ADC_absolute_y_3);
 }
 void CPU::ADC_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ADC_absolute_y_4;
+		SET_NEXT(ADC_absolute_y_4);
 	} else {
 		adc(data);
 		DONE;
@@ -681,23 +682,23 @@ void CPU::ADC_absolute_y_4()
 void CPU::ADC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ADC_indirect_x_2;
+	SET_NEXT(ADC_indirect_x_2);
 }
 void CPU::ADC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ADC_indirect_x_3;
+	SET_NEXT(ADC_indirect_x_3);
 }
 void CPU::ADC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ADC_indirect_x_4;
+	SET_NEXT(ADC_indirect_x_4);
 }
 void CPU::ADC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ADC_indirect_x_5;
+	SET_NEXT(ADC_indirect_x_5);
 }
 void CPU::ADC_indirect_x_5()
 {
@@ -710,25 +711,25 @@ void CPU::ADC_indirect_x_5()
 void CPU::ADC_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ADC_indirect_y_2;
+	SET_NEXT(ADC_indirect_y_2);
 }
 void CPU::ADC_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ADC_indirect_y_3;
+	SET_NEXT(ADC_indirect_y_3);
 }
 void CPU::ADC_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::ADC_indirect_y_4;
+	SET_NEXT(ADC_indirect_y_4);
 }
 void CPU::ADC_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ADC_indirect_y_5;
+		SET_NEXT(ADC_indirect_y_5);
 	} else {
 		adc(data);
 		DONE;
@@ -761,11 +762,11 @@ void CPU::AND_immediate()
 // -------------------------------------------------------------------------------
 void CPU::AND_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_absolute_2;
+	SET_NEXT(AND_absolute_2);
 }
 void CPU::AND_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::AND_absolute_3;
+	SET_NEXT(AND_absolute_3);
 }
 void CPU::AND_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -777,7 +778,7 @@ void CPU::AND_absolute_3() {
 void CPU::AND_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_zero_page_2;
+	SET_NEXT(AND_zero_page_2);
 }
 void CPU::AND_zero_page_2()
 {
@@ -790,13 +791,13 @@ void CPU::AND_zero_page_2()
 void CPU::AND_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_zero_page_x_2;
+	SET_NEXT(AND_zero_page_x_2);
 }
 void CPU::AND_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::AND_zero_page_x_3;
+	SET_NEXT(AND_zero_page_x_3);
 }
 void CPU::AND_zero_page_x_3()
 {
@@ -809,20 +810,20 @@ void CPU::AND_zero_page_x_3()
 void CPU::AND_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_absolute_x_2;
+	SET_NEXT(AND_absolute_x_2);
 }
 void CPU::AND_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::AND_absolute_x_3;
+	SET_NEXT(AND_absolute_x_3);
 }
 void CPU::AND_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::AND_absolute_x_4;
+		SET_NEXT(AND_absolute_x_4);
 	} else {
 		loadA(A & data);
 		DONE;
@@ -839,20 +840,20 @@ void CPU::AND_absolute_x_4()
 void CPU::AND_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::AND_absolute_y_2;
+	SET_NEXT(AND_absolute_y_2);
 }
 void CPU::AND_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::AND_absolute_y_3;
+	SET_NEXT(AND_absolute_y_3);
 }
 void CPU::AND_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::AND_absolute_y_4;
+		SET_NEXT(AND_absolute_y_4);
 	} else {
 		loadA(A & data);
 		DONE;
@@ -869,23 +870,23 @@ void CPU::AND_absolute_y_4()
 void CPU::AND_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::AND_indirect_x_2;
+	SET_NEXT(AND_indirect_x_2);
 }
 void CPU::AND_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::AND_indirect_x_3;
+	SET_NEXT(AND_indirect_x_3);
 }
 void CPU::AND_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::AND_indirect_x_4;
+	SET_NEXT(AND_indirect_x_4);
 }
 void CPU::AND_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::AND_indirect_x_5;
+	SET_NEXT(AND_indirect_x_5);
 }
 void CPU::AND_indirect_x_5()
 {
@@ -898,25 +899,25 @@ void CPU::AND_indirect_x_5()
 void CPU::AND_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::AND_indirect_y_2;
+	SET_NEXT(AND_indirect_y_2);
 }
 void CPU::AND_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::AND_indirect_y_3;
+	SET_NEXT(AND_indirect_y_3);
 }
 void CPU::AND_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::AND_indirect_y_4;
+	SET_NEXT(AND_indirect_y_4);
 }
 void CPU::AND_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::AND_indirect_y_5;
+		SET_NEXT(AND_indirect_y_5);
 	} else {
 		loadA(A & data);
 		DONE;
@@ -953,18 +954,18 @@ void CPU::ASL_accumulator()
 void CPU::ASL_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_zero_page_2;
+	SET_NEXT(ASL_zero_page_2);
 }
 void CPU::ASL_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ASL_zero_page_3;
+	SET_NEXT(ASL_zero_page_3);
 }
 void CPU::ASL_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ASL;
-	next = &CPU::ASL_zero_page_4;
+	SET_NEXT(ASL_zero_page_4);
 }
 void CPU::ASL_zero_page_4()
 {
@@ -976,24 +977,24 @@ void CPU::ASL_zero_page_4()
 void CPU::ASL_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_zero_page_x_2;
+	SET_NEXT(ASL_zero_page_x_2);
 }
 void CPU::ASL_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ASL_zero_page_x_3;
+	SET_NEXT(ASL_zero_page_x_3);
 }
 void CPU::ASL_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ASL_zero_page_x_4;
+	SET_NEXT(ASL_zero_page_x_4);
 }
 void CPU::ASL_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ASL;
-	next = &CPU::ASL_zero_page_x_5;
+	SET_NEXT(ASL_zero_page_x_5);
 }
 void CPU::ASL_zero_page_x_5()
 {
@@ -1005,23 +1006,23 @@ void CPU::ASL_zero_page_x_5()
 void CPU::ASL_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_absolute_2;
+	SET_NEXT(ASL_absolute_2);
 }
 void CPU::ASL_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ASL_absolute_3;
+	SET_NEXT(ASL_absolute_3);
 }
 void CPU::ASL_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ASL_absolute_4;
+	SET_NEXT(ASL_absolute_4);
 }
 void CPU::ASL_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ASL;
-	next = &CPU::ASL_absolute_5;
+	SET_NEXT(ASL_absolute_5);
 }
 void CPU::ASL_absolute_5()
 {
@@ -1033,31 +1034,31 @@ void CPU::ASL_absolute_5()
 void CPU::ASL_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ASL_absolute_x_2;
+	SET_NEXT(ASL_absolute_x_2);
 }
 void CPU::ASL_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ASL_absolute_x_3;
+	SET_NEXT(ASL_absolute_x_3);
 }
 void CPU::ASL_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::ASL_absolute_x_4;
+	SET_NEXT(ASL_absolute_x_4);
 }
 void CPU::ASL_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ASL_absolute_x_5;
+	SET_NEXT(ASL_absolute_x_5);
 }
 void CPU::ASL_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ASL;
-	next = &CPU::ASL_absolute_x_6;
+	SET_NEXT(ASL_absolute_x_6);
 }
 void CPU::ASL_absolute_x_6()
 {
@@ -1069,34 +1070,34 @@ void CPU::ASL_absolute_x_6()
 void CPU::ASL_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ASL_indirect_x_2;
+	SET_NEXT(ASL_indirect_x_2);
 }
 void CPU::ASL_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ASL_indirect_x_3;
+	SET_NEXT(ASL_indirect_x_3);
 }
 void CPU::ASL_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ASL_indirect_x_4;
+	SET_NEXT(ASL_indirect_x_4);
 }
 void CPU::ASL_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ASL_indirect_x_5;
+	SET_NEXT(ASL_indirect_x_5);
 }
 void CPU::ASL_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ASL_indirect_x_6;
+	SET_NEXT(ASL_indirect_x_6);
 }
 void CPU::ASL_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ASL;
-	next = &CPU::ASL_indirect_x_7;
+	SET_NEXT(ASL_indirect_x_7);
 }
 void CPU::ASL_indirect_x_7()
 {
@@ -1135,7 +1136,7 @@ void CPU::BCC_relative()
 {
 	READ_IMMEDIATE;
 	if (!getC()) { 
-		next = &CPU::BCC_relative_2;
+		SET_NEXT(BCC_relative_2);
 	} else {
 		DONE;
 	}
@@ -1147,7 +1148,7 @@ void CPU::BCC_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1169,7 +1170,7 @@ void CPU::BCS_relative()
 {	
 	READ_IMMEDIATE;
 	if (getC()) { 
-		next = &CPU::BCS_relative_2;
+		SET_NEXT(BCS_relative_2);
 	} else {
 		DONE;
 	}
@@ -1181,7 +1182,7 @@ void CPU::BCS_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1203,7 +1204,7 @@ void CPU::BEQ_relative()
 {	
 	READ_IMMEDIATE;
 	if (getZ()) { 
-		next = &CPU::BEQ_relative_2;
+		SET_NEXT(BEQ_relative_2);
 	} else {
 		DONE;
 	}
@@ -1215,7 +1216,7 @@ void CPU::BEQ_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1236,7 +1237,7 @@ void CPU::BEQ_relative_2()
 void CPU::BIT_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::BIT_zero_page_2;
+	SET_NEXT(BIT_zero_page_2);
 }
 void CPU::BIT_zero_page_2()
 {
@@ -1251,12 +1252,12 @@ void CPU::BIT_zero_page_2()
 void CPU::BIT_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::BIT_absolute_2;
+	SET_NEXT(BIT_absolute_2);
 }
 void CPU::BIT_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::BIT_absolute_3;
+	SET_NEXT(BIT_absolute_3);
 }
 void CPU::BIT_absolute_3()
 {
@@ -1281,7 +1282,7 @@ void CPU::BMI_relative()
 {	
 	READ_IMMEDIATE;
 	if (getN()) { 
-		next = &CPU::BMI_relative_2;
+		SET_NEXT(BMI_relative_2);
 	} else {
 		DONE;
 	}
@@ -1293,7 +1294,7 @@ void CPU::BMI_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1315,7 +1316,7 @@ void CPU::BNE_relative()
 {	
 	READ_IMMEDIATE;
 	if (!getZ()) { 
-		next = &CPU::BNE_relative_2;
+		SET_NEXT(BNE_relative_2);
 	} else {
 		DONE;
 	}
@@ -1327,7 +1328,7 @@ void CPU::BNE_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1349,7 +1350,7 @@ void CPU::BPL_relative()
 {	
 	READ_IMMEDIATE;
 	if (!getN()) { 
-		next = &CPU::BPL_relative_2;
+		SET_NEXT(BPL_relative_2);
 	} else {
 		DONE;
 	}
@@ -1361,7 +1362,7 @@ void CPU::BPL_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
         nextPossibleNmiCycle++;
@@ -1382,13 +1383,13 @@ void CPU::BPL_relative_2()
 void CPU::BRK()
 {
 	IDLE_READ_IMMEDIATE;
-	next = &CPU::BRK_2;
+	SET_NEXT(BRK_2);
 }
 void CPU::BRK_2()
 {
 	setB(1); 
 	PUSH_PCH;
-	next = &CPU::BRK_3;
+	SET_NEXT(BRK_3);
 }
 void CPU::BRK_3()
 {
@@ -1399,25 +1400,25 @@ void CPU::BRK_3()
 	//  jump to the NMI vector ($FFFA), and the P register will be pushed on the stack with the B flag set."
 	if (nmiEdge) {
         clearNMIEdge();
-		next = &CPU::BRK_nmi_4;
+		SET_NEXT(BRK_nmi_4);
 	} else {
-		next = &CPU::BRK_4;
+		SET_NEXT(BRK_4);
 	}
 }
 void CPU::BRK_4()
 {
 	PUSH_P;
-	next = &CPU::BRK_5;
+	SET_NEXT(BRK_5);
 }
 void CPU::BRK_5()
 {
-	data = mem->peek(0xFFFE);
-	next = &CPU::BRK_6;
+	data = peekMem(0xFFFE);
+	SET_NEXT(BRK_6);
 }
 void CPU::BRK_6()
 {
 	setPCL(data);
-	setPCH(mem->peek(0xFFFF));	
+	setPCH(peekMem(0xFFFF));	
 	setI(1);
 
 	// "Ein NMI darf nicht sofort nach einem BRK oder IRQ ausgefhrt werden, sondern erst mit 1 Cycle Delay." 
@@ -1430,18 +1431,18 @@ void CPU::BRK_6()
 void CPU::BRK_nmi_4()
 {
 	PUSH_P;
-	next = &CPU::BRK_nmi_5;
+	SET_NEXT(BRK_nmi_5);
 }
 
 void CPU::BRK_nmi_5()
 {
-	data = mem->peek(0xFFFA);
-	next = &CPU::BRK_nmi_6;
+	data = peekMem(0xFFFA);
+	SET_NEXT(BRK_nmi_6);
 }
 void CPU::BRK_nmi_6()
 {
 	setPCL(data);
-	setPCH(mem->peek(0xFFFB));	
+	setPCH(peekMem(0xFFFB));	
 	setI(1);	
 	DONE;
 }
@@ -1463,7 +1464,7 @@ void CPU::BVC_relative()
         
         // Special handling for the VC1541 CPU. Taken from Frodo
         if (!((c64->floppy.via2.io[12] & 0x0E) == 0x0E || getV())) {
-            next = &CPU::BVC_relative_2;
+            SET_NEXT(BVC_relative_2);
         } else {
             DONE;
         }
@@ -1472,7 +1473,7 @@ void CPU::BVC_relative()
         
         // Standard CPU behavior
         if (!getV()) {
-            next = &CPU::BVC_relative_2;
+            SET_NEXT(BVC_relative_2);
         } else {
             DONE;
         }
@@ -1486,7 +1487,7 @@ void CPU::BVC_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++;
@@ -1512,7 +1513,7 @@ void CPU::BVS_relative()
         
         // Special handling for the VC1541 CPU. Taken from Frodo
         if ((c64->floppy.via2.io[12] & 0x0E) == 0x0E || getV()) {
-            next = &CPU::BVS_relative_2;
+            SET_NEXT(BVS_relative_2);
         } else {
             DONE;
         }
@@ -1521,7 +1522,7 @@ void CPU::BVS_relative()
         
         // Standard CPU behavior
         if (getV()) {
-            next = &CPU::BVS_relative_2;
+            SET_NEXT(BVS_relative_2);
         } else {
             DONE;
         }
@@ -1535,7 +1536,7 @@ void CPU::BVS_relative_2()
 	PC += (int8_t)data;
 	
 	if (pc_hi != HI_BYTE(PC)) {
-		next = (data & 0x80) ? &CPU::branch_3_underflow : &CPU::branch_3_overflow;
+		if (data & 0x80) SET_NEXT(branch_3_underflow); else SET_NEXT(branch_3_overflow);
 	} else {
 		nextPossibleIrqCycle++; // Delay IRQs by one cycle
 		nextPossibleNmiCycle++; 
@@ -1651,11 +1652,11 @@ void CPU::CMP_immediate()
 // -------------------------------------------------------------------------------
 void CPU::CMP_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_absolute_2;
+	SET_NEXT(CMP_absolute_2);
 }
 void CPU::CMP_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::CMP_absolute_3;
+	SET_NEXT(CMP_absolute_3);
 }
 void CPU::CMP_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -1667,7 +1668,7 @@ void CPU::CMP_absolute_3() {
 void CPU::CMP_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_zero_page_2;
+	SET_NEXT(CMP_zero_page_2);
 }
 void CPU::CMP_zero_page_2()
 {
@@ -1680,13 +1681,13 @@ void CPU::CMP_zero_page_2()
 void CPU::CMP_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_zero_page_x_2;
+	SET_NEXT(CMP_zero_page_x_2);
 }
 void CPU::CMP_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::CMP_zero_page_x_3;
+	SET_NEXT(CMP_zero_page_x_3);
 }
 void CPU::CMP_zero_page_x_3()
 {
@@ -1699,20 +1700,20 @@ void CPU::CMP_zero_page_x_3()
 void CPU::CMP_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_absolute_x_2;
+	SET_NEXT(CMP_absolute_x_2);
 }
 void CPU::CMP_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::CMP_absolute_x_3;
+	SET_NEXT(CMP_absolute_x_3);
 }
 void CPU::CMP_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::CMP_absolute_x_4;
+		SET_NEXT(CMP_absolute_x_4);
 	} else {
 		cmp(A, data);
 		DONE;
@@ -1729,20 +1730,20 @@ void CPU::CMP_absolute_x_4()
 void CPU::CMP_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CMP_absolute_y_2;
+	SET_NEXT(CMP_absolute_y_2);
 }
 void CPU::CMP_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::CMP_absolute_y_3;
+	SET_NEXT(CMP_absolute_y_3);
 }
 void CPU::CMP_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::CMP_absolute_y_4;
+		SET_NEXT(CMP_absolute_y_4);
 	} else {
 		cmp(A, data);
 		DONE;
@@ -1759,23 +1760,23 @@ void CPU::CMP_absolute_y_4()
 void CPU::CMP_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::CMP_indirect_x_2;
+	SET_NEXT(CMP_indirect_x_2);
 }
 void CPU::CMP_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::CMP_indirect_x_3;
+	SET_NEXT(CMP_indirect_x_3);
 }
 void CPU::CMP_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::CMP_indirect_x_4;
+	SET_NEXT(CMP_indirect_x_4);
 }
 void CPU::CMP_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::CMP_indirect_x_5;
+	SET_NEXT(CMP_indirect_x_5);
 }
 void CPU::CMP_indirect_x_5()
 {
@@ -1788,25 +1789,25 @@ void CPU::CMP_indirect_x_5()
 void CPU::CMP_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::CMP_indirect_y_2;
+	SET_NEXT(CMP_indirect_y_2);
 }
 void CPU::CMP_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::CMP_indirect_y_3;
+	SET_NEXT(CMP_indirect_y_3);
 }
 void CPU::CMP_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::CMP_indirect_y_4;
+	SET_NEXT(CMP_indirect_y_4);
 }
 void CPU::CMP_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::CMP_indirect_y_5;
+		SET_NEXT(CMP_indirect_y_5);
 	} else {
 		cmp(A, data);
 		DONE;
@@ -1840,7 +1841,7 @@ void CPU::CPX_immediate()
 void CPU::CPX_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CPX_zero_page_2;
+	SET_NEXT(CPX_zero_page_2);
 }
 void CPU::CPX_zero_page_2()
 {
@@ -1852,11 +1853,11 @@ void CPU::CPX_zero_page_2()
 // -------------------------------------------------------------------------------
 void CPU::CPX_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::CPX_absolute_2;
+	SET_NEXT(CPX_absolute_2);
 }
 void CPU::CPX_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::CPX_absolute_3;
+	SET_NEXT(CPX_absolute_3);
 }
 void CPU::CPX_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -1885,7 +1886,7 @@ void CPU::CPY_immediate()
 void CPU::CPY_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::CPY_zero_page_2;
+	SET_NEXT(CPY_zero_page_2);
 }
 void CPU::CPY_zero_page_2()
 {
@@ -1897,11 +1898,11 @@ void CPU::CPY_zero_page_2()
 // -------------------------------------------------------------------------------
 void CPU::CPY_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::CPY_absolute_2;
+	SET_NEXT(CPY_absolute_2);
 }
 void CPU::CPY_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::CPY_absolute_3;
+	SET_NEXT(CPY_absolute_3);
 }
 void CPU::CPY_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -1925,18 +1926,18 @@ void CPU::CPY_absolute_3() {
 void CPU::DEC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_zero_page_2;
+	SET_NEXT(DEC_zero_page_2);
 }
 void CPU::DEC_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DEC_zero_page_3;
+	SET_NEXT(DEC_zero_page_3);
 }
 void CPU::DEC_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DEC_zero_page_4;
+	SET_NEXT(DEC_zero_page_4);
 }
 void CPU::DEC_zero_page_4()
 {
@@ -1948,24 +1949,24 @@ void CPU::DEC_zero_page_4()
 void CPU::DEC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_zero_page_x_2;
+	SET_NEXT(DEC_zero_page_x_2);
 }
 void CPU::DEC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::DEC_zero_page_x_3;
+	SET_NEXT(DEC_zero_page_x_3);
 }
 void CPU::DEC_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DEC_zero_page_x_4;
+	SET_NEXT(DEC_zero_page_x_4);
 }
 void CPU::DEC_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DEC_zero_page_x_5;
+	SET_NEXT(DEC_zero_page_x_5);
 }
 void CPU::DEC_zero_page_x_5()
 {
@@ -1977,23 +1978,23 @@ void CPU::DEC_zero_page_x_5()
 void CPU::DEC_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_absolute_2;
+	SET_NEXT(DEC_absolute_2);
 }
 void CPU::DEC_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::DEC_absolute_3;
+	SET_NEXT(DEC_absolute_3);
 }
 void CPU::DEC_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DEC_absolute_4;
+	SET_NEXT(DEC_absolute_4);
 }
 void CPU::DEC_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DEC_absolute_5;
+	SET_NEXT(DEC_absolute_5);
 }
 void CPU::DEC_absolute_5()
 {
@@ -2005,13 +2006,13 @@ void CPU::DEC_absolute_5()
 void CPU::DEC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DEC_absolute_x_2;
+	SET_NEXT(DEC_absolute_x_2);
 }
 void CPU::DEC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::DEC_absolute_x_3;
+	SET_NEXT(DEC_absolute_x_3);
 }
 void CPU::DEC_absolute_x_3()
 {
@@ -2019,18 +2020,18 @@ void CPU::DEC_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DEC_absolute_x_4;
+	SET_NEXT(DEC_absolute_x_4);
 }
 void CPU::DEC_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DEC_absolute_x_5;
+	SET_NEXT(DEC_absolute_x_5);
 }
 void CPU::DEC_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DEC_absolute_x_6;
+	SET_NEXT(DEC_absolute_x_6);
 }
 void CPU::DEC_absolute_x_6()
 {
@@ -2042,34 +2043,34 @@ void CPU::DEC_absolute_x_6()
 void CPU::DEC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::DEC_indirect_x_2;
+	SET_NEXT(DEC_indirect_x_2);
 }
 void CPU::DEC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::DEC_indirect_x_3;
+	SET_NEXT(DEC_indirect_x_3);
 }
 void CPU::DEC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::DEC_indirect_x_4;
+	SET_NEXT(DEC_indirect_x_4);
 }
 void CPU::DEC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::DEC_indirect_x_5;
+	SET_NEXT(DEC_indirect_x_5);
 }
 void CPU::DEC_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DEC_indirect_x_6;
+	SET_NEXT(DEC_indirect_x_6);
 }
 void CPU::DEC_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DEC_indirect_x_7;
+	SET_NEXT(DEC_indirect_x_7);
 }
 void CPU::DEC_indirect_x_7()
 {
@@ -2131,11 +2132,11 @@ void CPU::EOR_immediate()
 // -------------------------------------------------------------------------------
 void CPU::EOR_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_absolute_2;
+	SET_NEXT(EOR_absolute_2);
 }
 void CPU::EOR_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::EOR_absolute_3;
+	SET_NEXT(EOR_absolute_3);
 }
 void CPU::EOR_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -2147,7 +2148,7 @@ void CPU::EOR_absolute_3() {
 void CPU::EOR_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_zero_page_2;
+	SET_NEXT(EOR_zero_page_2);
 }
 void CPU::EOR_zero_page_2()
 {
@@ -2160,13 +2161,13 @@ void CPU::EOR_zero_page_2()
 void CPU::EOR_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_zero_page_x_2;
+	SET_NEXT(EOR_zero_page_x_2);
 }
 void CPU::EOR_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::EOR_zero_page_x_3;
+	SET_NEXT(EOR_zero_page_x_3);
 }
 void CPU::EOR_zero_page_x_3()
 {
@@ -2179,20 +2180,20 @@ void CPU::EOR_zero_page_x_3()
 void CPU::EOR_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_absolute_x_2;
+	SET_NEXT(EOR_absolute_x_2);
 }
 void CPU::EOR_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::EOR_absolute_x_3;
+	SET_NEXT(EOR_absolute_x_3);
 }
 void CPU::EOR_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::EOR_absolute_x_4;
+		SET_NEXT(EOR_absolute_x_4);
 	} else {
 		loadA(A ^ data);
 		DONE;
@@ -2209,20 +2210,20 @@ void CPU::EOR_absolute_x_4()
 void CPU::EOR_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::EOR_absolute_y_2;
+	SET_NEXT(EOR_absolute_y_2);
 }
 void CPU::EOR_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::EOR_absolute_y_3;
+	SET_NEXT(EOR_absolute_y_3);
 }
 void CPU::EOR_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::EOR_absolute_y_4;
+		SET_NEXT(EOR_absolute_y_4);
 	} else {
 		loadA(A ^ data);
 		DONE;
@@ -2239,23 +2240,23 @@ void CPU::EOR_absolute_y_4()
 void CPU::EOR_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::EOR_indirect_x_2;
+	SET_NEXT(EOR_indirect_x_2);
 }
 void CPU::EOR_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::EOR_indirect_x_3;
+	SET_NEXT(EOR_indirect_x_3);
 }
 void CPU::EOR_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::EOR_indirect_x_4;
+	SET_NEXT(EOR_indirect_x_4);
 }
 void CPU::EOR_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::EOR_indirect_x_5;
+	SET_NEXT(EOR_indirect_x_5);
 }
 void CPU::EOR_indirect_x_5()
 {
@@ -2268,25 +2269,25 @@ void CPU::EOR_indirect_x_5()
 void CPU::EOR_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::EOR_indirect_y_2;
+	SET_NEXT(EOR_indirect_y_2);
 }
 void CPU::EOR_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::EOR_indirect_y_3;
+	SET_NEXT(EOR_indirect_y_3);
 }
 void CPU::EOR_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::EOR_indirect_y_4;
+	SET_NEXT(EOR_indirect_y_4);
 }
 void CPU::EOR_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::EOR_indirect_y_5;
+		SET_NEXT(EOR_indirect_y_5);
 	} else {
 		loadA(A ^ data);
 		DONE;
@@ -2315,18 +2316,18 @@ void CPU::EOR_indirect_y_5()
 void CPU::INC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_zero_page_2;
+	SET_NEXT(INC_zero_page_2);
 }
 void CPU::INC_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::INC_zero_page_3;
+	SET_NEXT(INC_zero_page_3);
 }
 void CPU::INC_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::INC_zero_page_4;
+	SET_NEXT(INC_zero_page_4);
 }
 void CPU::INC_zero_page_4()
 {
@@ -2338,24 +2339,24 @@ void CPU::INC_zero_page_4()
 void CPU::INC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_zero_page_x_2;
+	SET_NEXT(INC_zero_page_x_2);
 }
 void CPU::INC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::INC_zero_page_x_3;
+	SET_NEXT(INC_zero_page_x_3);
 }
 void CPU::INC_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::INC_zero_page_x_4;
+	SET_NEXT(INC_zero_page_x_4);
 }
 void CPU::INC_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::INC_zero_page_x_5;
+	SET_NEXT(INC_zero_page_x_5);
 }
 void CPU::INC_zero_page_x_5()
 {
@@ -2367,23 +2368,23 @@ void CPU::INC_zero_page_x_5()
 void CPU::INC_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_absolute_2;
+	SET_NEXT(INC_absolute_2);
 }
 void CPU::INC_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::INC_absolute_3;
+	SET_NEXT(INC_absolute_3);
 }
 void CPU::INC_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::INC_absolute_4;
+	SET_NEXT(INC_absolute_4);
 }
 void CPU::INC_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::INC_absolute_5;
+	SET_NEXT(INC_absolute_5);
 }
 void CPU::INC_absolute_5()
 {
@@ -2395,13 +2396,13 @@ void CPU::INC_absolute_5()
 void CPU::INC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::INC_absolute_x_2;
+	SET_NEXT(INC_absolute_x_2);
 }
 void CPU::INC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::INC_absolute_x_3;
+	SET_NEXT(INC_absolute_x_3);
 }
 void CPU::INC_absolute_x_3()
 {
@@ -2409,18 +2410,18 @@ void CPU::INC_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::INC_absolute_x_4;
+	SET_NEXT(INC_absolute_x_4);
 }
 void CPU::INC_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::INC_absolute_x_5;
+	SET_NEXT(INC_absolute_x_5);
 }
 void CPU::INC_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::INC_absolute_x_6;
+	SET_NEXT(INC_absolute_x_6);
 }
 void CPU::INC_absolute_x_6()
 {
@@ -2432,34 +2433,34 @@ void CPU::INC_absolute_x_6()
 void CPU::INC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::INC_indirect_x_2;
+	SET_NEXT(INC_indirect_x_2);
 }
 void CPU::INC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::INC_indirect_x_3;
+	SET_NEXT(INC_indirect_x_3);
 }
 void CPU::INC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::INC_indirect_x_4;
+	SET_NEXT(INC_indirect_x_4);
 }
 void CPU::INC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::INC_indirect_x_5;
+	SET_NEXT(INC_indirect_x_5);
 }
 void CPU::INC_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::INC_indirect_x_6;
+	SET_NEXT(INC_indirect_x_6);
 }
 void CPU::INC_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::INC_indirect_x_7;
+	SET_NEXT(INC_indirect_x_7);
 }
 void CPU::INC_indirect_x_7()
 {
@@ -2514,7 +2515,7 @@ void CPU::INY()
 void CPU::JMP_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::JMP_absolute_2;
+	SET_NEXT(JMP_absolute_2);
 }
 void CPU::JMP_absolute_2()
 {
@@ -2527,22 +2528,22 @@ void CPU::JMP_absolute_2()
 void CPU::JMP_absolute_indirect()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::JMP_absolute_indirect_2;
+	SET_NEXT(JMP_absolute_indirect_2);
 }
 void CPU::JMP_absolute_indirect_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::JMP_absolute_indirect_3;
+	SET_NEXT(JMP_absolute_indirect_3);
 }
 void CPU::JMP_absolute_indirect_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::JMP_absolute_indirect_4;
+	SET_NEXT(JMP_absolute_indirect_4);
 }
 void CPU::JMP_absolute_indirect_4()
 {
 	setPCL(data);	
-	setPCH(mem->peek(addr_lo+1, addr_hi)); 
+	setPCH(peekMem(HI_LO(addr_hi, (uint8_t)(addr_lo+1)))); 
 	DONE;
 }
 
@@ -2559,21 +2560,21 @@ void CPU::JSR()
 {
 	FETCH_ADDR_LO;
 	callStack[callStackPointer++] = PC;
-	next = &CPU::JSR_2;
+	SET_NEXT(JSR_2);
 }
 void CPU::JSR_2()
 {
-	next = &CPU::JSR_3;
+	SET_NEXT(JSR_3);
 }
 void CPU::JSR_3()
 {
 	PUSH_PCH;
-	next = &CPU::JSR_4;
+	SET_NEXT(JSR_4);
 }
 void CPU::JSR_4()
 {
 	PUSH_PCL;
-	next = &CPU::JSR_5;
+	SET_NEXT(JSR_5);
 }
 void CPU::JSR_5()
 {
@@ -2604,7 +2605,7 @@ void CPU::LDA_immediate()
 void CPU::LDA_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_zero_page_2;
+	SET_NEXT(LDA_zero_page_2);
 }
 
 void CPU::LDA_zero_page_2() 
@@ -2618,13 +2619,13 @@ void CPU::LDA_zero_page_2()
 void CPU::LDA_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_zero_page_x_2;
+	SET_NEXT(LDA_zero_page_x_2);
 }
 void CPU::LDA_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::LDA_zero_page_x_3;
+	SET_NEXT(LDA_zero_page_x_3);
 }
 void CPU::LDA_zero_page_x_3() 
 {
@@ -2637,12 +2638,12 @@ void CPU::LDA_zero_page_x_3()
 void CPU::LDA_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LDA_absolute_2; 
+	SET_NEXT(LDA_absolute_2); 
 }
 void CPU::LDA_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LDA_absolute_3; 
+	SET_NEXT(LDA_absolute_3); 
 }
 void CPU::LDA_absolute_3() 
 { 
@@ -2655,20 +2656,20 @@ void CPU::LDA_absolute_3()
 void CPU::LDA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_absolute_x_2;
+	SET_NEXT(LDA_absolute_x_2);
 }
 void CPU::LDA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LDA_absolute_x_3;
+	SET_NEXT(LDA_absolute_x_3);
 }
 void CPU::LDA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDA_absolute_x_4;
+		SET_NEXT(LDA_absolute_x_4);
 	} else {
 		loadA(data);
 		DONE;
@@ -2685,20 +2686,20 @@ void CPU::LDA_absolute_x_4()
 void CPU::LDA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDA_absolute_y_2;
+	SET_NEXT(LDA_absolute_y_2);
 }
 void CPU::LDA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LDA_absolute_y_3;
+	SET_NEXT(LDA_absolute_y_3);
 }
 void CPU::LDA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDA_absolute_y_4;
+		SET_NEXT(LDA_absolute_y_4);
 	} else {
 		loadA(data);
 		DONE;
@@ -2715,23 +2716,23 @@ void CPU::LDA_absolute_y_4()
 void CPU::LDA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDA_indirect_x_2;
+	SET_NEXT(LDA_indirect_x_2);
 }
 void CPU::LDA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LDA_indirect_x_3;
+	SET_NEXT(LDA_indirect_x_3);
 }
 void CPU::LDA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDA_indirect_x_4;
+	SET_NEXT(LDA_indirect_x_4);
 }
 void CPU::LDA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LDA_indirect_x_5;
+	SET_NEXT(LDA_indirect_x_5);
 }
 void CPU::LDA_indirect_x_5()
 {
@@ -2744,25 +2745,25 @@ void CPU::LDA_indirect_x_5()
 void CPU::LDA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDA_indirect_y_2;
+	SET_NEXT(LDA_indirect_y_2);
 }
 void CPU::LDA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDA_indirect_y_3;
+	SET_NEXT(LDA_indirect_y_3);
 }
 void CPU::LDA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LDA_indirect_y_4;
+	SET_NEXT(LDA_indirect_y_4);
 }
 void CPU::LDA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDA_indirect_y_5;
+		SET_NEXT(LDA_indirect_y_5);
 	} else {
 		loadA(data);
 		DONE;
@@ -2797,7 +2798,7 @@ void CPU::LDX_immediate()
 void CPU::LDX_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDX_zero_page_2;
+	SET_NEXT(LDX_zero_page_2);
 }
 
 void CPU::LDX_zero_page_2() 
@@ -2811,13 +2812,13 @@ void CPU::LDX_zero_page_2()
 void CPU::LDX_zero_page_y() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDX_zero_page_y_2;
+	SET_NEXT(LDX_zero_page_y_2);
 }
 void CPU::LDX_zero_page_y_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::LDX_zero_page_y_3;
+	SET_NEXT(LDX_zero_page_y_3);
 }
 void CPU::LDX_zero_page_y_3() 
 {
@@ -2830,12 +2831,12 @@ void CPU::LDX_zero_page_y_3()
 void CPU::LDX_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LDX_absolute_2; 
+	SET_NEXT(LDX_absolute_2); 
 }
 void CPU::LDX_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LDX_absolute_3; 
+	SET_NEXT(LDX_absolute_3); 
 }
 void CPU::LDX_absolute_3() 
 { 
@@ -2848,20 +2849,20 @@ void CPU::LDX_absolute_3()
 void CPU::LDX_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDX_absolute_y_2;
+	SET_NEXT(LDX_absolute_y_2);
 }
 void CPU::LDX_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LDX_absolute_y_3;
+	SET_NEXT(LDX_absolute_y_3);
 }
 void CPU::LDX_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDX_absolute_y_4;
+		SET_NEXT(LDX_absolute_y_4);
 	} else {
 		loadX(data);
 		DONE;
@@ -2878,23 +2879,23 @@ void CPU::LDX_absolute_y_4()
 void CPU::LDX_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDX_indirect_x_2;
+	SET_NEXT(LDX_indirect_x_2);
 }
 void CPU::LDX_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LDX_indirect_x_3;
+	SET_NEXT(LDX_indirect_x_3);
 }
 void CPU::LDX_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDX_indirect_x_4;
+	SET_NEXT(LDX_indirect_x_4);
 }
 void CPU::LDX_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LDX_indirect_x_5;
+	SET_NEXT(LDX_indirect_x_5);
 }
 void CPU::LDX_indirect_x_5()
 {
@@ -2907,25 +2908,25 @@ void CPU::LDX_indirect_x_5()
 void CPU::LDX_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDX_indirect_y_2;
+	SET_NEXT(LDX_indirect_y_2);
 }
 void CPU::LDX_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDX_indirect_y_3;
+	SET_NEXT(LDX_indirect_y_3);
 }
 void CPU::LDX_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LDX_indirect_y_4;
+	SET_NEXT(LDX_indirect_y_4);
 }
 void CPU::LDX_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDX_indirect_y_5;
+		SET_NEXT(LDX_indirect_y_5);
 	} else {
 		loadX(data);
 		DONE;
@@ -2960,7 +2961,7 @@ void CPU::LDY_immediate()
 void CPU::LDY_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDY_zero_page_2;
+	SET_NEXT(LDY_zero_page_2);
 }
 
 void CPU::LDY_zero_page_2() 
@@ -2974,13 +2975,13 @@ void CPU::LDY_zero_page_2()
 void CPU::LDY_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDY_zero_page_x_2;
+	SET_NEXT(LDY_zero_page_x_2);
 }
 void CPU::LDY_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::LDY_zero_page_x_3;
+	SET_NEXT(LDY_zero_page_x_3);
 }
 void CPU::LDY_zero_page_x_3() 
 {
@@ -2993,12 +2994,12 @@ void CPU::LDY_zero_page_x_3()
 void CPU::LDY_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LDY_absolute_2; 
+	SET_NEXT(LDY_absolute_2); 
 }
 void CPU::LDY_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LDY_absolute_3; 
+	SET_NEXT(LDY_absolute_3); 
 }
 void CPU::LDY_absolute_3() 
 { 
@@ -3011,20 +3012,20 @@ void CPU::LDY_absolute_3()
 void CPU::LDY_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LDY_absolute_x_2;
+	SET_NEXT(LDY_absolute_x_2);
 }
 void CPU::LDY_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LDY_absolute_x_3;
+	SET_NEXT(LDY_absolute_x_3);
 }
 void CPU::LDY_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDY_absolute_x_4;
+		SET_NEXT(LDY_absolute_x_4);
 	} else {
 		loadY(data);
 		DONE;
@@ -3041,23 +3042,23 @@ void CPU::LDY_absolute_x_4()
 void CPU::LDY_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDY_indirect_x_2;
+	SET_NEXT(LDY_indirect_x_2);
 }
 void CPU::LDY_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LDY_indirect_x_3;
+	SET_NEXT(LDY_indirect_x_3);
 }
 void CPU::LDY_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDY_indirect_x_4;
+	SET_NEXT(LDY_indirect_x_4);
 }
 void CPU::LDY_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LDY_indirect_x_5;
+	SET_NEXT(LDY_indirect_x_5);
 }
 void CPU::LDY_indirect_x_5()
 {
@@ -3070,25 +3071,25 @@ void CPU::LDY_indirect_x_5()
 void CPU::LDY_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LDY_indirect_y_2;
+	SET_NEXT(LDY_indirect_y_2);
 }
 void CPU::LDY_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LDY_indirect_y_3;
+	SET_NEXT(LDY_indirect_y_3);
 }
 void CPU::LDY_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LDY_indirect_y_4;
+	SET_NEXT(LDY_indirect_y_4);
 }
 void CPU::LDY_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LDY_indirect_y_5;
+		SET_NEXT(LDY_indirect_y_5);
 	} else {
 		loadY(data);
 		DONE;
@@ -3125,18 +3126,18 @@ void CPU::LSR_accumulator()
 void CPU::LSR_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_zero_page_2;
+	SET_NEXT(LSR_zero_page_2);
 }
 void CPU::LSR_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::LSR_zero_page_3;
+	SET_NEXT(LSR_zero_page_3);
 }
 void CPU::LSR_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_LSR;
-	next = &CPU::LSR_zero_page_4;
+	SET_NEXT(LSR_zero_page_4);
 }
 void CPU::LSR_zero_page_4()
 {
@@ -3148,24 +3149,24 @@ void CPU::LSR_zero_page_4()
 void CPU::LSR_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_zero_page_x_2;
+	SET_NEXT(LSR_zero_page_x_2);
 }
 void CPU::LSR_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::LSR_zero_page_x_3;
+	SET_NEXT(LSR_zero_page_x_3);
 }
 void CPU::LSR_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::LSR_zero_page_x_4;
+	SET_NEXT(LSR_zero_page_x_4);
 }
 void CPU::LSR_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_LSR;
-	next = &CPU::LSR_zero_page_x_5;
+	SET_NEXT(LSR_zero_page_x_5);
 }
 void CPU::LSR_zero_page_x_5()
 {
@@ -3177,23 +3178,23 @@ void CPU::LSR_zero_page_x_5()
 void CPU::LSR_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_absolute_2;
+	SET_NEXT(LSR_absolute_2);
 }
 void CPU::LSR_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::LSR_absolute_3;
+	SET_NEXT(LSR_absolute_3);
 }
 void CPU::LSR_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_absolute_4;
+	SET_NEXT(LSR_absolute_4);
 }
 void CPU::LSR_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_absolute_5;
+	SET_NEXT(LSR_absolute_5);
 }
 void CPU::LSR_absolute_5()
 {
@@ -3205,13 +3206,13 @@ void CPU::LSR_absolute_5()
 void CPU::LSR_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_absolute_x_2;
+	SET_NEXT(LSR_absolute_x_2);
 }
 void CPU::LSR_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LSR_absolute_x_3;
+	SET_NEXT(LSR_absolute_x_3);
 }
 void CPU::LSR_absolute_x_3()
 {
@@ -3219,18 +3220,18 @@ void CPU::LSR_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::LSR_absolute_x_4;
+	SET_NEXT(LSR_absolute_x_4);
 }
 void CPU::LSR_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_absolute_x_5;
+	SET_NEXT(LSR_absolute_x_5);
 }
 void CPU::LSR_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_absolute_x_6;
+	SET_NEXT(LSR_absolute_x_6);
 }
 void CPU::LSR_absolute_x_6()
 {
@@ -3242,13 +3243,13 @@ void CPU::LSR_absolute_x_6()
 void CPU::LSR_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LSR_absolute_y_2;
+	SET_NEXT(LSR_absolute_y_2);
 }
 void CPU::LSR_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::LSR_absolute_y_3;
+	SET_NEXT(LSR_absolute_y_3);
 }
 void CPU::LSR_absolute_y_3()
 {
@@ -3256,18 +3257,18 @@ void CPU::LSR_absolute_y_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::LSR_absolute_y_4;
+	SET_NEXT(LSR_absolute_y_4);
 }
 void CPU::LSR_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_absolute_y_5;
+	SET_NEXT(LSR_absolute_y_5);
 }
 void CPU::LSR_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_absolute_y_6;
+	SET_NEXT(LSR_absolute_y_6);
 }
 void CPU::LSR_absolute_y_6()
 {
@@ -3279,34 +3280,34 @@ void CPU::LSR_absolute_y_6()
 void CPU::LSR_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LSR_indirect_x_2;
+	SET_NEXT(LSR_indirect_x_2);
 }
 void CPU::LSR_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LSR_indirect_x_3;
+	SET_NEXT(LSR_indirect_x_3);
 }
 void CPU::LSR_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LSR_indirect_x_4;
+	SET_NEXT(LSR_indirect_x_4);
 }
 void CPU::LSR_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LSR_indirect_x_5;
+	SET_NEXT(LSR_indirect_x_5);
 }
 void CPU::LSR_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_indirect_x_6;
+	SET_NEXT(LSR_indirect_x_6);
 }
 void CPU::LSR_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_indirect_x_7;
+	SET_NEXT(LSR_indirect_x_7);
 }
 void CPU::LSR_indirect_x_7()
 {
@@ -3318,18 +3319,18 @@ void CPU::LSR_indirect_x_7()
 void CPU::LSR_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LSR_indirect_y_2;
+	SET_NEXT(LSR_indirect_y_2);
 }
 void CPU::LSR_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LSR_indirect_y_3;
+	SET_NEXT(LSR_indirect_y_3);
 }
 void CPU::LSR_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LSR_indirect_y_4;
+	SET_NEXT(LSR_indirect_y_4);
 }
 void CPU::LSR_indirect_y_4()
 {
@@ -3337,18 +3338,18 @@ void CPU::LSR_indirect_y_4()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::LSR_indirect_y_5;
+	SET_NEXT(LSR_indirect_y_5);
 }
 void CPU::LSR_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::LSR_indirect_y_6;
+	SET_NEXT(LSR_indirect_y_6);
 }
 void CPU::LSR_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_LSR;
-	next = &CPU::LSR_indirect_y_7;
+	SET_NEXT(LSR_indirect_y_7);
 }
 
 void CPU::LSR_indirect_y_7()
@@ -3384,7 +3385,7 @@ void CPU::NOP_immediate()
 void CPU::NOP_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::NOP_zero_page_2;
+	SET_NEXT(NOP_zero_page_2);
 }
 
 void CPU::NOP_zero_page_2() 
@@ -3397,13 +3398,13 @@ void CPU::NOP_zero_page_2()
 void CPU::NOP_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::NOP_zero_page_x_2;
+	SET_NEXT(NOP_zero_page_x_2);
 }
 void CPU::NOP_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::NOP_zero_page_x_3;
+	SET_NEXT(NOP_zero_page_x_3);
 }
 void CPU::NOP_zero_page_x_3() 
 {
@@ -3415,12 +3416,12 @@ void CPU::NOP_zero_page_x_3()
 void CPU::NOP_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::NOP_absolute_2; 
+	SET_NEXT(NOP_absolute_2); 
 }
 void CPU::NOP_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::NOP_absolute_3; 
+	SET_NEXT(NOP_absolute_3); 
 }
 void CPU::NOP_absolute_3() 
 { 
@@ -3432,20 +3433,20 @@ void CPU::NOP_absolute_3()
 void CPU::NOP_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::NOP_absolute_x_2;
+	SET_NEXT(NOP_absolute_x_2);
 }
 void CPU::NOP_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::NOP_absolute_x_3;
+	SET_NEXT(NOP_absolute_x_3);
 }
 void CPU::NOP_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::NOP_absolute_x_4;
+		SET_NEXT(NOP_absolute_x_4);
 	} else {
 		DONE;
 	}
@@ -3476,11 +3477,11 @@ void CPU::ORA_immediate()
 // -------------------------------------------------------------------------------
 void CPU::ORA_absolute() {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_absolute_2;
+	SET_NEXT(ORA_absolute_2);
 }
 void CPU::ORA_absolute_2() {
 	FETCH_ADDR_HI;
-	next = &CPU::ORA_absolute_3;
+	SET_NEXT(ORA_absolute_3);
 }
 void CPU::ORA_absolute_3() {
 	READ_FROM_ADDRESS;
@@ -3492,7 +3493,7 @@ void CPU::ORA_absolute_3() {
 void CPU::ORA_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_zero_page_2;
+	SET_NEXT(ORA_zero_page_2);
 }
 void CPU::ORA_zero_page_2()
 {
@@ -3505,13 +3506,13 @@ void CPU::ORA_zero_page_2()
 void CPU::ORA_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_zero_page_x_2;
+	SET_NEXT(ORA_zero_page_x_2);
 }
 void CPU::ORA_zero_page_x_2()
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ORA_zero_page_x_3;
+	SET_NEXT(ORA_zero_page_x_3);
 }
 void CPU::ORA_zero_page_x_3()
 {
@@ -3524,20 +3525,20 @@ void CPU::ORA_zero_page_x_3()
 void CPU::ORA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_absolute_x_2;
+	SET_NEXT(ORA_absolute_x_2);
 }
 void CPU::ORA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ORA_absolute_x_3;
+	SET_NEXT(ORA_absolute_x_3);
 }
 void CPU::ORA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ORA_absolute_x_4;
+		SET_NEXT(ORA_absolute_x_4);
 	} else {
 		loadA(A | data);
 		DONE;
@@ -3554,20 +3555,20 @@ void CPU::ORA_absolute_x_4()
 void CPU::ORA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ORA_absolute_y_2;
+	SET_NEXT(ORA_absolute_y_2);
 }
 void CPU::ORA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::ORA_absolute_y_3;
+	SET_NEXT(ORA_absolute_y_3);
 }
 void CPU::ORA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ORA_absolute_y_4;
+		SET_NEXT(ORA_absolute_y_4);
 	} else {
 		loadA(A | data);
 		DONE;
@@ -3584,23 +3585,23 @@ void CPU::ORA_absolute_y_4()
 void CPU::ORA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ORA_indirect_x_2;
+	SET_NEXT(ORA_indirect_x_2);
 }
 void CPU::ORA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ORA_indirect_x_3;
+	SET_NEXT(ORA_indirect_x_3);
 }
 void CPU::ORA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ORA_indirect_x_4;
+	SET_NEXT(ORA_indirect_x_4);
 }
 void CPU::ORA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ORA_indirect_x_5;
+	SET_NEXT(ORA_indirect_x_5);
 }
 void CPU::ORA_indirect_x_5()
 {
@@ -3613,25 +3614,25 @@ void CPU::ORA_indirect_x_5()
 void CPU::ORA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ORA_indirect_y_2;
+	SET_NEXT(ORA_indirect_y_2);
 }
 void CPU::ORA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ORA_indirect_y_3;
+	SET_NEXT(ORA_indirect_y_3);
 }
 void CPU::ORA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::ORA_indirect_y_4;
+	SET_NEXT(ORA_indirect_y_4);
 }
 void CPU::ORA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::ORA_indirect_y_5;
+		SET_NEXT(ORA_indirect_y_5);
 	} else {
 		loadA(A | data);
 		DONE;
@@ -3657,7 +3658,7 @@ void CPU::ORA_indirect_y_5()
 void CPU::PHA()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PHA_2;
+	SET_NEXT(PHA_2);
 }
 void CPU::PHA_2()
 {
@@ -3678,7 +3679,7 @@ void CPU::PHA_2()
 void CPU::PHP()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PHP_2;
+	SET_NEXT(PHP_2);
 }
 void CPU::PHP_2()
 {
@@ -3699,12 +3700,12 @@ void CPU::PHP_2()
 void CPU::PLA()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PLA_2;
+	SET_NEXT(PLA_2);
 }
 void CPU::PLA_2()
 {
 	SP++;
-	next = &CPU::PLA_3;
+	SET_NEXT(PLA_3);
 }
 void CPU::PLA_3()
 {
@@ -3725,12 +3726,12 @@ void CPU::PLA_3()
 void CPU::PLP()
 {
 	IDLE_READ_IMPLIED;
-	next = &CPU::PLP_2;
+	SET_NEXT(PLP_2);
 }
 void CPU::PLP_2()
 {
 	SP++;
-	next = &CPU::PLP_3;
+	SET_NEXT(PLP_3);
 }
 void CPU::PLP_3()
 {
@@ -3778,18 +3779,18 @@ void CPU::ROL_accumulator()
 void CPU::ROL_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_zero_page_2;
+	SET_NEXT(ROL_zero_page_2);
 }
 void CPU::ROL_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROL_zero_page_3;
+	SET_NEXT(ROL_zero_page_3);
 }
 void CPU::ROL_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::ROL_zero_page_4;
+	SET_NEXT(ROL_zero_page_4);
 }
 void CPU::ROL_zero_page_4()
 {
@@ -3801,24 +3802,24 @@ void CPU::ROL_zero_page_4()
 void CPU::ROL_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_zero_page_x_2;
+	SET_NEXT(ROL_zero_page_x_2);
 }
 void CPU::ROL_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ROL_zero_page_x_3;
+	SET_NEXT(ROL_zero_page_x_3);
 }
 void CPU::ROL_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROL_zero_page_x_4;
+	SET_NEXT(ROL_zero_page_x_4);
 }
 void CPU::ROL_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::ROL_zero_page_x_5;
+	SET_NEXT(ROL_zero_page_x_5);
 }
 void CPU::ROL_zero_page_x_5()
 {
@@ -3830,23 +3831,23 @@ void CPU::ROL_zero_page_x_5()
 void CPU::ROL_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_absolute_2;
+	SET_NEXT(ROL_absolute_2);
 }
 void CPU::ROL_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ROL_absolute_3;
+	SET_NEXT(ROL_absolute_3);
 }
 void CPU::ROL_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROL_absolute_4;
+	SET_NEXT(ROL_absolute_4);
 }
 void CPU::ROL_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::ROL_absolute_5;
+	SET_NEXT(ROL_absolute_5);
 }
 void CPU::ROL_absolute_5()
 {
@@ -3858,13 +3859,13 @@ void CPU::ROL_absolute_5()
 void CPU::ROL_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROL_absolute_x_2;
+	SET_NEXT(ROL_absolute_x_2);
 }
 void CPU::ROL_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ROL_absolute_x_3;
+	SET_NEXT(ROL_absolute_x_3);
 }
 void CPU::ROL_absolute_x_3()
 {
@@ -3872,18 +3873,18 @@ void CPU::ROL_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ROL_absolute_x_4;
+	SET_NEXT(ROL_absolute_x_4);
 }
 void CPU::ROL_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROL_absolute_x_5;
+	SET_NEXT(ROL_absolute_x_5);
 }
 void CPU::ROL_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::ROL_absolute_x_6;
+	SET_NEXT(ROL_absolute_x_6);
 }
 void CPU::ROL_absolute_x_6()
 {
@@ -3895,34 +3896,34 @@ void CPU::ROL_absolute_x_6()
 void CPU::ROL_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ROL_indirect_x_2;
+	SET_NEXT(ROL_indirect_x_2);
 }
 void CPU::ROL_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ROL_indirect_x_3;
+	SET_NEXT(ROL_indirect_x_3);
 }
 void CPU::ROL_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ROL_indirect_x_4;
+	SET_NEXT(ROL_indirect_x_4);
 }
 void CPU::ROL_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ROL_indirect_x_5;
+	SET_NEXT(ROL_indirect_x_5);
 }
 void CPU::ROL_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROL_indirect_x_6;
+	SET_NEXT(ROL_indirect_x_6);
 }
 void CPU::ROL_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::ROL_indirect_x_7;
+	SET_NEXT(ROL_indirect_x_7);
 }
 void CPU::ROL_indirect_x_7()
 {
@@ -3970,18 +3971,18 @@ void CPU::ROR_accumulator()
 void CPU::ROR_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_zero_page_2;
+	SET_NEXT(ROR_zero_page_2);
 }
 void CPU::ROR_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROR_zero_page_3;
+	SET_NEXT(ROR_zero_page_3);
 }
 void CPU::ROR_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::ROR_zero_page_4;
+	SET_NEXT(ROR_zero_page_4);
 }
 void CPU::ROR_zero_page_4()
 {
@@ -3993,24 +3994,24 @@ void CPU::ROR_zero_page_4()
 void CPU::ROR_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_zero_page_x_2;
+	SET_NEXT(ROR_zero_page_x_2);
 }
 void CPU::ROR_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ROR_zero_page_x_3;
+	SET_NEXT(ROR_zero_page_x_3);
 }
 void CPU::ROR_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ROR_zero_page_x_4;
+	SET_NEXT(ROR_zero_page_x_4);
 }
 void CPU::ROR_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::ROR_zero_page_x_5;
+	SET_NEXT(ROR_zero_page_x_5);
 }
 void CPU::ROR_zero_page_x_5()
 {
@@ -4022,23 +4023,23 @@ void CPU::ROR_zero_page_x_5()
 void CPU::ROR_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_absolute_2;
+	SET_NEXT(ROR_absolute_2);
 }
 void CPU::ROR_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ROR_absolute_3;
+	SET_NEXT(ROR_absolute_3);
 }
 void CPU::ROR_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROR_absolute_4;
+	SET_NEXT(ROR_absolute_4);
 }
 void CPU::ROR_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::ROR_absolute_5;
+	SET_NEXT(ROR_absolute_5);
 }
 void CPU::ROR_absolute_5()
 {
@@ -4050,13 +4051,13 @@ void CPU::ROR_absolute_5()
 void CPU::ROR_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ROR_absolute_x_2;
+	SET_NEXT(ROR_absolute_x_2);
 }
 void CPU::ROR_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ROR_absolute_x_3;
+	SET_NEXT(ROR_absolute_x_3);
 }
 void CPU::ROR_absolute_x_3()
 {
@@ -4064,18 +4065,18 @@ void CPU::ROR_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ROR_absolute_x_4;
+	SET_NEXT(ROR_absolute_x_4);
 }
 void CPU::ROR_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROR_absolute_x_5;
+	SET_NEXT(ROR_absolute_x_5);
 }
 void CPU::ROR_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::ROR_absolute_x_6;
+	SET_NEXT(ROR_absolute_x_6);
 }
 void CPU::ROR_absolute_x_6()
 {
@@ -4087,34 +4088,34 @@ void CPU::ROR_absolute_x_6()
 void CPU::ROR_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ROR_indirect_x_2;
+	SET_NEXT(ROR_indirect_x_2);
 }
 void CPU::ROR_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ROR_indirect_x_3;
+	SET_NEXT(ROR_indirect_x_3);
 }
 void CPU::ROR_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ROR_indirect_x_4;
+	SET_NEXT(ROR_indirect_x_4);
 }
 void CPU::ROR_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ROR_indirect_x_5;
+	SET_NEXT(ROR_indirect_x_5);
 }
 void CPU::ROR_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ROR_indirect_x_6;
+	SET_NEXT(ROR_indirect_x_6);
 }
 void CPU::ROR_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::ROR_indirect_x_7;
+	SET_NEXT(ROR_indirect_x_7);
 }
 void CPU::ROR_indirect_x_7()
 {
@@ -4135,24 +4136,24 @@ void CPU::ROR_indirect_x_7()
 void CPU::RTI()
 {
 	IDLE_READ_IMMEDIATE;
-	next = &CPU::RTI_2;
+	SET_NEXT(RTI_2);
 }
 void CPU::RTI_2()
 {
 	SP++;
-	next = &CPU::RTI_3;
+	SET_NEXT(RTI_3);
 }
 void CPU::RTI_3()
 {
 	PULL_P;
 	SP++;
-	next = &CPU::RTI_4;
+	SET_NEXT(RTI_4);
 }
 void CPU::RTI_4()
 {
 	PULL_PCL;
 	SP++;
-	next = &CPU::RTI_5;
+	SET_NEXT(RTI_5);
 }
 void CPU::RTI_5()
 {
@@ -4172,23 +4173,23 @@ void CPU::RTI_5()
 void CPU::RTS()
 {
 	IDLE_READ_IMMEDIATE;
-	next = &CPU::RTS_2;
+	SET_NEXT(RTS_2);
 }
 void CPU::RTS_2()
 {
 	IDLE_READ_IMMEDIATE_SP; // SP++;
-	next = &CPU::RTS_3;
+	SET_NEXT(RTS_3);
 }
 void CPU::RTS_3()
 {
 	PULL_PCL;
 	SP++;
-	next = &CPU::RTS_4;
+	SET_NEXT(RTS_4);
 }
 void CPU::RTS_4()
 {
 	PULL_PCH;
-	next = &CPU::RTS_5;
+	SET_NEXT(RTS_5);
 }
 void CPU::RTS_5()
 {
@@ -4260,7 +4261,7 @@ void CPU::SBC_immediate()
 void CPU::SBC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_zero_page_2;
+	SET_NEXT(SBC_zero_page_2);
 }
 
 void CPU::SBC_zero_page_2() 
@@ -4274,13 +4275,13 @@ void CPU::SBC_zero_page_2()
 void CPU::SBC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_zero_page_x_2;
+	SET_NEXT(SBC_zero_page_x_2);
 }
 void CPU::SBC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::SBC_zero_page_x_3;
+	SET_NEXT(SBC_zero_page_x_3);
 }
 void CPU::SBC_zero_page_x_3() 
 {
@@ -4293,12 +4294,12 @@ void CPU::SBC_zero_page_x_3()
 void CPU::SBC_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::SBC_absolute_2; 
+	SET_NEXT(SBC_absolute_2); 
 }
 void CPU::SBC_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::SBC_absolute_3; 
+	SET_NEXT(SBC_absolute_3); 
 }
 void CPU::SBC_absolute_3() 
 { 
@@ -4311,20 +4312,20 @@ void CPU::SBC_absolute_3()
 void CPU::SBC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_absolute_x_2;
+	SET_NEXT(SBC_absolute_x_2);
 }
 void CPU::SBC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SBC_absolute_x_3;
+	SET_NEXT(SBC_absolute_x_3);
 }
 void CPU::SBC_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::SBC_absolute_x_4;
+		SET_NEXT(SBC_absolute_x_4);
 	} else {
 		sbc(data);
 		DONE;
@@ -4341,20 +4342,20 @@ void CPU::SBC_absolute_x_4()
 void CPU::SBC_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SBC_absolute_y_2;
+	SET_NEXT(SBC_absolute_y_2);
 }
 void CPU::SBC_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SBC_absolute_y_3;
+	SET_NEXT(SBC_absolute_y_3);
 }
 void CPU::SBC_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::SBC_absolute_y_4;
+		SET_NEXT(SBC_absolute_y_4);
 	} else {
 		sbc(data);
 		DONE;
@@ -4371,23 +4372,23 @@ void CPU::SBC_absolute_y_4()
 void CPU::SBC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SBC_indirect_x_2;
+	SET_NEXT(SBC_indirect_x_2);
 }
 void CPU::SBC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SBC_indirect_x_3;
+	SET_NEXT(SBC_indirect_x_3);
 }
 void CPU::SBC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SBC_indirect_x_4;
+	SET_NEXT(SBC_indirect_x_4);
 }
 void CPU::SBC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SBC_indirect_x_5;
+	SET_NEXT(SBC_indirect_x_5);
 }
 void CPU::SBC_indirect_x_5()
 {
@@ -4400,25 +4401,25 @@ void CPU::SBC_indirect_x_5()
 void CPU::SBC_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SBC_indirect_y_2;
+	SET_NEXT(SBC_indirect_y_2);
 }
 void CPU::SBC_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SBC_indirect_y_3;
+	SET_NEXT(SBC_indirect_y_3);
 }
 void CPU::SBC_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SBC_indirect_y_4;
+	SET_NEXT(SBC_indirect_y_4);
 }
 void CPU::SBC_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::SBC_indirect_y_5;
+		SET_NEXT(SBC_indirect_y_5);
 	} else {
 		sbc(data);
 		DONE;
@@ -4497,7 +4498,7 @@ void CPU::SEI()
 void CPU::STA_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_zero_page_2;
+	SET_NEXT(STA_zero_page_2);
 }
 void CPU::STA_zero_page_2()
 {
@@ -4510,13 +4511,13 @@ void CPU::STA_zero_page_2()
 void CPU::STA_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_zero_page_x_2;
+	SET_NEXT(STA_zero_page_x_2);
 }
 void CPU::STA_zero_page_x_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::STA_zero_page_x_3;
+	SET_NEXT(STA_zero_page_x_3);
 }	
 void CPU::STA_zero_page_x_3()
 {
@@ -4529,12 +4530,12 @@ void CPU::STA_zero_page_x_3()
 void CPU::STA_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_absolute_2;
+	SET_NEXT(STA_absolute_2);
 }
 void CPU::STA_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::STA_absolute_3;
+	SET_NEXT(STA_absolute_3);
 }
 void CPU::STA_absolute_3()
 {
@@ -4547,20 +4548,20 @@ void CPU::STA_absolute_3()
 void CPU::STA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_absolute_x_2;
+	SET_NEXT(STA_absolute_x_2);
 }
 void CPU::STA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::STA_absolute_x_3;
+	SET_NEXT(STA_absolute_x_3);
 }
 void CPU::STA_absolute_x_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::STA_absolute_x_4;
+	SET_NEXT(STA_absolute_x_4);
 }
 void CPU::STA_absolute_x_4()
 {
@@ -4573,20 +4574,20 @@ void CPU::STA_absolute_x_4()
 void CPU::STA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STA_absolute_y_2;
+	SET_NEXT(STA_absolute_y_2);
 }
 void CPU::STA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::STA_absolute_y_3;
+	SET_NEXT(STA_absolute_y_3);
 }
 void CPU::STA_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::STA_absolute_y_4;
+	SET_NEXT(STA_absolute_y_4);
 }
 void CPU::STA_absolute_y_4()
 {
@@ -4599,23 +4600,23 @@ void CPU::STA_absolute_y_4()
 void CPU::STA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::STA_indirect_x_2;
+	SET_NEXT(STA_indirect_x_2);
 }
 void CPU::STA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::STA_indirect_x_3;
+	SET_NEXT(STA_indirect_x_3);
 }
 void CPU::STA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::STA_indirect_x_4;
+	SET_NEXT(STA_indirect_x_4);
 }
 void CPU::STA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::STA_indirect_x_5;
+	SET_NEXT(STA_indirect_x_5);
 }
 void CPU::STA_indirect_x_5()
 {
@@ -4628,25 +4629,25 @@ void CPU::STA_indirect_x_5()
 void CPU::STA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::STA_indirect_y_2;
+	SET_NEXT(STA_indirect_y_2);
 }
 void CPU::STA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::STA_indirect_y_3;
+	SET_NEXT(STA_indirect_y_3);
 }
 void CPU::STA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::STA_indirect_y_4;
+	SET_NEXT(STA_indirect_y_4);
 }
 void CPU::STA_indirect_y_4()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::STA_indirect_y_5;
+	SET_NEXT(STA_indirect_y_5);
 }
 void CPU::STA_indirect_y_5()
 {
@@ -4668,7 +4669,7 @@ void CPU::STA_indirect_y_5()
 void CPU::STX_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STX_zero_page_2;
+	SET_NEXT(STX_zero_page_2);
 }
 void CPU::STX_zero_page_2()
 {
@@ -4681,13 +4682,13 @@ void CPU::STX_zero_page_2()
 void CPU::STX_zero_page_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STX_zero_page_y_2;
+	SET_NEXT(STX_zero_page_y_2);
 }
 void CPU::STX_zero_page_y_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::STX_zero_page_y_3;
+	SET_NEXT(STX_zero_page_y_3);
 }	
 void CPU::STX_zero_page_y_3()
 {
@@ -4700,12 +4701,12 @@ void CPU::STX_zero_page_y_3()
 void CPU::STX_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STX_absolute_2;
+	SET_NEXT(STX_absolute_2);
 }
 void CPU::STX_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::STX_absolute_3;
+	SET_NEXT(STX_absolute_3);
 }
 void CPU::STX_absolute_3()
 {
@@ -4727,7 +4728,7 @@ void CPU::STX_absolute_3()
 void CPU::STY_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STY_zero_page_2;
+	SET_NEXT(STY_zero_page_2);
 }
 void CPU::STY_zero_page_2()
 {
@@ -4740,13 +4741,13 @@ void CPU::STY_zero_page_2()
 void CPU::STY_zero_page_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STY_zero_page_x_2;
+	SET_NEXT(STY_zero_page_x_2);
 }
 void CPU::STY_zero_page_x_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::STY_zero_page_x_3;
+	SET_NEXT(STY_zero_page_x_3);
 }	
 void CPU::STY_zero_page_x_3()
 {
@@ -4759,12 +4760,12 @@ void CPU::STY_zero_page_x_3()
 void CPU::STY_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::STY_absolute_2;
+	SET_NEXT(STY_absolute_2);
 }
 void CPU::STY_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::STY_absolute_3;
+	SET_NEXT(STY_absolute_3);
 }
 void CPU::STY_absolute_3()
 {
@@ -4993,18 +4994,18 @@ void CPU::AXS_immediate()
 void CPU::DCP_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_zero_page_2;
+	SET_NEXT(DCP_zero_page_2);
 }
 void CPU::DCP_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DCP_zero_page_3;
+	SET_NEXT(DCP_zero_page_3);
 }
 void CPU::DCP_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DCP_zero_page_4;
+	SET_NEXT(DCP_zero_page_4);
 }
 void CPU::DCP_zero_page_4()
 {
@@ -5017,24 +5018,24 @@ void CPU::DCP_zero_page_4()
 void CPU::DCP_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_zero_page_x_2;
+	SET_NEXT(DCP_zero_page_x_2);
 }
 void CPU::DCP_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::DCP_zero_page_x_3;
+	SET_NEXT(DCP_zero_page_x_3);
 }
 void CPU::DCP_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::DCP_zero_page_x_4;
+	SET_NEXT(DCP_zero_page_x_4);
 }
 void CPU::DCP_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_DEC;
-	next = &CPU::DCP_zero_page_x_5;
+	SET_NEXT(DCP_zero_page_x_5);
 }
 void CPU::DCP_zero_page_x_5()
 {
@@ -5047,23 +5048,23 @@ void CPU::DCP_zero_page_x_5()
 void CPU::DCP_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_absolute_2;
+	SET_NEXT(DCP_absolute_2);
 }
 void CPU::DCP_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::DCP_absolute_3;
+	SET_NEXT(DCP_absolute_3);
 }
 void CPU::DCP_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_absolute_4;
+	SET_NEXT(DCP_absolute_4);
 }
 void CPU::DCP_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_absolute_5;
+	SET_NEXT(DCP_absolute_5);
 }
 void CPU::DCP_absolute_5()
 {
@@ -5076,13 +5077,13 @@ void CPU::DCP_absolute_5()
 void CPU::DCP_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_absolute_x_2;
+	SET_NEXT(DCP_absolute_x_2);
 }
 void CPU::DCP_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::DCP_absolute_x_3;
+	SET_NEXT(DCP_absolute_x_3);
 }
 void CPU::DCP_absolute_x_3()
 {
@@ -5090,18 +5091,18 @@ void CPU::DCP_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DCP_absolute_x_4;
+	SET_NEXT(DCP_absolute_x_4);
 }
 void CPU::DCP_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_absolute_x_5;
+	SET_NEXT(DCP_absolute_x_5);
 }
 void CPU::DCP_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_absolute_x_6;
+	SET_NEXT(DCP_absolute_x_6);
 }
 void CPU::DCP_absolute_x_6()
 {
@@ -5114,13 +5115,13 @@ void CPU::DCP_absolute_x_6()
 void CPU::DCP_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::DCP_absolute_y_2;
+	SET_NEXT(DCP_absolute_y_2);
 }
 void CPU::DCP_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::DCP_absolute_y_3;
+	SET_NEXT(DCP_absolute_y_3);
 }
 void CPU::DCP_absolute_y_3()
 {
@@ -5128,18 +5129,18 @@ void CPU::DCP_absolute_y_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DCP_absolute_y_4;
+	SET_NEXT(DCP_absolute_y_4);
 }
 void CPU::DCP_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_absolute_y_5;
+	SET_NEXT(DCP_absolute_y_5);
 }
 void CPU::DCP_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_absolute_y_6;
+	SET_NEXT(DCP_absolute_y_6);
 }
 void CPU::DCP_absolute_y_6()
 {
@@ -5152,34 +5153,34 @@ void CPU::DCP_absolute_y_6()
 void CPU::DCP_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::DCP_indirect_x_2;
+	SET_NEXT(DCP_indirect_x_2);
 }
 void CPU::DCP_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::DCP_indirect_x_3;
+	SET_NEXT(DCP_indirect_x_3);
 }
 void CPU::DCP_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::DCP_indirect_x_4;
+	SET_NEXT(DCP_indirect_x_4);
 }
 void CPU::DCP_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::DCP_indirect_x_5;
+	SET_NEXT(DCP_indirect_x_5);
 }
 void CPU::DCP_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_indirect_x_6;
+	SET_NEXT(DCP_indirect_x_6);
 }
 void CPU::DCP_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_indirect_x_7;
+	SET_NEXT(DCP_indirect_x_7);
 }
 void CPU::DCP_indirect_x_7()
 {
@@ -5192,18 +5193,18 @@ void CPU::DCP_indirect_x_7()
 void CPU::DCP_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::DCP_indirect_y_2;
+	SET_NEXT(DCP_indirect_y_2);
 }
 void CPU::DCP_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::DCP_indirect_y_3;
+	SET_NEXT(DCP_indirect_y_3);
 }
 void CPU::DCP_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::DCP_indirect_y_4;
+	SET_NEXT(DCP_indirect_y_4);
 }
 void CPU::DCP_indirect_y_4()
 {
@@ -5211,18 +5212,18 @@ void CPU::DCP_indirect_y_4()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::DCP_indirect_y_5;
+	SET_NEXT(DCP_indirect_y_5);
 }
 void CPU::DCP_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::DCP_indirect_y_6;
+	SET_NEXT(DCP_indirect_y_6);
 }
 void CPU::DCP_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_DEC;
-	next = &CPU::DCP_indirect_y_7;
+	SET_NEXT(DCP_indirect_y_7);
 }
 
 void CPU::DCP_indirect_y_7()
@@ -5245,18 +5246,18 @@ void CPU::DCP_indirect_y_7()
 void CPU::ISC_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_zero_page_2;
+	SET_NEXT(ISC_zero_page_2);
 }
 void CPU::ISC_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ISC_zero_page_3;
+	SET_NEXT(ISC_zero_page_3);
 }
 void CPU::ISC_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::ISC_zero_page_4;
+	SET_NEXT(ISC_zero_page_4);
 }
 void CPU::ISC_zero_page_4()
 {
@@ -5269,24 +5270,24 @@ void CPU::ISC_zero_page_4()
 void CPU::ISC_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_zero_page_x_2;
+	SET_NEXT(ISC_zero_page_x_2);
 }
 void CPU::ISC_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::ISC_zero_page_x_3;
+	SET_NEXT(ISC_zero_page_x_3);
 }
 void CPU::ISC_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::ISC_zero_page_x_4;
+	SET_NEXT(ISC_zero_page_x_4);
 }
 void CPU::ISC_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_INC;
-	next = &CPU::ISC_zero_page_x_5;
+	SET_NEXT(ISC_zero_page_x_5);
 }
 void CPU::ISC_zero_page_x_5()
 {
@@ -5299,23 +5300,23 @@ void CPU::ISC_zero_page_x_5()
 void CPU::ISC_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_absolute_2;
+	SET_NEXT(ISC_absolute_2);
 }
 void CPU::ISC_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::ISC_absolute_3;
+	SET_NEXT(ISC_absolute_3);
 }
 void CPU::ISC_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_absolute_4;
+	SET_NEXT(ISC_absolute_4);
 }
 void CPU::ISC_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_absolute_5;
+	SET_NEXT(ISC_absolute_5);
 }
 void CPU::ISC_absolute_5()
 {
@@ -5328,13 +5329,13 @@ void CPU::ISC_absolute_5()
 void CPU::ISC_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_absolute_x_2;
+	SET_NEXT(ISC_absolute_x_2);
 }
 void CPU::ISC_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::ISC_absolute_x_3;
+	SET_NEXT(ISC_absolute_x_3);
 }
 void CPU::ISC_absolute_x_3()
 {
@@ -5342,18 +5343,18 @@ void CPU::ISC_absolute_x_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ISC_absolute_x_4;
+	SET_NEXT(ISC_absolute_x_4);
 }
 void CPU::ISC_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_absolute_x_5;
+	SET_NEXT(ISC_absolute_x_5);
 }
 void CPU::ISC_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_absolute_x_6;
+	SET_NEXT(ISC_absolute_x_6);
 }
 void CPU::ISC_absolute_x_6()
 {
@@ -5366,13 +5367,13 @@ void CPU::ISC_absolute_x_6()
 void CPU::ISC_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::ISC_absolute_y_2;
+	SET_NEXT(ISC_absolute_y_2);
 }
 void CPU::ISC_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::ISC_absolute_y_3;
+	SET_NEXT(ISC_absolute_y_3);
 }
 void CPU::ISC_absolute_y_3()
 {
@@ -5380,18 +5381,18 @@ void CPU::ISC_absolute_y_3()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ISC_absolute_y_4;
+	SET_NEXT(ISC_absolute_y_4);
 }
 void CPU::ISC_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_absolute_y_5;
+	SET_NEXT(ISC_absolute_y_5);
 }
 void CPU::ISC_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_absolute_y_6;
+	SET_NEXT(ISC_absolute_y_6);
 }
 void CPU::ISC_absolute_y_6()
 {
@@ -5404,34 +5405,34 @@ void CPU::ISC_absolute_y_6()
 void CPU::ISC_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ISC_indirect_x_2;
+	SET_NEXT(ISC_indirect_x_2);
 }
 void CPU::ISC_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::ISC_indirect_x_3;
+	SET_NEXT(ISC_indirect_x_3);
 }
 void CPU::ISC_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ISC_indirect_x_4;
+	SET_NEXT(ISC_indirect_x_4);
 }
 void CPU::ISC_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::ISC_indirect_x_5;
+	SET_NEXT(ISC_indirect_x_5);
 }
 void CPU::ISC_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_indirect_x_6;
+	SET_NEXT(ISC_indirect_x_6);
 }
 void CPU::ISC_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_indirect_x_7;
+	SET_NEXT(ISC_indirect_x_7);
 }
 void CPU::ISC_indirect_x_7()
 {
@@ -5444,18 +5445,18 @@ void CPU::ISC_indirect_x_7()
 void CPU::ISC_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::ISC_indirect_y_2;
+	SET_NEXT(ISC_indirect_y_2);
 }
 void CPU::ISC_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::ISC_indirect_y_3;
+	SET_NEXT(ISC_indirect_y_3);
 }
 void CPU::ISC_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::ISC_indirect_y_4;
+	SET_NEXT(ISC_indirect_y_4);
 }
 void CPU::ISC_indirect_y_4()
 {
@@ -5463,18 +5464,18 @@ void CPU::ISC_indirect_y_4()
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
 	}
-	next = &CPU::ISC_indirect_y_5;
+	SET_NEXT(ISC_indirect_y_5);
 }
 void CPU::ISC_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::ISC_indirect_y_6;
+	SET_NEXT(ISC_indirect_y_6);
 }
 void CPU::ISC_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_INC;
-	next = &CPU::ISC_indirect_y_7;
+	SET_NEXT(ISC_indirect_y_7);
 }
 
 void CPU::ISC_indirect_y_7()
@@ -5497,20 +5498,20 @@ void CPU::ISC_indirect_y_7()
 void CPU::LAS_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAS_absolute_y_2;
+	SET_NEXT(LAS_absolute_y_2);
 }
 void CPU::LAS_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LAS_absolute_y_3;
+	SET_NEXT(LAS_absolute_y_3);
 }
 void CPU::LAS_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LAS_absolute_y_4;		
+		SET_NEXT(LAS_absolute_y_4);		
 	} else {
 		data &= SP;
 		SP = data;
@@ -5542,7 +5543,7 @@ void CPU::LAS_absolute_y_4()
 void CPU::LAX_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAX_zero_page_2;
+	SET_NEXT(LAX_zero_page_2);
 }
 
 void CPU::LAX_zero_page_2() 
@@ -5557,13 +5558,13 @@ void CPU::LAX_zero_page_2()
 void CPU::LAX_zero_page_y() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAX_zero_page_y_2;
+	SET_NEXT(LAX_zero_page_y_2);
 }
 void CPU::LAX_zero_page_y_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::LAX_zero_page_y_3;
+	SET_NEXT(LAX_zero_page_y_3);
 }
 void CPU::LAX_zero_page_y_3() 
 {
@@ -5577,12 +5578,12 @@ void CPU::LAX_zero_page_y_3()
 void CPU::LAX_absolute() 
 { 
 	FETCH_ADDR_LO; 
-	next = &CPU::LAX_absolute_2; 
+	SET_NEXT(LAX_absolute_2); 
 }
 void CPU::LAX_absolute_2() 
 { 
 	FETCH_ADDR_HI; 
-	next = &CPU::LAX_absolute_3; 
+	SET_NEXT(LAX_absolute_3); 
 }
 void CPU::LAX_absolute_3() 
 { 
@@ -5596,20 +5597,20 @@ void CPU::LAX_absolute_3()
 void CPU::LAX_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::LAX_absolute_y_2;
+	SET_NEXT(LAX_absolute_y_2);
 }
 void CPU::LAX_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::LAX_absolute_y_3;
+	SET_NEXT(LAX_absolute_y_3);
 }
 void CPU::LAX_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LAX_absolute_y_4;
+		SET_NEXT(LAX_absolute_y_4);
 	} else {
 		loadA(data);
 		loadX(data);
@@ -5628,23 +5629,23 @@ void CPU::LAX_absolute_y_4()
 void CPU::LAX_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LAX_indirect_x_2;
+	SET_NEXT(LAX_indirect_x_2);
 }
 void CPU::LAX_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::LAX_indirect_x_3;
+	SET_NEXT(LAX_indirect_x_3);
 }
 void CPU::LAX_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LAX_indirect_x_4;
+	SET_NEXT(LAX_indirect_x_4);
 }
 void CPU::LAX_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::LAX_indirect_x_5;
+	SET_NEXT(LAX_indirect_x_5);
 }
 void CPU::LAX_indirect_x_5()
 {
@@ -5658,25 +5659,25 @@ void CPU::LAX_indirect_x_5()
 void CPU::LAX_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::LAX_indirect_y_2;
+	SET_NEXT(LAX_indirect_y_2);
 }
 void CPU::LAX_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::LAX_indirect_y_3;
+	SET_NEXT(LAX_indirect_y_3);
 }
 void CPU::LAX_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::LAX_indirect_y_4;
+	SET_NEXT(LAX_indirect_y_4);
 }
 void CPU::LAX_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::LAX_indirect_y_5;
+		SET_NEXT(LAX_indirect_y_5);
 	} else {
 		loadA(data);
 		loadX(data);
@@ -5705,18 +5706,18 @@ void CPU::LAX_indirect_y_5()
 void CPU::RLA_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_zero_page_2;
+	SET_NEXT(RLA_zero_page_2);
 }
 void CPU::RLA_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RLA_zero_page_3;
+	SET_NEXT(RLA_zero_page_3);
 }
 void CPU::RLA_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::RLA_zero_page_4;
+	SET_NEXT(RLA_zero_page_4);
 }
 void CPU::RLA_zero_page_4()
 {
@@ -5729,24 +5730,24 @@ void CPU::RLA_zero_page_4()
 void CPU::RLA_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_zero_page_x_2;
+	SET_NEXT(RLA_zero_page_x_2);
 }
 void CPU::RLA_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::RLA_zero_page_x_3;
+	SET_NEXT(RLA_zero_page_x_3);
 }
 void CPU::RLA_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RLA_zero_page_x_4;
+	SET_NEXT(RLA_zero_page_x_4);
 }
 void CPU::RLA_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROL;
-	next = &CPU::RLA_zero_page_x_5;
+	SET_NEXT(RLA_zero_page_x_5);
 }
 void CPU::RLA_zero_page_x_5()
 {
@@ -5759,23 +5760,23 @@ void CPU::RLA_zero_page_x_5()
 void CPU::RLA_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_absolute_2;
+	SET_NEXT(RLA_absolute_2);
 }
 void CPU::RLA_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::RLA_absolute_3;
+	SET_NEXT(RLA_absolute_3);
 }
 void CPU::RLA_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_absolute_4;
+	SET_NEXT(RLA_absolute_4);
 }
 void CPU::RLA_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_absolute_5;
+	SET_NEXT(RLA_absolute_5);
 }
 void CPU::RLA_absolute_5()
 {
@@ -5788,31 +5789,31 @@ void CPU::RLA_absolute_5()
 void CPU::RLA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_absolute_x_2;
+	SET_NEXT(RLA_absolute_x_2);
 }
 void CPU::RLA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::RLA_absolute_x_3;
+	SET_NEXT(RLA_absolute_x_3);
 }
 void CPU::RLA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RLA_absolute_x_4;
+	SET_NEXT(RLA_absolute_x_4);
 }
 void CPU::RLA_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_absolute_x_5;
+	SET_NEXT(RLA_absolute_x_5);
 }
 void CPU::RLA_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_absolute_x_6;
+	SET_NEXT(RLA_absolute_x_6);
 }
 void CPU::RLA_absolute_x_6()
 {
@@ -5825,31 +5826,31 @@ void CPU::RLA_absolute_x_6()
 void CPU::RLA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RLA_absolute_y_2;
+	SET_NEXT(RLA_absolute_y_2);
 }
 void CPU::RLA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::RLA_absolute_y_3;
+	SET_NEXT(RLA_absolute_y_3);
 }
 void CPU::RLA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RLA_absolute_y_4;
+	SET_NEXT(RLA_absolute_y_4);
 }
 void CPU::RLA_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_absolute_y_5;
+	SET_NEXT(RLA_absolute_y_5);
 }
 void CPU::RLA_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_absolute_y_6;
+	SET_NEXT(RLA_absolute_y_6);
 }
 void CPU::RLA_absolute_y_6()
 {
@@ -5862,34 +5863,34 @@ void CPU::RLA_absolute_y_6()
 void CPU::RLA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RLA_indirect_x_2;
+	SET_NEXT(RLA_indirect_x_2);
 }
 void CPU::RLA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::RLA_indirect_x_3;
+	SET_NEXT(RLA_indirect_x_3);
 }
 void CPU::RLA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RLA_indirect_x_4;
+	SET_NEXT(RLA_indirect_x_4);
 }
 void CPU::RLA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::RLA_indirect_x_5;
+	SET_NEXT(RLA_indirect_x_5);
 }
 void CPU::RLA_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_indirect_x_6;
+	SET_NEXT(RLA_indirect_x_6);
 }
 void CPU::RLA_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_indirect_x_7;
+	SET_NEXT(RLA_indirect_x_7);
 }
 
 void CPU::RLA_indirect_x_7()
@@ -5903,36 +5904,36 @@ void CPU::RLA_indirect_x_7()
 void CPU::RLA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RLA_indirect_y_2;
+	SET_NEXT(RLA_indirect_y_2);
 }
 void CPU::RLA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RLA_indirect_y_3;
+	SET_NEXT(RLA_indirect_y_3);
 }
 void CPU::RLA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::RLA_indirect_y_4;
+	SET_NEXT(RLA_indirect_y_4);
 }
 void CPU::RLA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RLA_indirect_y_5;
+	SET_NEXT(RLA_indirect_y_5);
 }
 void CPU::RLA_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RLA_indirect_y_6;
+	SET_NEXT(RLA_indirect_y_6);
 }
 void CPU::RLA_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROL;
-	next = &CPU::RLA_indirect_y_7;
+	SET_NEXT(RLA_indirect_y_7);
 }
 
 void CPU::RLA_indirect_y_7()
@@ -5956,18 +5957,18 @@ void CPU::RLA_indirect_y_7()
 void CPU::RRA_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_zero_page_2;
+	SET_NEXT(RRA_zero_page_2);
 }
 void CPU::RRA_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RRA_zero_page_3;
+	SET_NEXT(RRA_zero_page_3);
 }
 void CPU::RRA_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::RRA_zero_page_4;
+	SET_NEXT(RRA_zero_page_4);
 }
 void CPU::RRA_zero_page_4()
 {
@@ -5980,24 +5981,24 @@ void CPU::RRA_zero_page_4()
 void CPU::RRA_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_zero_page_x_2;
+	SET_NEXT(RRA_zero_page_x_2);
 }
 void CPU::RRA_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::RRA_zero_page_x_3;
+	SET_NEXT(RRA_zero_page_x_3);
 }
 void CPU::RRA_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::RRA_zero_page_x_4;
+	SET_NEXT(RRA_zero_page_x_4);
 }
 void CPU::RRA_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_ROR;
-	next = &CPU::RRA_zero_page_x_5;
+	SET_NEXT(RRA_zero_page_x_5);
 }
 void CPU::RRA_zero_page_x_5()
 {
@@ -6010,23 +6011,23 @@ void CPU::RRA_zero_page_x_5()
 void CPU::RRA_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_absolute_2;
+	SET_NEXT(RRA_absolute_2);
 }
 void CPU::RRA_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::RRA_absolute_3;
+	SET_NEXT(RRA_absolute_3);
 }
 void CPU::RRA_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_absolute_4;
+	SET_NEXT(RRA_absolute_4);
 }
 void CPU::RRA_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_absolute_5;
+	SET_NEXT(RRA_absolute_5);
 }
 void CPU::RRA_absolute_5()
 {
@@ -6039,31 +6040,31 @@ void CPU::RRA_absolute_5()
 void CPU::RRA_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_absolute_x_2;
+	SET_NEXT(RRA_absolute_x_2);
 }
 void CPU::RRA_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::RRA_absolute_x_3;
+	SET_NEXT(RRA_absolute_x_3);
 }
 void CPU::RRA_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RRA_absolute_x_4;
+	SET_NEXT(RRA_absolute_x_4);
 }
 void CPU::RRA_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_absolute_x_5;
+	SET_NEXT(RRA_absolute_x_5);
 }
 void CPU::RRA_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_absolute_x_6;
+	SET_NEXT(RRA_absolute_x_6);
 }
 void CPU::RRA_absolute_x_6()
 {
@@ -6076,31 +6077,31 @@ void CPU::RRA_absolute_x_6()
 void CPU::RRA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::RRA_absolute_y_2;
+	SET_NEXT(RRA_absolute_y_2);
 }
 void CPU::RRA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::RRA_absolute_y_3;
+	SET_NEXT(RRA_absolute_y_3);
 }
 void CPU::RRA_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RRA_absolute_y_4;
+	SET_NEXT(RRA_absolute_y_4);
 }
 void CPU::RRA_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_absolute_y_5;
+	SET_NEXT(RRA_absolute_y_5);
 }
 void CPU::RRA_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_absolute_y_6;
+	SET_NEXT(RRA_absolute_y_6);
 }
 void CPU::RRA_absolute_y_6()
 {
@@ -6113,34 +6114,34 @@ void CPU::RRA_absolute_y_6()
 void CPU::RRA_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RRA_indirect_x_2;
+	SET_NEXT(RRA_indirect_x_2);
 }
 void CPU::RRA_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::RRA_indirect_x_3;
+	SET_NEXT(RRA_indirect_x_3);
 }
 void CPU::RRA_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RRA_indirect_x_4;
+	SET_NEXT(RRA_indirect_x_4);
 }
 void CPU::RRA_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::RRA_indirect_x_5;
+	SET_NEXT(RRA_indirect_x_5);
 }
 void CPU::RRA_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_indirect_x_6;
+	SET_NEXT(RRA_indirect_x_6);
 }
 void CPU::RRA_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_indirect_x_7;
+	SET_NEXT(RRA_indirect_x_7);
 }
 
 void CPU::RRA_indirect_x_7()
@@ -6154,36 +6155,36 @@ void CPU::RRA_indirect_x_7()
 void CPU::RRA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::RRA_indirect_y_2;
+	SET_NEXT(RRA_indirect_y_2);
 }
 void CPU::RRA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::RRA_indirect_y_3;
+	SET_NEXT(RRA_indirect_y_3);
 }
 void CPU::RRA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::RRA_indirect_y_4;
+	SET_NEXT(RRA_indirect_y_4);
 }
 void CPU::RRA_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::RRA_indirect_y_5;
+	SET_NEXT(RRA_indirect_y_5);
 }
 void CPU::RRA_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::RRA_indirect_y_6;
+	SET_NEXT(RRA_indirect_y_6);
 }
 void CPU::RRA_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_ROR;
-	next = &CPU::RRA_indirect_y_7;
+	SET_NEXT(RRA_indirect_y_7);
 }
 
 void CPU::RRA_indirect_y_7()
@@ -6206,7 +6207,7 @@ void CPU::RRA_indirect_y_7()
 void CPU::SAX_zero_page()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SAX_zero_page_2;
+	SET_NEXT(SAX_zero_page_2);
 }
 void CPU::SAX_zero_page_2()
 {
@@ -6219,13 +6220,13 @@ void CPU::SAX_zero_page_2()
 void CPU::SAX_zero_page_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SAX_zero_page_y_2;
+	SET_NEXT(SAX_zero_page_y_2);
 }
 void CPU::SAX_zero_page_y_2()
 {
 	IDLE_READ_FROM_ZERO_PAGE;
 	ADD_INDEX_Y;
-	next = &CPU::SAX_zero_page_y_3;
+	SET_NEXT(SAX_zero_page_y_3);
 }	
 void CPU::SAX_zero_page_y_3()
 {
@@ -6238,12 +6239,12 @@ void CPU::SAX_zero_page_y_3()
 void CPU::SAX_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SAX_absolute_2;
+	SET_NEXT(SAX_absolute_2);
 }
 void CPU::SAX_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::SAX_absolute_3;
+	SET_NEXT(SAX_absolute_3);
 }
 void CPU::SAX_absolute_3()
 {
@@ -6256,23 +6257,23 @@ void CPU::SAX_absolute_3()
 void CPU::SAX_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SAX_indirect_x_2;
+	SET_NEXT(SAX_indirect_x_2);
 }
 void CPU::SAX_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SAX_indirect_x_3;
+	SET_NEXT(SAX_indirect_x_3);
 }
 void CPU::SAX_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SAX_indirect_x_4;
+	SET_NEXT(SAX_indirect_x_4);
 }
 void CPU::SAX_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SAX_indirect_x_5;
+	SET_NEXT(SAX_indirect_x_5);
 }
 void CPU::SAX_indirect_x_5()
 {
@@ -6294,20 +6295,20 @@ void CPU::SAX_indirect_x_5()
 void CPU::SHA_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SHA_absolute_y_2;
+	SET_NEXT(SHA_absolute_y_2);
 }
 void CPU::SHA_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SHA_absolute_y_3;
+	SET_NEXT(SHA_absolute_y_3);
 }
 void CPU::SHA_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHA_absolute_y_4;
+	SET_NEXT(SHA_absolute_y_4);
 }
 void CPU::SHA_absolute_y_4()
 {
@@ -6320,25 +6321,25 @@ void CPU::SHA_absolute_y_4()
 void CPU::SHA_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SHA_indirect_y_2;
+	SET_NEXT(SHA_indirect_y_2);
 }
 void CPU::SHA_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SHA_indirect_y_3;
+	SET_NEXT(SHA_indirect_y_3);
 }
 void CPU::SHA_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SHA_indirect_y_4;
+	SET_NEXT(SHA_indirect_y_4);
 }
 void CPU::SHA_indirect_y_4()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHA_indirect_y_5;
+	SET_NEXT(SHA_indirect_y_5);
 }
 void CPU::SHA_indirect_y_5()
 {
@@ -6360,20 +6361,20 @@ void CPU::SHA_indirect_y_5()
 void CPU::SHX_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SHX_absolute_y_2;
+	SET_NEXT(SHX_absolute_y_2);
 }
 void CPU::SHX_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SHX_absolute_y_3;
+	SET_NEXT(SHX_absolute_y_3);
 }
 void CPU::SHX_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHX_absolute_y_4;
+	SET_NEXT(SHX_absolute_y_4);
 }
 void CPU::SHX_absolute_y_4()
 {
@@ -6395,20 +6396,20 @@ void CPU::SHX_absolute_y_4()
 void CPU::SHY_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SHY_absolute_x_2;
+	SET_NEXT(SHY_absolute_x_2);
 }
 void CPU::SHY_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SHY_absolute_x_3;
+	SET_NEXT(SHY_absolute_x_3);
 }
 void CPU::SHY_absolute_x_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SHY_absolute_x_4;
+	SET_NEXT(SHY_absolute_x_4);
 }
 void CPU::SHY_absolute_x_4()
 {
@@ -6433,18 +6434,18 @@ void CPU::SHY_absolute_x_4()
 void CPU::SLO_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_zero_page_2;
+	SET_NEXT(SLO_zero_page_2);
 }
 void CPU::SLO_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SLO_zero_page_3;
+	SET_NEXT(SLO_zero_page_3);
 }
 void CPU::SLO_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SLO;
-	next = &CPU::SLO_zero_page_4;
+	SET_NEXT(SLO_zero_page_4);
 }
 void CPU::SLO_zero_page_4()
 {
@@ -6457,24 +6458,24 @@ void CPU::SLO_zero_page_4()
 void CPU::SLO_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_zero_page_x_2;
+	SET_NEXT(SLO_zero_page_x_2);
 }
 void CPU::SLO_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::SLO_zero_page_x_3;
+	SET_NEXT(SLO_zero_page_x_3);
 }
 void CPU::SLO_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SLO_zero_page_x_4;
+	SET_NEXT(SLO_zero_page_x_4);
 }
 void CPU::SLO_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SLO;
-	next = &CPU::SLO_zero_page_x_5;
+	SET_NEXT(SLO_zero_page_x_5);
 }
 void CPU::SLO_zero_page_x_5()
 {
@@ -6487,23 +6488,23 @@ void CPU::SLO_zero_page_x_5()
 void CPU::SLO_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_absolute_2;
+	SET_NEXT(SLO_absolute_2);
 }
 void CPU::SLO_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::SLO_absolute_3;
+	SET_NEXT(SLO_absolute_3);
 }
 void CPU::SLO_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_absolute_4;
+	SET_NEXT(SLO_absolute_4);
 }
 void CPU::SLO_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_absolute_5;
+	SET_NEXT(SLO_absolute_5);
 }
 void CPU::SLO_absolute_5()
 {
@@ -6516,31 +6517,31 @@ void CPU::SLO_absolute_5()
 void CPU::SLO_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_absolute_x_2;
+	SET_NEXT(SLO_absolute_x_2);
 }
 void CPU::SLO_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SLO_absolute_x_3;
+	SET_NEXT(SLO_absolute_x_3);
 }
 void CPU::SLO_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SLO_absolute_x_4;
+	SET_NEXT(SLO_absolute_x_4);
 }
 void CPU::SLO_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_absolute_x_5;
+	SET_NEXT(SLO_absolute_x_5);
 }
 void CPU::SLO_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_absolute_x_6;
+	SET_NEXT(SLO_absolute_x_6);
 }
 void CPU::SLO_absolute_x_6()
 {
@@ -6553,31 +6554,31 @@ void CPU::SLO_absolute_x_6()
 void CPU::SLO_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SLO_absolute_y_2;
+	SET_NEXT(SLO_absolute_y_2);
 }
 void CPU::SLO_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SLO_absolute_y_3;
+	SET_NEXT(SLO_absolute_y_3);
 }
 void CPU::SLO_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SLO_absolute_y_4;
+	SET_NEXT(SLO_absolute_y_4);
 }
 void CPU::SLO_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_absolute_y_5;
+	SET_NEXT(SLO_absolute_y_5);
 }
 void CPU::SLO_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_absolute_y_6;
+	SET_NEXT(SLO_absolute_y_6);
 }
 void CPU::SLO_absolute_y_6()
 {
@@ -6590,34 +6591,34 @@ void CPU::SLO_absolute_y_6()
 void CPU::SLO_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SLO_indirect_x_2;
+	SET_NEXT(SLO_indirect_x_2);
 }
 void CPU::SLO_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SLO_indirect_x_3;
+	SET_NEXT(SLO_indirect_x_3);
 }
 void CPU::SLO_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SLO_indirect_x_4;
+	SET_NEXT(SLO_indirect_x_4);
 }
 void CPU::SLO_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SLO_indirect_x_5;
+	SET_NEXT(SLO_indirect_x_5);
 }
 void CPU::SLO_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_indirect_x_6;
+	SET_NEXT(SLO_indirect_x_6);
 }
 void CPU::SLO_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_indirect_x_7;
+	SET_NEXT(SLO_indirect_x_7);
 }
 
 void CPU::SLO_indirect_x_7()
@@ -6631,36 +6632,36 @@ void CPU::SLO_indirect_x_7()
 void CPU::SLO_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SLO_indirect_y_2;
+	SET_NEXT(SLO_indirect_y_2);
 }
 void CPU::SLO_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SLO_indirect_y_3;
+	SET_NEXT(SLO_indirect_y_3);
 }
 void CPU::SLO_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SLO_indirect_y_4;
+	SET_NEXT(SLO_indirect_y_4);
 }
 void CPU::SLO_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SLO_indirect_y_5;
+	SET_NEXT(SLO_indirect_y_5);
 }
 void CPU::SLO_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SLO_indirect_y_6;
+	SET_NEXT(SLO_indirect_y_6);
 }
 void CPU::SLO_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SLO;
-	next = &CPU::SLO_indirect_y_7;
+	SET_NEXT(SLO_indirect_y_7);
 }
 
 void CPU::SLO_indirect_y_7()
@@ -6686,18 +6687,18 @@ void CPU::SLO_indirect_y_7()
 void CPU::SRE_zero_page() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_zero_page_2;
+	SET_NEXT(SRE_zero_page_2);
 }
 void CPU::SRE_zero_page_2() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SRE_zero_page_3;
+	SET_NEXT(SRE_zero_page_3);
 }
 void CPU::SRE_zero_page_3()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SRE;
-	next = &CPU::SRE_zero_page_4;
+	SET_NEXT(SRE_zero_page_4);
 }
 void CPU::SRE_zero_page_4()
 {
@@ -6710,24 +6711,24 @@ void CPU::SRE_zero_page_4()
 void CPU::SRE_zero_page_x() 
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_zero_page_x_2;
+	SET_NEXT(SRE_zero_page_x_2);
 }
 void CPU::SRE_zero_page_x_2() 
 {
 	READ_FROM_ZERO_PAGE;
 	ADD_INDEX_X;
-	next = &CPU::SRE_zero_page_x_3;
+	SET_NEXT(SRE_zero_page_x_3);
 }
 void CPU::SRE_zero_page_x_3() 
 {
 	READ_FROM_ZERO_PAGE;
-	next = &CPU::SRE_zero_page_x_4;
+	SET_NEXT(SRE_zero_page_x_4);
 }
 void CPU::SRE_zero_page_x_4()
 {
 	WRITE_TO_ZERO_PAGE;
 	DO_SRE;
-	next = &CPU::SRE_zero_page_x_5;
+	SET_NEXT(SRE_zero_page_x_5);
 }
 void CPU::SRE_zero_page_x_5()
 {
@@ -6740,23 +6741,23 @@ void CPU::SRE_zero_page_x_5()
 void CPU::SRE_absolute()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_absolute_2;
+	SET_NEXT(SRE_absolute_2);
 }
 void CPU::SRE_absolute_2()
 {
 	FETCH_ADDR_HI;
-	next = &CPU::SRE_absolute_3;
+	SET_NEXT(SRE_absolute_3);
 }
 void CPU::SRE_absolute_3()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_absolute_4;
+	SET_NEXT(SRE_absolute_4);
 }
 void CPU::SRE_absolute_4()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_absolute_5;
+	SET_NEXT(SRE_absolute_5);
 }
 void CPU::SRE_absolute_5()
 {
@@ -6769,31 +6770,31 @@ void CPU::SRE_absolute_5()
 void CPU::SRE_absolute_x()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_absolute_x_2;
+	SET_NEXT(SRE_absolute_x_2);
 }
 void CPU::SRE_absolute_x_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_X;
-	next = &CPU::SRE_absolute_x_3;
+	SET_NEXT(SRE_absolute_x_3);
 }
 void CPU::SRE_absolute_x_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SRE_absolute_x_4;
+	SET_NEXT(SRE_absolute_x_4);
 }
 void CPU::SRE_absolute_x_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_absolute_x_5;
+	SET_NEXT(SRE_absolute_x_5);
 }
 void CPU::SRE_absolute_x_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_absolute_x_6;
+	SET_NEXT(SRE_absolute_x_6);
 }
 void CPU::SRE_absolute_x_6()
 {
@@ -6806,31 +6807,31 @@ void CPU::SRE_absolute_x_6()
 void CPU::SRE_absolute_y()
 {
 	FETCH_ADDR_LO;
-	next = &CPU::SRE_absolute_y_2;
+	SET_NEXT(SRE_absolute_y_2);
 }
 void CPU::SRE_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::SRE_absolute_y_3;
+	SET_NEXT(SRE_absolute_y_3);
 }
 void CPU::SRE_absolute_y_3()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SRE_absolute_y_4;
+	SET_NEXT(SRE_absolute_y_4);
 }
 void CPU::SRE_absolute_y_4()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_absolute_y_5;
+	SET_NEXT(SRE_absolute_y_5);
 }
 void CPU::SRE_absolute_y_5()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_absolute_y_6;
+	SET_NEXT(SRE_absolute_y_6);
 }
 void CPU::SRE_absolute_y_6()
 {
@@ -6843,34 +6844,34 @@ void CPU::SRE_absolute_y_6()
 void CPU::SRE_indirect_x()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SRE_indirect_x_2;
+	SET_NEXT(SRE_indirect_x_2);
 }
 void CPU::SRE_indirect_x_2()
 {
 	IDLE_READ_FROM_ADDRESS_INDIRECT;
 	ADD_INDEX_X_INDIRECT;
-	next = &CPU::SRE_indirect_x_3;
+	SET_NEXT(SRE_indirect_x_3);
 }
 void CPU::SRE_indirect_x_3()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SRE_indirect_x_4;
+	SET_NEXT(SRE_indirect_x_4);
 }
 void CPU::SRE_indirect_x_4()
 {
 	FETCH_ADDR_HI_INDIRECT;
-	next = &CPU::SRE_indirect_x_5;
+	SET_NEXT(SRE_indirect_x_5);
 }
 void CPU::SRE_indirect_x_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_indirect_x_6;
+	SET_NEXT(SRE_indirect_x_6);
 }
 void CPU::SRE_indirect_x_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_indirect_x_7;
+	SET_NEXT(SRE_indirect_x_7);
 }
 
 void CPU::SRE_indirect_x_7()
@@ -6884,36 +6885,36 @@ void CPU::SRE_indirect_x_7()
 void CPU::SRE_indirect_y()
 {
 	FETCH_POINTER_ADDR;
-	next = &CPU::SRE_indirect_y_2;
+	SET_NEXT(SRE_indirect_y_2);
 }
 void CPU::SRE_indirect_y_2()
 {
 	FETCH_ADDR_LO_INDIRECT;
-	next = &CPU::SRE_indirect_y_3;
+	SET_NEXT(SRE_indirect_y_3);
 }
 void CPU::SRE_indirect_y_3()
 {
 	FETCH_ADDR_HI_INDIRECT;
 	ADD_INDEX_Y;
-	next = &CPU::SRE_indirect_y_4;
+	SET_NEXT(SRE_indirect_y_4);
 }
 void CPU::SRE_indirect_y_4()
 {
 	READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED)
 		FIX_ADDR_HI;
-	next = &CPU::SRE_indirect_y_5;
+	SET_NEXT(SRE_indirect_y_5);
 }
 void CPU::SRE_indirect_y_5()
 {
 	READ_FROM_ADDRESS;
-	next = &CPU::SRE_indirect_y_6;
+	SET_NEXT(SRE_indirect_y_6);
 }
 void CPU::SRE_indirect_y_6()
 {
 	WRITE_TO_ADDRESS;
 	DO_SRE;
-	next = &CPU::SRE_indirect_y_7;
+	SET_NEXT(SRE_indirect_y_7);
 }
 
 void CPU::SRE_indirect_y_7()
@@ -6935,26 +6936,26 @@ void CPU::SRE_indirect_y_7()
 
 void CPU::TAS_absolute_y()
 {
-	data = mem->peek(PC + 1) + 1;
+	data = peekMem(PC + 1) + 1;
 	FETCH_ADDR_LO;
-	next = &CPU::TAS_absolute_y_2;
+	SET_NEXT(TAS_absolute_y_2);
 }
 void CPU::TAS_absolute_y_2()
 {
 	FETCH_ADDR_HI;
 	ADD_INDEX_Y;
-	next = &CPU::TAS_absolute_y_3;
+	SET_NEXT(TAS_absolute_y_3);
 }
 void CPU::TAS_absolute_y_3()
 {
 	IDLE_READ_FROM_ADDRESS;
 	if (PAGE_BOUNDARY_CROSSED) {
 		FIX_ADDR_HI;
-		next = &CPU::TAS_absolute_y_4;
+		SET_NEXT(TAS_absolute_y_4);
 	} else {
 		// Note: We always perform an extra cycle here, even if page boundary is not crossed. 
 		// Otherwise, the CPUTIMING test fails.
-		next = &CPU::TAS_absolute_y_4;
+		SET_NEXT(TAS_absolute_y_4);
 #if 0
 		SP = A & X;
 		data &= SP;
@@ -7006,297 +7007,39 @@ void CPU::LXA_immediate()
 	DONE;
 }
 
-void ((CPU::*CPU::callbacks[])(void)) = {
-	
-&CPU::fetch,
-
-&CPU::JAM, &CPU::JAM_2,
-
-&CPU::irq, &CPU::irq_2, &CPU::irq_3, &CPU::irq_4, &CPU::irq_5, &CPU::irq_6, &CPU::irq_7,
-&CPU::nmi, &CPU::nmi_2, &CPU::nmi_3, &CPU::nmi_4, &CPU::nmi_5, &CPU::nmi_6, &CPU::nmi_7,
-
-&CPU::ADC_immediate,
-&CPU::ADC_zero_page, &CPU::ADC_zero_page_2,
-&CPU::ADC_zero_page_x, &CPU::ADC_zero_page_x_2, &CPU::ADC_zero_page_x_3,
-&CPU::ADC_absolute, &CPU::ADC_absolute_2, &CPU::ADC_absolute_3,
-&CPU::ADC_absolute_x, &CPU::ADC_absolute_x_2, &CPU::ADC_absolute_x_3, &CPU::ADC_absolute_x_4,
-&CPU::ADC_absolute_y, &CPU::ADC_absolute_y_2, &CPU::ADC_absolute_y_3, &CPU::ADC_absolute_y_4,
-&CPU::ADC_indirect_x, &CPU::ADC_indirect_x_2, &CPU::ADC_indirect_x_3, &CPU::ADC_indirect_x_4, &CPU::ADC_indirect_x_5,
-&CPU::ADC_indirect_y, &CPU::ADC_indirect_y_2, &CPU::ADC_indirect_y_3, &CPU::ADC_indirect_y_4, &CPU::ADC_indirect_y_5,
-
-&CPU::AND_immediate,
-&CPU::AND_zero_page, &CPU::AND_zero_page_2,
-&CPU::AND_zero_page_x, &CPU::AND_zero_page_x_2, &CPU::AND_zero_page_x_3,
-&CPU::AND_absolute, &CPU::AND_absolute_2, &CPU::AND_absolute_3,
-&CPU::AND_absolute_x, &CPU::AND_absolute_x_2, &CPU::AND_absolute_x_3, &CPU::AND_absolute_x_4,
-&CPU::AND_absolute_y, &CPU::AND_absolute_y_2, &CPU::AND_absolute_y_3, &CPU::AND_absolute_y_4,
-&CPU::AND_indirect_x, &CPU::AND_indirect_x_2, &CPU::AND_indirect_x_3, &CPU::AND_indirect_x_4, &CPU::AND_indirect_x_5,
-&CPU::AND_indirect_y, &CPU::AND_indirect_y_2, &CPU::AND_indirect_y_3, &CPU::AND_indirect_y_4, &CPU::AND_indirect_y_5,
-
-&CPU::ASL_accumulator,
-&CPU::ASL_zero_page, &CPU::ASL_zero_page_2, &CPU::ASL_zero_page_3, &CPU::ASL_zero_page_4,
-&CPU::ASL_zero_page_x, &CPU::ASL_zero_page_x_2, &CPU::ASL_zero_page_x_3, &CPU::ASL_zero_page_x_4, &CPU::ASL_zero_page_x_5,
-&CPU::ASL_absolute, &CPU::ASL_absolute_2, &CPU::ASL_absolute_3, &CPU::ASL_absolute_4, &CPU::ASL_absolute_5,
-&CPU::ASL_absolute_x, &CPU::ASL_absolute_x_2, &CPU::ASL_absolute_x_3, &CPU::ASL_absolute_x_4, &CPU::ASL_absolute_x_5, &CPU::ASL_absolute_x_6,
-&CPU::ASL_indirect_x, &CPU::ASL_indirect_x_2, &CPU::ASL_indirect_x_3, &CPU::ASL_indirect_x_4, &CPU::ASL_indirect_x_5, &CPU::ASL_indirect_x_6, &CPU::ASL_indirect_x_7,     
-
-&CPU::branch_3_underflow, &CPU::branch_3_overflow,
-&CPU::BCC_relative, &CPU::BCC_relative_2, 
-&CPU::BCS_relative, &CPU::BCS_relative_2, 
-&CPU::BEQ_relative, &CPU::BEQ_relative_2, 
-
-&CPU::BIT_zero_page, &CPU::BIT_zero_page_2,
-&CPU::BIT_absolute, &CPU::BIT_absolute_2, &CPU::BIT_absolute_3,
-
-&CPU::BMI_relative, &CPU::BMI_relative_2, 
-&CPU::BNE_relative, &CPU::BNE_relative_2, 
-&CPU::BPL_relative, &CPU::BPL_relative_2, 
-
-&CPU::BRK, &CPU::BRK_2, &CPU::BRK_3, &CPU::BRK_4, &CPU::BRK_5, &CPU::BRK_6,
-&CPU::BRK_nmi_4, &CPU::BRK_nmi_5, &CPU::BRK_nmi_6, 
-
-&CPU::BVC_relative, &CPU::BVC_relative_2, 
-&CPU::BVS_relative, &CPU::BVS_relative_2, 
-&CPU::CLC,
-&CPU::CLD,
-&CPU::CLI,
-&CPU::CLV,
-
-&CPU::CMP_immediate,
-&CPU::CMP_zero_page, &CPU::CMP_zero_page_2,
-&CPU::CMP_zero_page_x, &CPU::CMP_zero_page_x_2, &CPU::CMP_zero_page_x_3,
-&CPU::CMP_absolute, &CPU::CMP_absolute_2, &CPU::CMP_absolute_3,
-&CPU::CMP_absolute_x, &CPU::CMP_absolute_x_2, &CPU::CMP_absolute_x_3, &CPU::CMP_absolute_x_4,
-&CPU::CMP_absolute_y, &CPU::CMP_absolute_y_2, &CPU::CMP_absolute_y_3, &CPU::CMP_absolute_y_4,
-&CPU::CMP_indirect_x, &CPU::CMP_indirect_x_2, &CPU::CMP_indirect_x_3, &CPU::CMP_indirect_x_4, &CPU::CMP_indirect_x_5,
-&CPU::CMP_indirect_y, &CPU::CMP_indirect_y_2, &CPU::CMP_indirect_y_3, &CPU::CMP_indirect_y_4, &CPU::CMP_indirect_y_5,
-
-&CPU::CPX_immediate,
-&CPU::CPX_zero_page, &CPU::CPX_zero_page_2, 
-&CPU::CPX_absolute, &CPU::CPX_absolute_2, &CPU::CPX_absolute_3,
-
-&CPU::CPY_immediate,
-&CPU::CPY_zero_page, &CPU::CPY_zero_page_2,
-&CPU::CPY_absolute, &CPU::CPY_absolute_2, &CPU::CPY_absolute_3,
-
-&CPU::DEC_zero_page, &CPU::DEC_zero_page_2, &CPU::DEC_zero_page_3, &CPU::DEC_zero_page_4,
-&CPU::DEC_zero_page_x, &CPU::DEC_zero_page_x_2, &CPU::DEC_zero_page_x_3, &CPU::DEC_zero_page_x_4, &CPU::DEC_zero_page_x_5,
-&CPU::DEC_absolute, &CPU::DEC_absolute_2, &CPU::DEC_absolute_3, &CPU::DEC_absolute_4, &CPU::DEC_absolute_5,
-&CPU::DEC_absolute_x, &CPU::DEC_absolute_x_2, &CPU::DEC_absolute_x_3, &CPU::DEC_absolute_x_4, &CPU::DEC_absolute_x_5, &CPU::DEC_absolute_x_6,
-&CPU::DEC_indirect_x, &CPU::DEC_indirect_x_2, &CPU::DEC_indirect_x_3, &CPU::DEC_indirect_x_4, &CPU::DEC_indirect_x_5, &CPU::DEC_indirect_x_6, &CPU::DEC_indirect_x_7,     
-
-&CPU::DEX,
-&CPU::DEY,
-
-&CPU::EOR_immediate,
-&CPU::EOR_zero_page, &CPU::EOR_zero_page_2,
-&CPU::EOR_zero_page_x, &CPU::EOR_zero_page_x_2, &CPU::EOR_zero_page_x_3,
-&CPU::EOR_absolute, &CPU::EOR_absolute_2, &CPU::EOR_absolute_3,
-&CPU::EOR_absolute_x, &CPU::EOR_absolute_x_2, &CPU::EOR_absolute_x_3, &CPU::EOR_absolute_x_4,
-&CPU::EOR_absolute_y, &CPU::EOR_absolute_y_2, &CPU::EOR_absolute_y_3, &CPU::EOR_absolute_y_4,
-&CPU::EOR_indirect_x, &CPU::EOR_indirect_x_2, &CPU::EOR_indirect_x_3, &CPU::EOR_indirect_x_4, &CPU::EOR_indirect_x_5,
-&CPU::EOR_indirect_y, &CPU::EOR_indirect_y_2, &CPU::EOR_indirect_y_3, &CPU::EOR_indirect_y_4, &CPU::EOR_indirect_y_5,
-
-&CPU::INC_zero_page, &CPU::INC_zero_page_2, &CPU::INC_zero_page_3, &CPU::INC_zero_page_4,
-&CPU::INC_zero_page_x, &CPU::INC_zero_page_x_2, &CPU::INC_zero_page_x_3, &CPU::INC_zero_page_x_4, &CPU::INC_zero_page_x_5,
-&CPU::INC_absolute, &CPU::INC_absolute_2, &CPU::INC_absolute_3, &CPU::INC_absolute_4, &CPU::INC_absolute_5,
-&CPU::INC_absolute_x, &CPU::INC_absolute_x_2, &CPU::INC_absolute_x_3, &CPU::INC_absolute_x_4, &CPU::INC_absolute_x_5, &CPU::INC_absolute_x_6,
-&CPU::INC_indirect_x, &CPU::INC_indirect_x_2, &CPU::INC_indirect_x_3, &CPU::INC_indirect_x_4, &CPU::INC_indirect_x_5, &CPU::INC_indirect_x_6, &CPU::INC_indirect_x_7,     
-
-&CPU::INX,
-&CPU::INY,
-
-&CPU::JMP_absolute, &CPU::JMP_absolute_2,
-&CPU::JMP_absolute_indirect, &CPU::JMP_absolute_indirect_2, &CPU::JMP_absolute_indirect_3, &CPU::JMP_absolute_indirect_4,
-
-&CPU::JSR, &CPU::JSR_2, &CPU::JSR_3, &CPU::JSR_4, &CPU::JSR_5,
-
-&CPU::LDA_immediate,
-&CPU::LDA_zero_page, &CPU::LDA_zero_page_2,
-&CPU::LDA_zero_page_x, &CPU::LDA_zero_page_x_2, &CPU::LDA_zero_page_x_3,
-&CPU::LDA_absolute, &CPU::LDA_absolute_2, &CPU::LDA_absolute_3,
-&CPU::LDA_absolute_x, &CPU::LDA_absolute_x_2, &CPU::LDA_absolute_x_3, &CPU::LDA_absolute_x_4,
-&CPU::LDA_absolute_y, &CPU::LDA_absolute_y_2, &CPU::LDA_absolute_y_3, &CPU::LDA_absolute_y_4,
-&CPU::LDA_indirect_x, &CPU::LDA_indirect_x_2, &CPU::LDA_indirect_x_3, &CPU::LDA_indirect_x_4, &CPU::LDA_indirect_x_5,
-&CPU::LDA_indirect_y, &CPU::LDA_indirect_y_2, &CPU::LDA_indirect_y_3, &CPU::LDA_indirect_y_4, &CPU::LDA_indirect_y_5,
-
-&CPU::LDX_immediate,
-&CPU::LDX_zero_page, &CPU::LDX_zero_page_2,
-&CPU::LDX_zero_page_y, &CPU::LDX_zero_page_y_2, &CPU::LDX_zero_page_y_3,
-&CPU::LDX_absolute, &CPU::LDX_absolute_2, &CPU::LDX_absolute_3,
-&CPU::LDX_absolute_y, &CPU::LDX_absolute_y_2, &CPU::LDX_absolute_y_3, &CPU::LDX_absolute_y_4,
-&CPU::LDX_indirect_x, &CPU::LDX_indirect_x_2, &CPU::LDX_indirect_x_3, &CPU::LDX_indirect_x_4, &CPU::LDX_indirect_x_5,
-&CPU::LDX_indirect_y, &CPU::LDX_indirect_y_2, &CPU::LDX_indirect_y_3, &CPU::LDX_indirect_y_4, &CPU::LDX_indirect_y_5,
-
-&CPU::LDY_immediate,
-&CPU::LDY_zero_page, &CPU::LDY_zero_page_2,
-&CPU::LDY_zero_page_x, &CPU::LDY_zero_page_x_2, &CPU::LDY_zero_page_x_3,
-&CPU::LDY_absolute, &CPU::LDY_absolute_2, &CPU::LDY_absolute_3,
-&CPU::LDY_absolute_x, &CPU::LDY_absolute_x_2, &CPU::LDY_absolute_x_3, &CPU::LDY_absolute_x_4,
-&CPU::LDY_indirect_x, &CPU::LDY_indirect_x_2, &CPU::LDY_indirect_x_3, &CPU::LDY_indirect_x_4, &CPU::LDY_indirect_x_5,
-&CPU::LDY_indirect_y, &CPU::LDY_indirect_y_2, &CPU::LDY_indirect_y_3, &CPU::LDY_indirect_y_4, &CPU::LDY_indirect_y_5,
-
-&CPU::LSR_accumulator,
-&CPU::LSR_zero_page, &CPU::LSR_zero_page_2, &CPU::LSR_zero_page_3, &CPU::LSR_zero_page_4,
-&CPU::LSR_zero_page_x, &CPU::LSR_zero_page_x_2, &CPU::LSR_zero_page_x_3, &CPU::LSR_zero_page_x_4, &CPU::LSR_zero_page_x_5,
-&CPU::LSR_absolute, &CPU::LSR_absolute_2, &CPU::LSR_absolute_3, &CPU::LSR_absolute_4, &CPU::LSR_absolute_5,
-&CPU::LSR_absolute_x, &CPU::LSR_absolute_x_2, &CPU::LSR_absolute_x_3, &CPU::LSR_absolute_x_4, &CPU::LSR_absolute_x_5, &CPU::LSR_absolute_x_6,
-&CPU::LSR_absolute_y, &CPU::LSR_absolute_y_2, &CPU::LSR_absolute_y_3, &CPU::LSR_absolute_y_4, &CPU::LSR_absolute_y_5, &CPU::LSR_absolute_y_6, 
-&CPU::LSR_indirect_x, &CPU::LSR_indirect_x_2, &CPU::LSR_indirect_x_3, &CPU::LSR_indirect_x_4, &CPU::LSR_indirect_x_5, &CPU::LSR_indirect_x_6, &CPU::LSR_indirect_x_7,     
-&CPU::LSR_indirect_y, &CPU::LSR_indirect_y_2, &CPU::LSR_indirect_y_3, &CPU::LSR_indirect_y_4, &CPU::LSR_indirect_y_5, &CPU::LSR_indirect_y_6, &CPU::LSR_indirect_y_7,
-
-&CPU::NOP,
-&CPU::NOP_immediate,
-&CPU::NOP_zero_page, &CPU::NOP_zero_page_2,
-&CPU::NOP_zero_page_x, &CPU::NOP_zero_page_x_2, &CPU::NOP_zero_page_x_3,
-&CPU::NOP_absolute, &CPU::NOP_absolute_2, &CPU::NOP_absolute_3,
-&CPU::NOP_absolute_x, &CPU::NOP_absolute_x_2, &CPU::NOP_absolute_x_3, &CPU::NOP_absolute_x_4,
-
-&CPU::ORA_immediate,
-&CPU::ORA_zero_page, &CPU::ORA_zero_page_2,
-&CPU::ORA_zero_page_x, &CPU::ORA_zero_page_x_2, &CPU::ORA_zero_page_x_3,
-&CPU::ORA_absolute, &CPU::ORA_absolute_2, &CPU::ORA_absolute_3,
-&CPU::ORA_absolute_x, &CPU::ORA_absolute_x_2, &CPU::ORA_absolute_x_3, &CPU::ORA_absolute_x_4,
-&CPU::ORA_absolute_y, &CPU::ORA_absolute_y_2, &CPU::ORA_absolute_y_3, &CPU::ORA_absolute_y_4,
-&CPU::ORA_indirect_x, &CPU::ORA_indirect_x_2, &CPU::ORA_indirect_x_3, &CPU::ORA_indirect_x_4, &CPU::ORA_indirect_x_5,
-&CPU::ORA_indirect_y, &CPU::ORA_indirect_y_2, &CPU::ORA_indirect_y_3, &CPU::ORA_indirect_y_4, &CPU::ORA_indirect_y_5,
-
-&CPU::PHA, &CPU::PHA_2,
-&CPU::PHP, &CPU::PHP_2,
-&CPU::PLA, &CPU::PLA_2, &CPU::PLA_3,
-&CPU::PLP, &CPU::PLP_2, &CPU::PLP_3,
-
-&CPU::ROL_accumulator,
-&CPU::ROL_zero_page, &CPU::ROL_zero_page_2, &CPU::ROL_zero_page_3, &CPU::ROL_zero_page_4,
-&CPU::ROL_zero_page_x, &CPU::ROL_zero_page_x_2, &CPU::ROL_zero_page_x_3, &CPU::ROL_zero_page_x_4, &CPU::ROL_zero_page_x_5,
-&CPU::ROL_absolute, &CPU::ROL_absolute_2, &CPU::ROL_absolute_3, &CPU::ROL_absolute_4, &CPU::ROL_absolute_5,
-&CPU::ROL_absolute_x, &CPU::ROL_absolute_x_2, &CPU::ROL_absolute_x_3, &CPU::ROL_absolute_x_4, &CPU::ROL_absolute_x_5, &CPU::ROL_absolute_x_6,
-&CPU::ROL_indirect_x, &CPU::ROL_indirect_x_2, &CPU::ROL_indirect_x_3, &CPU::ROL_indirect_x_4, &CPU::ROL_indirect_x_5, &CPU::ROL_indirect_x_6, &CPU::ROL_indirect_x_7,     
-
-&CPU::ROR_accumulator,
-&CPU::ROR_zero_page, &CPU::ROR_zero_page_2, &CPU::ROR_zero_page_3, &CPU::ROR_zero_page_4,
-&CPU::ROR_zero_page_x, &CPU::ROR_zero_page_x_2, &CPU::ROR_zero_page_x_3, &CPU::ROR_zero_page_x_4, &CPU::ROR_zero_page_x_5,
-&CPU::ROR_absolute, &CPU::ROR_absolute_2, &CPU::ROR_absolute_3, &CPU::ROR_absolute_4, &CPU::ROR_absolute_5,
-&CPU::ROR_absolute_x, &CPU::ROR_absolute_x_2, &CPU::ROR_absolute_x_3, &CPU::ROR_absolute_x_4, &CPU::ROR_absolute_x_5, &CPU::ROR_absolute_x_6,
-&CPU::ROR_indirect_x, &CPU::ROR_indirect_x_2, &CPU::ROR_indirect_x_3, &CPU::ROR_indirect_x_4, &CPU::ROR_indirect_x_5, &CPU::ROR_indirect_x_6, &CPU::ROR_indirect_x_7,     
-
-&CPU::RTI, &CPU::RTI_2, &CPU::RTI_3, &CPU::RTI_4, &CPU::RTI_5,
-&CPU::RTS, &CPU::RTS_2, &CPU::RTS_3, &CPU::RTS_4, &CPU::RTS_5,
-
-&CPU::SBC_immediate,
-&CPU::SBC_zero_page, &CPU::SBC_zero_page_2,
-&CPU::SBC_zero_page_x, &CPU::SBC_zero_page_x_2, &CPU::SBC_zero_page_x_3,
-&CPU::SBC_absolute, &CPU::SBC_absolute_2, &CPU::SBC_absolute_3,
-&CPU::SBC_absolute_x, &CPU::SBC_absolute_x_2, &CPU::SBC_absolute_x_3, &CPU::SBC_absolute_x_4,
-&CPU::SBC_absolute_y, &CPU::SBC_absolute_y_2, &CPU::SBC_absolute_y_3, &CPU::SBC_absolute_y_4,
-&CPU::SBC_indirect_x, &CPU::SBC_indirect_x_2, &CPU::SBC_indirect_x_3, &CPU::SBC_indirect_x_4, &CPU::SBC_indirect_x_5,
-&CPU::SBC_indirect_y, &CPU::SBC_indirect_y_2, &CPU::SBC_indirect_y_3, &CPU::SBC_indirect_y_4, &CPU::SBC_indirect_y_5,
-
-&CPU::SEC,
-&CPU::SED,
-&CPU::SEI,
-
-&CPU::STA_zero_page, &CPU::STA_zero_page_2,
-&CPU::STA_zero_page_x, &CPU::STA_zero_page_x_2, &CPU::STA_zero_page_x_3,
-&CPU::STA_absolute, &CPU::STA_absolute_2, &CPU::STA_absolute_3,
-&CPU::STA_absolute_x, &CPU::STA_absolute_x_2, &CPU::STA_absolute_x_3, &CPU::STA_absolute_x_4,
-&CPU::STA_absolute_y, &CPU::STA_absolute_y_2, &CPU::STA_absolute_y_3, &CPU::STA_absolute_y_4,
-&CPU::STA_indirect_x, &CPU::STA_indirect_x_2, &CPU::STA_indirect_x_3, &CPU::STA_indirect_x_4, &CPU::STA_indirect_x_5,
-&CPU::STA_indirect_y, &CPU::STA_indirect_y_2, &CPU::STA_indirect_y_3, &CPU::STA_indirect_y_4, &CPU::STA_indirect_y_5,
-
-&CPU::STX_zero_page, &CPU::STX_zero_page_2,
-&CPU::STX_zero_page_y, &CPU::STX_zero_page_y_2, &CPU::STX_zero_page_y_3,
-&CPU::STX_absolute, &CPU::STX_absolute_2, &CPU::STX_absolute_3,
-
-&CPU::STY_zero_page, &CPU::STY_zero_page_2,
-&CPU::STY_zero_page_x, &CPU::STY_zero_page_x_2, &CPU::STY_zero_page_x_3,
-&CPU::STY_absolute, &CPU::STY_absolute_2, &CPU::STY_absolute_3,
-
-&CPU::TAX,
-&CPU::TAY,
-&CPU::TSX,
-&CPU::TXA,
-&CPU::TXS,
-&CPU::TYA,
+uint16_t
+CPU::callbackIndex(void (CPU::*func)(void))
+{
+	for (uint16_t i = 0;; i++) {
+		if (callbacks[i] == NULL) {
+			panic("ERROR: Callback pointer not found!\n");
+			return 0;
+		}
+		if (callbacks[i] == func) {
+			return i;
+		}
+	}
+}
 
-// Illegal instructions
+#ifdef VC64_THREADED_CPU
 
-&CPU::ALR_immediate,   
-&CPU::ANC_immediate,   
-&CPU::ANE_immediate,
-&CPU::ARR_immediate,   
-&CPU::AXS_immediate,   
-
-&CPU::DCP_zero_page, &CPU::DCP_zero_page_2, &CPU::DCP_zero_page_3, &CPU::DCP_zero_page_4,
-&CPU::DCP_zero_page_x, &CPU::DCP_zero_page_x_2, &CPU::DCP_zero_page_x_3, &CPU::DCP_zero_page_x_4, &CPU::DCP_zero_page_x_5,
-&CPU::DCP_absolute, &CPU::DCP_absolute_2, &CPU::DCP_absolute_3, &CPU::DCP_absolute_4, &CPU::DCP_absolute_5,
-&CPU::DCP_absolute_x, &CPU::DCP_absolute_x_2, &CPU::DCP_absolute_x_3, &CPU::DCP_absolute_x_4, &CPU::DCP_absolute_x_5, &CPU::DCP_absolute_x_6,
-&CPU::DCP_absolute_y, &CPU::DCP_absolute_y_2, &CPU::DCP_absolute_y_3, &CPU::DCP_absolute_y_4, &CPU::DCP_absolute_y_5, &CPU::DCP_absolute_y_6, 
-&CPU::DCP_indirect_x, &CPU::DCP_indirect_x_2, &CPU::DCP_indirect_x_3, &CPU::DCP_indirect_x_4, &CPU::DCP_indirect_x_5, &CPU::DCP_indirect_x_6, &CPU::DCP_indirect_x_7,     
-&CPU::DCP_indirect_y, &CPU::DCP_indirect_y_2, &CPU::DCP_indirect_y_3, &CPU::DCP_indirect_y_4, &CPU::DCP_indirect_y_5, &CPU::DCP_indirect_y_6, &CPU::DCP_indirect_y_7,
-
-&CPU::ISC_zero_page, &CPU::ISC_zero_page_2, &CPU::ISC_zero_page_3, &CPU::ISC_zero_page_4,
-&CPU::ISC_zero_page_x, &CPU::ISC_zero_page_x_2, &CPU::ISC_zero_page_x_3, &CPU::ISC_zero_page_x_4, &CPU::ISC_zero_page_x_5,
-&CPU::ISC_absolute, &CPU::ISC_absolute_2, &CPU::ISC_absolute_3, &CPU::ISC_absolute_4, &CPU::ISC_absolute_5,
-&CPU::ISC_absolute_x, &CPU::ISC_absolute_x_2, &CPU::ISC_absolute_x_3, &CPU::ISC_absolute_x_4, &CPU::ISC_absolute_x_5, &CPU::ISC_absolute_x_6,
-&CPU::ISC_absolute_y, &CPU::ISC_absolute_y_2, &CPU::ISC_absolute_y_3, &CPU::ISC_absolute_y_4, &CPU::ISC_absolute_y_5, &CPU::ISC_absolute_y_6, 
-&CPU::ISC_indirect_x, &CPU::ISC_indirect_x_2, &CPU::ISC_indirect_x_3, &CPU::ISC_indirect_x_4, &CPU::ISC_indirect_x_5, &CPU::ISC_indirect_x_6, &CPU::ISC_indirect_x_7,     
-&CPU::ISC_indirect_y, &CPU::ISC_indirect_y_2, &CPU::ISC_indirect_y_3, &CPU::ISC_indirect_y_4, &CPU::ISC_indirect_y_5, &CPU::ISC_indirect_y_6, &CPU::ISC_indirect_y_7,
-
-&CPU::LAS_absolute_y, &CPU::LAS_absolute_y_2, &CPU::LAS_absolute_y_3, &CPU::LAS_absolute_y_4,
-
-&CPU::LAX_zero_page, &CPU::LAX_zero_page_2,
-&CPU::LAX_zero_page_y, &CPU::LAX_zero_page_y_2, &CPU::LAX_zero_page_y_3,
-&CPU::LAX_absolute, &CPU::LAX_absolute_2, &CPU::LAX_absolute_3,
-&CPU::LAX_absolute_y, &CPU::LAX_absolute_y_2, &CPU::LAX_absolute_y_3, &CPU::LAX_absolute_y_4,
-&CPU::LAX_indirect_x, &CPU::LAX_indirect_x_2, &CPU::LAX_indirect_x_3, &CPU::LAX_indirect_x_4, &CPU::LAX_indirect_x_5,
-&CPU::LAX_indirect_y, &CPU::LAX_indirect_y_2, &CPU::LAX_indirect_y_3, &CPU::LAX_indirect_y_4, &CPU::LAX_indirect_y_5,
-
-&CPU::LXA_immediate,
-
-&CPU::RLA_zero_page, &CPU::RLA_zero_page_2, &CPU::RLA_zero_page_3, &CPU::RLA_zero_page_4,
-&CPU::RLA_zero_page_x, &CPU::RLA_zero_page_x_2, &CPU::RLA_zero_page_x_3, &CPU::RLA_zero_page_x_4, &CPU::RLA_zero_page_x_5,
-&CPU::RLA_absolute, &CPU::RLA_absolute_2, &CPU::RLA_absolute_3, &CPU::RLA_absolute_4, &CPU::RLA_absolute_5,
-&CPU::RLA_absolute_x, &CPU::RLA_absolute_x_2, &CPU::RLA_absolute_x_3, &CPU::RLA_absolute_x_4, &CPU::RLA_absolute_x_5, &CPU::RLA_absolute_x_6,
-&CPU::RLA_absolute_y, &CPU::RLA_absolute_y_2, &CPU::RLA_absolute_y_3, &CPU::RLA_absolute_y_4, &CPU::RLA_absolute_y_5, &CPU::RLA_absolute_y_6,
-&CPU::RLA_indirect_x, &CPU::RLA_indirect_x_2, &CPU::RLA_indirect_x_3, &CPU::RLA_indirect_x_4, &CPU::RLA_indirect_x_5, &CPU::RLA_indirect_x_6, &CPU::RLA_indirect_x_7,
-&CPU::RLA_indirect_y, &CPU::RLA_indirect_y_2, &CPU::RLA_indirect_y_3, &CPU::RLA_indirect_y_4, &CPU::RLA_indirect_y_5, &CPU::RLA_indirect_y_6, &CPU::RLA_indirect_y_7,
-
-&CPU::RRA_zero_page, &CPU::RRA_zero_page_2, &CPU::RRA_zero_page_3, &CPU::RRA_zero_page_4,
-&CPU::RRA_zero_page_x, &CPU::RRA_zero_page_x_2, &CPU::RRA_zero_page_x_3, &CPU::RRA_zero_page_x_4, &CPU::RRA_zero_page_x_5,
-&CPU::RRA_absolute, &CPU::RRA_absolute_2, &CPU::RRA_absolute_3, &CPU::RRA_absolute_4, &CPU::RRA_absolute_5,
-&CPU::RRA_absolute_x, &CPU::RRA_absolute_x_2, &CPU::RRA_absolute_x_3, &CPU::RRA_absolute_x_4, &CPU::RRA_absolute_x_5, &CPU::RRA_absolute_x_6,
-&CPU::RRA_absolute_y, &CPU::RRA_absolute_y_2, &CPU::RRA_absolute_y_3, &CPU::RRA_absolute_y_4, &CPU::RRA_absolute_y_5, &CPU::RRA_absolute_y_6,
-&CPU::RRA_indirect_x, &CPU::RRA_indirect_x_2, &CPU::RRA_indirect_x_3, &CPU::RRA_indirect_x_4, &CPU::RRA_indirect_x_5, &CPU::RRA_indirect_x_6, &CPU::RRA_indirect_x_7,
-&CPU::RRA_indirect_y, &CPU::RRA_indirect_y_2, &CPU::RRA_indirect_y_3, &CPU::RRA_indirect_y_4, &CPU::RRA_indirect_y_5, &CPU::RRA_indirect_y_6, &CPU::RRA_indirect_y_7,
-
-&CPU::SAX_zero_page, &CPU::SAX_zero_page_2,
-&CPU::SAX_zero_page_y, &CPU::SAX_zero_page_y_2, &CPU::SAX_zero_page_y_3,
-&CPU::SAX_absolute, &CPU::SAX_absolute_2, &CPU::SAX_absolute_3,
-&CPU::SAX_indirect_x, &CPU::SAX_indirect_x_2, &CPU::SAX_indirect_x_3, &CPU::SAX_indirect_x_4, &CPU::SAX_indirect_x_5,
-
-&CPU::SHA_indirect_y, &CPU::SHA_indirect_y_2, &CPU::SHA_indirect_y_3, &CPU::SHA_indirect_y_4, &CPU::SHA_indirect_y_5,
-&CPU::SHA_absolute_y, &CPU::SHA_absolute_y_2, &CPU::SHA_absolute_y_3, &CPU::SHA_absolute_y_4,
-
-&CPU::SHX_absolute_y, &CPU::SHX_absolute_y_2, &CPU::SHX_absolute_y_3, &CPU::SHX_absolute_y_4,
-&CPU::SHY_absolute_x, &CPU::SHY_absolute_x_2, &CPU::SHY_absolute_x_3, &CPU::SHY_absolute_x_4,
-
-&CPU::SLO_zero_page, &CPU::SLO_zero_page_2, &CPU::SLO_zero_page_3, &CPU::SLO_zero_page_4,
-&CPU::SLO_zero_page_x, &CPU::SLO_zero_page_x_2, &CPU::SLO_zero_page_x_3, &CPU::SLO_zero_page_x_4, &CPU::SLO_zero_page_x_5,
-&CPU::SLO_absolute, &CPU::SLO_absolute_2, &CPU::SLO_absolute_3, &CPU::SLO_absolute_4, &CPU::SLO_absolute_5,
-&CPU::SLO_absolute_x, &CPU::SLO_absolute_x_2, &CPU::SLO_absolute_x_3, &CPU::SLO_absolute_x_4, &CPU::SLO_absolute_x_5, &CPU::SLO_absolute_x_6,
-&CPU::SLO_absolute_y, &CPU::SLO_absolute_y_2, &CPU::SLO_absolute_y_3, &CPU::SLO_absolute_y_4, &CPU::SLO_absolute_y_5, &CPU::SLO_absolute_y_6,
-&CPU::SLO_indirect_x, &CPU::SLO_indirect_x_2, &CPU::SLO_indirect_x_3, &CPU::SLO_indirect_x_4, &CPU::SLO_indirect_x_5, &CPU::SLO_indirect_x_6, &CPU::SLO_indirect_x_7,
-&CPU::SLO_indirect_y, &CPU::SLO_indirect_y_2, &CPU::SLO_indirect_y_3, &CPU::SLO_indirect_y_4, &CPU::SLO_indirect_y_5, &CPU::SLO_indirect_y_6, &CPU::SLO_indirect_y_7,
-
-&CPU::SRE_zero_page, &CPU::SRE_zero_page_2, &CPU::SRE_zero_page_3, &CPU::SRE_zero_page_4,
-&CPU::SRE_zero_page_x, &CPU::SRE_zero_page_x_2, &CPU::SRE_zero_page_x_3, &CPU::SRE_zero_page_x_4, &CPU::SRE_zero_page_x_5,
-&CPU::SRE_absolute, &CPU::SRE_absolute_2, &CPU::SRE_absolute_3, &CPU::SRE_absolute_4, &CPU::SRE_absolute_5,
-&CPU::SRE_absolute_x, &CPU::SRE_absolute_x_2, &CPU::SRE_absolute_x_3, &CPU::SRE_absolute_x_4, &CPU::SRE_absolute_x_5, &CPU::SRE_absolute_x_6,
-&CPU::SRE_absolute_y, &CPU::SRE_absolute_y_2, &CPU::SRE_absolute_y_3, &CPU::SRE_absolute_y_4, &CPU::SRE_absolute_y_5, &CPU::SRE_absolute_y_6,
-&CPU::SRE_indirect_x, &CPU::SRE_indirect_x_2, &CPU::SRE_indirect_x_3, &CPU::SRE_indirect_x_4, &CPU::SRE_indirect_x_5, &CPU::SRE_indirect_x_6, &CPU::SRE_indirect_x_7,
-&CPU::SRE_indirect_y, &CPU::SRE_indirect_y_2, &CPU::SRE_indirect_y_3, &CPU::SRE_indirect_y_4, &CPU::SRE_indirect_y_5, &CPU::SRE_indirect_y_6, &CPU::SRE_indirect_y_7,
-
-&CPU::TAS_absolute_y, &CPU::TAS_absolute_y_2, &CPU::TAS_absolute_y_3, &CPU::TAS_absolute_y_4,
-NULL
+#define MICRO_LABEL_ADDR(x) &&label_##x,
+#define MICRO_LABEL(x) label_##x: x(); return;
+
+void __attribute__((flatten))
+CPU::executeThreaded()
+{
+    static void *labels[] = { CPU_MICROCODE(MICRO_LABEL_ADDR) };
+    
+    goto *labels[nextIndex];
+    CPU_MICROCODE(MICRO_LABEL)
+}
+
+#endif
+
+#define MICRO_CALLBACK(x) &CPU::x,
+
+void ((CPU::*CPU::callbacks[])(void)) = {
+    CPU_MICROCODE(MICRO_CALLBACK)
+    NULL
 };
@@ -23,16 +23,16 @@ Joystick::Joystick(int p) {
 
     assert(p == 1 || p == 2);
     
-    setDescription("Joystick");
+    setDescription(p == 1 ? "Joystick1" : "Joystick2");
     debug(3, "    Creating game port %c at address %p...\n", p, this);
     
     // Register snapshot items
     SnapshotItem items[] = {
         
-        { &button,  sizeof(button), 0 },
-        { &axisX,   sizeof(axisX),  0 },
-        { &axisY,   sizeof(axisY),  0 },
-        { NULL,     0,              0 }};
+        { "button", &button,  sizeof(button), 0 },
+        { "axisX",  &axisX,   sizeof(axisX),  0 },
+        { "axisY",  &axisY,   sizeof(axisY),  0 },
+        { NULL,     NULL,     0,              0 }};
     
     registerSnapshotItems(items, sizeof(items));
 }
@@ -62,6 +62,9 @@ Joystick::dumpState()
 void
 Joystick::trigger(JoystickEvent event)
 {
+    if (c64->interceptInput(INPUT_JOYSTICK, this == &c64->joystickB, event))
+        return;
+    
     switch (event) {
             
         case PULL_UP:
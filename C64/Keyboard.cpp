@@ -104,9 +104,9 @@ Keyboard::Keyboard()
     // Register snapshot items
     SnapshotItem items[] = {
 
-        { &kbMatrixRow, sizeof(kbMatrixRow), CLEAR_ON_RESET | BYTE_FORMAT },
-        { &kbMatrixCol, sizeof(kbMatrixCol), CLEAR_ON_RESET | BYTE_FORMAT },
-        { NULL,         0,                   0 }};
+        { "kbMatrixRow", &kbMatrixRow, sizeof(kbMatrixRow), CLEAR_ON_RESET | BYTE_FORMAT },
+        { "kbMatrixCol", &kbMatrixCol, sizeof(kbMatrixCol), CLEAR_ON_RESET | BYTE_FORMAT },
+        { NULL,          NULL,         0,                   0 }};
     
     registerSnapshotItems(items, sizeof(items));
 
@@ -189,6 +189,9 @@ Keyboard::pressKey(uint8_t row, uint8_t col)
     assert(row < 8);
     assert(col < 8);
     
+    if (c64->interceptInput(INPUT_KEY_PRESS, row, col))
+        return;
+    
     kbMatrixRow[row] &= 255 - (1 << col);
     kbMatrixCol[col] &= 255 - (1 << row);
 
@@ -245,6 +248,9 @@ Keyboard::pressKey(C64KeyFingerprint key)
 void
 Keyboard::pressRestoreKey()
 {
+    if (c64->interceptInput(INPUT_RESTORE_PRESS))
+        return;
+    
     c64->cpu.setNMILineReset();
 }
 
@@ -254,6 +260,9 @@ Keyboard::releaseKey(uint8_t row, uint8_t col)
     assert(row < 8);
     assert(col < 8);
     
+    if (c64->interceptInput(INPUT_KEY_RELEASE, row, col))
+        return;
+    
     kbMatrixRow[row] |= (1 << col);
     kbMatrixCol[col] |= (1 << row);
 
@@ -309,6 +318,9 @@ Keyboard::releaseKey(C64KeyFingerprint key)
 void
 Keyboard::releaseRestoreKey()
 {
+    if (c64->interceptInput(INPUT_RESTORE_RELEASE))
+        return;
+    
     c64->cpu.clearNMILineReset();
 }
 
@@ -76,7 +76,7 @@ OldSID::OldSID()
 
 OldSID::~OldSID()
 {
-	delete ringBuffer;
+	delete [] ringBuffer;
 	ringBuffer = writeBuffer = readBuffer = endBuffer = NULL;
 }
 
@@ -21,43 +21,64 @@
 #include "C64.h"
 
 // DIRK DEBUG, REMOVE ASAP
-extern unsigned dirktrace;
-extern unsigned dirkcnt;
 
 
+/*! @brief    Expands the eight bits of a canvas byte into eight bytes
+ *  @details  The n-th byte (in memory order) is 0xFF if bit 7 - n is set and 0x00 otherwise.
+ */
+static uint64_t expandedBits[256];
+
+static void
+initExpandedBits()
+{
+    for (unsigned i = 0; i < 256; i++) {
+        uint8_t bytes[8];
+        for (unsigned n = 0; n < 8; n++)
+            bytes[n] = (i & (0x80 >> n)) ? 0xFF : 0x00;
+        memcpy(&expandedBits[i], bytes, 8);
+    }
+}
+
 PixelEngine::PixelEngine() // C64 *c64)
 {
     setDescription("PixelEngine");
     
     debug(3, "  Creating PixelEngine at address %p...\n", this);
     
-    currentScreenBuffer = screenBuffer1[0];
-    pixelBuffer = currentScreenBuffer;
+    if (expandedBits[0x80] == 0)
+        initExpandedBits();
+    
+    currentIndexBuffer = frames.backFrame()->indices[0];
+    currentScreenBuffer = frames.backFrame()->rgba[0];
+    pixelBuffer = currentIndexBuffer;
     bufferoffset = 0;
+    silent = false;
+    indexedOutput = false;
+    spanRendering = true;
 
     // Register snapshot items
     SnapshotItem items[] = {
         
         // VIC state latching
-        { &pipe.xCounter,            sizeof(pipe.xCounter),           CLEAR_ON_RESET },
-        { pipe.spriteX,              sizeof(pipe.spriteX),            CLEAR_ON_RESET | WORD_FORMAT },
-        { &pipe.spriteXexpand,       sizeof(pipe.spriteXexpand),      CLEAR_ON_RESET },
-        { &pipe.registerCTRL1,       sizeof(pipe.registerCTRL1),      CLEAR_ON_RESET },
-        { &pipe.registerCTRL2,       sizeof(pipe.registerCTRL2),      CLEAR_ON_RESET },
-        { &pipe.g_data,              sizeof(pipe.g_data),             CLEAR_ON_RESET },
-        { &pipe.g_character,         sizeof(pipe.g_character),        CLEAR_ON_RESET },
-        { &pipe.g_color,             sizeof(pipe.g_color),            CLEAR_ON_RESET },
-        { &pipe.mainFrameFF,         sizeof(pipe.mainFrameFF),        CLEAR_ON_RESET },
-        { &pipe.verticalFrameFF,     sizeof(pipe.verticalFrameFF),    CLEAR_ON_RESET },
-        
-        { &bpipe.borderColor,        sizeof(bpipe.borderColor),       CLEAR_ON_RESET },
-        { cpipe.backgroundColor,     sizeof(cpipe.backgroundColor),   CLEAR_ON_RESET | BYTE_FORMAT },
-        { spipe.spriteColor,         sizeof(spipe.spriteColor),       CLEAR_ON_RESET | BYTE_FORMAT },
-        { &spipe.spriteExtraColor1,  sizeof(spipe.spriteExtraColor1), CLEAR_ON_RESET },
-        { &spipe.spriteExtraColor2,  sizeof(spipe.spriteExtraColor2), CLEAR_ON_RESET },
-
-        { &displayMode,              sizeof(displayMode),             CLEAR_ON_RESET },
-        { NULL,                      0,                               0 }};
+        { "pipe.xCounter",           &pipe.xCounter,            sizeof(pipe.xCounter),           CLEAR_ON_RESET },
+        { "pipe.spriteX",            pipe.spriteX,              sizeof(pipe.spriteX),            CLEAR_ON_RESET | WORD_FORMAT },
+        { "pipe.spriteXexpand",      &pipe.spriteXexpand,       sizeof(pipe.spriteXexpand),      CLEAR_ON_RESET },
+        { "pipe.registerCTRL1",      &pipe.registerCTRL1,       sizeof(pipe.registerCTRL1),      CLEAR_ON_RESET },
+        { "pipe.registerCTRL2",      &pipe.registerCTRL2,       sizeof(pipe.registerCTRL2),      CLEAR_ON_RESET },
+        { "pipe.g_data",             &pipe.g_data,              sizeof(pipe.g_data),             CLEAR_ON_RESET },
+        { "pipe.g_character",        &pipe.g_character,         sizeof(pipe.g_character),        CLEAR_ON_RESET },
+        { "pipe.g_color",            &pipe.g_color,             sizeof(pipe.g_color),            CLEAR_ON_RESET },
+        { "pipe.mainFrameFF",        &pipe.mainFrameFF,         sizeof(pipe.mainFrameFF),        CLEAR_ON_RESET },
+        { "pipe.verticalFrameFF",    &pipe.verticalFrameFF,     sizeof(pipe.verticalFrameFF),    CLEAR_ON_RESET },
+        
+        { "bpipe.borderColor",       &bpipe.borderColor,        sizeof(bpipe.borderColor),       CLEAR_ON_RESET },
+        { "cpipe.backgroundColor",   cpipe.backgroundColor,     sizeof(cpipe.backgroundColor),   CLEAR_ON_RESET | BYTE_FORMAT },
+        { "spipe.spriteColor",       spipe.spriteColor,         sizeof(spipe.spriteColor),       CLEAR_ON_RESET | BYTE_FORMAT },
+        { "spipe.spriteExtraColor1", &spipe.spriteExtraColor1,  sizeof(spipe.spriteExtraColor1), CLEAR_ON_RESET },
+        { "spipe.spriteExtraColor2", &spipe.spriteExtraColor2,  sizeof(spipe.spriteExtraColor2), CLEAR_ON_RESET },
+
+        { "displayMode",             &displayMode,              sizeof(displayMode),             CLEAR_ON_RESET },
+        { NULL,                      NULL,                      0,                               0 }};
     
     registerSnapshotItems(items, sizeof(items));
 }
@@ -82,10 +103,11 @@ PixelEngine::reset()
 void
 PixelEngine::resetScreenBuffers()
 {
-    for (unsigned line = 0; line < PAL_RASTERLINES; line++) {
-        for (unsigned i = 0; i < NTSC_PIXELS; i++) {
-            screenBuffer1[line][i] = screenBuffer2[line][i] = (line % 2) ? colors[8] : colors[9];
-        }
+    for (unsigned nr = 0; nr < TripleBuffer::SLOTS; nr++) {
+        ScreenFrame *slot = frames.getSlot(nr);
+        for (unsigned line = 0; line < PAL_RASTERLINES; line++)
+            memset(slot->indices[line], (line % 2) ? 8 : 9, NTSC_PIXELS);
+        convertToRGBA(slot->indices[0], slot->rgba[0]);
     }
 }
 
@@ -98,13 +120,7 @@ PixelEngine::beginFrame()
 void
 PixelEngine::beginRasterline()
 {
-    // Clear z buffer. The buffer is initialized with the highest positive 8-bit value (meaning the pixel is far away)
-    // Not necessary, because canvas pixels are drawn first
-    // memset(zBuffer, SCHAR_MAX, sizeof(zBuffer));
-    
-    // Clear pixel source
-    // Not necessary, because canvas pixels are drawn first
-    // memset(pixelSource, 0x00, sizeof(pixelSource));
+    // Clearing foregroundMask and borderMask is not necessary, because canvas pixels are drawn first
 
     // Adjust position of first pixel in buffer (make sure that screen is always centered)
     if (c64->isPAL()) {
@@ -120,16 +136,16 @@ PixelEngine::beginRasterline()
         sprite_sr[i].col_bits = 0;
     }
     
-    // Clear pixel buffer (has same size as pixelSource and zBuffer)
-    // FOR DEBUGGING ONLY, 0xBB is a randomly chose debug color
+    // Clear the first pixel chunk
+    // FOR DEBUGGING ONLY, GREY1 is a randomly chosen debug color
     if (!vic->vblank)
-        memset(pixelBuffer, 0xBB, sizeof(pixelSource));
+        memset(pixelBuffer, GREY1, 8);
 }
 
 void
 PixelEngine::endRasterline()
 {
-    if (!vic->vblank) {
+    if (!vic->vblank && !silent) {
         
         // Make the border look nice
         expandBorders();
@@ -143,7 +159,7 @@ PixelEngine::endRasterline()
             // pxbuf += NTSC_PIXELS;
             
             // New code (slightly slower, but foolproof. Can't get outside the screen buffer)
-            pixelBuffer = currentScreenBuffer + (nextline * NTSC_PIXELS);
+            pixelBuffer = currentIndexBuffer + (nextline * NTSC_PIXELS);
             // pxbuf = pixelBuffer + bufshift;
             
         }
@@ -153,9 +169,34 @@ PixelEngine::endRasterline()
 void
 PixelEngine::endFrame()
 {
-    // Switch active screen buffer
-    currentScreenBuffer = (currentScreenBuffer == screenBuffer1[0]) ? screenBuffer2[0] : screenBuffer1[0];
-    pixelBuffer = currentScreenBuffer;    
+    // Keep showing the last synthesized frame if this one has been skipped
+    if (silent) {
+        pixelBuffer = currentIndexBuffer;
+        return;
+    }
+    
+    // Translate palette indices into RGBA values (skipped if nobody reads them)
+    if (!indexedOutput)
+        convertToRGBA(currentIndexBuffer, currentScreenBuffer);
+    
+    // Hand the frame over to the consumers and switch to the new back buffer
+    if (c64->capture.isCapturing())
+        c64->capture.recordFrame(currentIndexBuffer, c64->getFrame());
+    frames.publish(c64->getFrame());
+    currentIndexBuffer = frames.backFrame()->indices[0];
+    currentScreenBuffer = frames.backFrame()->rgba[0];
+    pixelBuffer = currentIndexBuffer;
+}
+
+void
+PixelEngine::convertToRGBA(const uint8_t *src, int *dst)
+{
+    // Work on a local copy of the palette to keep the loop free of aliasing
+    uint32_t palette[16];
+    memcpy(palette, colors, sizeof(palette));
+    
+    for (unsigned i = 0; i < PAL_RASTERLINES * NTSC_PIXELS; i++)
+        dst[i] = palette[src[i] & 0x0F];
 }
 
 // -----------------------------------------------------------------------------------------------
@@ -226,19 +267,19 @@ PixelEngine::drawBorder()
 {
     if (pipe.mainFrameFF) {
         
-        setFramePixel(0, colors[bpipe.borderColor]);
+        setFramePixel(0, bpipe.borderColor);
         
         // After the first pixel has been drawn, color register changes show up
         bpipe = vic->bp;
         
-        int rgba = colors[bpipe.borderColor];
-        setFramePixel(1, rgba);
-        setFramePixel(2, rgba);
-        setFramePixel(3, rgba);
-        setFramePixel(4, rgba);
-        setFramePixel(5, rgba);
-        setFramePixel(6, rgba);
-        setFramePixel(7, rgba);
+        uint8_t color = bpipe.borderColor;
+        setFramePixel(1, color);
+        setFramePixel(2, color);
+        setFramePixel(3, color);
+        setFramePixel(4, color);
+        setFramePixel(5, color);
+        setFramePixel(6, color);
+        setFramePixel(7, color);
     }
 }
 
@@ -248,18 +289,18 @@ PixelEngine::drawBorder17()
     if (pipe.mainFrameFF && !vic->p.mainFrameFF) {
         
         // 38 column mode
-        setFramePixel(0, colors[bpipe.borderColor]);
+        setFramePixel(0, bpipe.borderColor);
         
         // After the first pixel has been drawn, color register changes show up
         bpipe = vic->bp;
         
-        int rgba = colors[bpipe.borderColor];
-        setFramePixel(1, rgba);
-        setFramePixel(2, rgba);
-        setFramePixel(3, rgba);
-        setFramePixel(4, rgba);
-        setFramePixel(5, rgba);
-        setFramePixel(6, rgba);
+        uint8_t color = bpipe.borderColor;
+        setFramePixel(1, color);
+        setFramePixel(2, color);
+        setFramePixel(3, color);
+        setFramePixel(4, color);
+        setFramePixel(5, color);
+        setFramePixel(6, color);
         // That's all, we only draw 7 pixels here
         
     } else {
@@ -275,7 +316,7 @@ PixelEngine::drawBorder55()
     if (!pipe.mainFrameFF && vic->p.mainFrameFF) {
         
         // 38 column mode
-        setFramePixel(7, colors[bpipe.borderColor]);
+        setFramePixel(7, bpipe.borderColor);
         
     } else {
         
@@ -298,6 +339,23 @@ PixelEngine::drawCanvas()
         uint8_t D011 = vic->p.registerCTRL1 & 0x60; // -xx- ----
         uint8_t D016 = vic->p.registerCTRL2 & 0x10; // ---x ----
         
+        // Take the fast path if no register latched below changes in this cycle
+        if (spanRendering &&
+            (displayMode & 0x70) == (D011 | D016) &&
+            (pipe.registerCTRL2 & 0x10) == D016 &&
+            memcmp(&cpipe, &vic->cp, sizeof(cpipe)) == 0) {
+            
+            unsigned load = sr.canLoad ? (pipe.registerCTRL2 & 0x07) : 8;
+            if (load > 0) {
+                drawCanvasSpan(0, load);
+            }
+            if (load < 8) {
+                loadCanvasShiftRegister();
+                drawCanvasSpan(load, 8);
+            }
+            return;
+        }
+        
         drawCanvasPixel(0);
         
         // After the first pixel has been drawn, color register changes show up
@@ -334,9 +392,9 @@ PixelEngine::drawCanvas()
     } else {
         
         // "... bei gesetztem Flipflop wird die letzte aktuelle Hintergrundfarbe dargestellt."
-        int col = colors[vic->getBackgroundColor()];
+        uint8_t col = vic->getBackgroundColor();
         // The following fix (which was done for border-bm-idle is wrong)
-        // int col = col_rgba[0];
+        // uint8_t col = col_index[0];
         setEightBackgroundPixels(col);
     }
 }
@@ -347,18 +405,7 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
     assert(pixelnr < 8);
     
     if (pixelnr == (pipe.registerCTRL2 & 0x07) /* horizontal raster scroll */ && sr.canLoad) {
-        
-        // Load shift register
-        sr.data = pipe.g_data;
-        
-        // Remember how to synthesize pixels
-        sr.latchedCharacter = pipe.g_character;
-        sr.latchedColor = pipe.g_color;
-        
-        // Reset the multicolor synchronization flipflop
-        sr.mc_flop = true;
-        
-        sr.remaining_bits = 8;
+        loadCanvasShiftRegister();
     }
     
     // Clear any outstanding multicolor bit that shouldn't actually be drawn
@@ -367,9 +414,6 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
         sr.colorbits = 0;
     }
     
-    // Load colors
-    loadColors((DisplayMode)displayMode, sr.latchedCharacter, sr.latchedColor);
-    
     // Render pixel
     bool multicolorDisplayMode = (displayMode & 0x10) && ((displayMode & 0x20) || (sr.latchedColor & 0x8));
     bool generateMulticolorPixel = (pipe.registerCTRL2 & 0x10) && ((displayMode & 0x20) || (sr.latchedColor & 0x8));
@@ -388,10 +432,20 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
             sr.colorbits <<= 1;
         }
     }
-    if (multicolorDisplayMode) {
-        setMultiColorPixel(pixelnr, sr.colorbits);
+    if (silent) {
+        
+        // Only remember the pixel source (needed for collision detection)
+        bool foreground = multicolorDisplayMode ? (sr.colorbits & 0x02) : sr.colorbits;
+        setForegroundBit(pixelnr, foreground);
+        
     } else {
-        setSingleColorPixel(pixelnr, sr.colorbits);
+        
+        loadColors((DisplayMode)displayMode, sr.latchedCharacter, sr.latchedColor);
+        if (multicolorDisplayMode) {
+            setMultiColorPixel(pixelnr, sr.colorbits);
+        } else {
+            setSingleColorPixel(pixelnr, sr.colorbits);
+        }
     }
     
     // Shift register and toggle multicolor flipflop
@@ -400,6 +454,111 @@ PixelEngine::drawCanvasPixel(uint8_t pixelnr)
     sr.remaining_bits -= 1;
 }
 
+inline void
+PixelEngine::loadCanvasShiftRegister()
+{
+    // Load shift register
+    sr.data = pipe.g_data;
+    
+    // Remember how to synthesize pixels
+    sr.latchedCharacter = pipe.g_character;
+    sr.latchedColor = pipe.g_color;
+    
+    // Reset the multicolor synchronization flipflop
+    sr.mc_flop = true;
+    
+    sr.remaining_bits = 8;
+}
+
+inline void
+PixelEngine::drawCanvasSpan(unsigned first, unsigned last)
+{
+    assert(first < last && last <= 8);
+    
+    bool multicolor = (displayMode & 0x10) && ((displayMode & 0x20) || (sr.latchedColor & 0x8));
+    
+    if (!silent)
+        loadColors((DisplayMode)displayMode, sr.latchedCharacter, sr.latchedColor);
+    
+    // An odd number of remaining bits would clear the color bits between two multicolor pixels
+    bool aligned = sr.mc_flop && (sr.remaining_bits <= 0 || sr.remaining_bits >= 8 || !(sr.remaining_bits & 1));
+    
+    if (first == 0 && last == 8 && (!multicolor || aligned)) {
+        drawCanvasByte(multicolor);
+        return;
+    }
+    
+    for (unsigned pixelnr = first; pixelnr < last; pixelnr++) {
+        
+        if (!sr.remaining_bits) {
+            sr.colorbits = 0;
+        }
+        if (multicolor) {
+            if (sr.mc_flop) {
+                sr.colorbits = sr.data >> 6;
+            }
+        } else {
+            sr.colorbits = sr.data >> 7;
+        }
+        
+        if (silent) {
+            bool foreground = multicolor ? (sr.colorbits & 0x02) : sr.colorbits;
+            setForegroundBit(pixelnr, foreground);
+        } else if (multicolor) {
+            setMultiColorPixel(pixelnr, sr.colorbits);
+        } else {
+            setSingleColorPixel(pixelnr, sr.colorbits);
+        }
+        
+        sr.data <<= 1;
+        sr.mc_flop = !sr.mc_flop;
+        sr.remaining_bits -= 1;
+    }
+}
+
+inline void
+PixelEngine::drawCanvasByte(bool multicolor)
+{
+    uint8_t data = sr.data;
+    
+    // Bit pattern of the foreground pixels (one bit per pixel, leftmost pixel in bit 7)
+    uint8_t foreground;
+    
+    if (multicolor) {
+        foreground = (data & 0xAA) | ((data & 0xAA) >> 1);
+        sr.colorbits = data & 0x03;
+    } else {
+        foreground = data;
+        sr.colorbits = data & 0x01;
+    }
+    
+    foregroundMask = foreground;
+    borderMask = 0;
+    
+    if (!silent) {
+        
+        // Select the colors of all eight pixels at once
+        uint64_t pixels, mask = expandedBits[foreground];
+        uint64_t col0 = col_index[0] * 0x0101010101010101ULL;
+        uint64_t col1 = col_index[1] * 0x0101010101010101ULL;
+        
+        if (multicolor) {
+            uint64_t low = expandedBits[(data & 0x55) | ((data & 0x55) << 1)];
+            uint64_t col2 = col_index[2] * 0x0101010101010101ULL;
+            uint64_t col3 = col_index[3] * 0x0101010101010101ULL;
+            pixels = (mask & ((low & col3) | (~low & col2))) | (~mask & ((low & col1) | (~low & col0)));
+        } else {
+            pixels = (mask & col1) | (~mask & col0);
+        }
+        
+        assert(bufferoffset + 8 <= NTSC_PIXELS);
+        memcpy(pixelBuffer + bufferoffset, &pixels, 8);
+    }
+    
+    // Shift out all eight bits (the multicolor flipflop toggles back to its old value)
+    sr.data = 0;
+    sr.remaining_bits -= 8;
+}
 
 inline void
 PixelEngine::drawSprites()
@@ -413,9 +572,26 @@ PixelEngine::drawSprites()
     // Update sprite color registers
     spipe = vic->sp;
     
+    memset(spriteBits1, 0, sizeof(spriteBits1));
+    memset(spriteBits0, 0, sizeof(spriteBits0));
+    
+    // Sprites that are displayed in both halves of the chunk and whose shift register
+    // neither runs nor gets triggered produce the same color bits in all eight pixels
+    uint8_t idle = dc.spriteOnOff & dc.spriteOnOffPipe & ~(firstDMA | secondDMA);
+    for (unsigned i = 0; i < 8; i++) {
+        if (GET_BIT(idle, i)) {
+            int distance = (int)pipe.spriteX[i] - (int)pipe.xCounter;
+            bool triggers = sprite_sr[i].remaining_bits == -1 && distance >= 0 && distance < 8;
+            if (sprite_sr[i].remaining_bits > 0 || triggers)
+                CLR_BIT(idle, i);
+            else
+                drawIdleSprite(i);
+        }
+    }
+    
     // Draw first four pixels for each sprite
     for (unsigned i = 0; i < 8; i++) {
-        if (GET_BIT(dc.spriteOnOff, i)) {
+        if (GET_BIT(dc.spriteOnOff & ~idle, i)) {
 
             bool firstDMAi = GET_BIT(firstDMA, i);
             bool secondDMAi = GET_BIT(secondDMA, i);
@@ -433,6 +609,12 @@ PixelEngine::drawSprites()
     for (unsigned i = 0; i < 8; i++) {
         if (GET_BIT(dc.spriteOnOff, i)) {
 
+            // If spriteXexpand has changed, it shows up after pixel 5
+            if (GET_BIT(idle, i)) {
+                COPY_BIT(vic->p.spriteXexpand, pipe.spriteXexpand, i);
+                continue;
+            }
+            
             bool firstDMAi = GET_BIT(firstDMA, i);
             bool secondDMAi = GET_BIT(secondDMA, i);
 
@@ -446,6 +628,24 @@ PixelEngine::drawSprites()
             drawSpritePixel(i, 7, firstDMAi              /* freeze */, 0         /* halt */, 0          /* load */);
         }
     }
+    
+    composeSprites();
+}
+
+inline void
+PixelEngine::drawIdleSprite(unsigned spritenr)
+{
+    if (visibleColumn && vic->drawSprites) {
+        
+        uint8_t col_bits = sprite_sr[spritenr].col_bits;
+        
+        if (vic->spriteIsMulticolor(spritenr)) {
+            spriteBits1[spritenr] = (col_bits & 0x02) ? 0xFF : 0x00;
+            spriteBits0[spritenr] = (col_bits & 0x01) ? 0xFF : 0x00;
+        } else {
+            spriteBits1[spritenr] = (col_bits & 0x01) ? 0xFF : 0x00;
+        }
+    }
 }
 
 void
@@ -501,15 +701,90 @@ PixelEngine::drawSpritePixel(unsigned spritenr, unsigned pixelnr, bool freeze, b
         }
     }
     
-    // Draw pixel
+    // Remember pixel (drawn in composeSprites)
     if (visibleColumn && vic->drawSprites) {
-        if (multicol)
-            setMultiColorSpritePixel(spritenr, pixelnr, sprite_sr[spritenr].col_bits & 0x03);
-        else
-            setSingleColorSpritePixel(spritenr, pixelnr, sprite_sr[spritenr].col_bits & 0x01);
+        uint8_t mask = 0x80 >> pixelnr;
+        if (multicol) {
+            if (sprite_sr[spritenr].col_bits & 0x02) spriteBits1[spritenr] |= mask;
+            if (sprite_sr[spritenr].col_bits & 0x01) spriteBits0[spritenr] |= mask;
+        } else {
+            if (sprite_sr[spritenr].col_bits & 0x01) spriteBits1[spritenr] |= mask;
+        }
     }
 }
 
+void
+PixelEngine::composeSprites()
+{
+    uint8_t opaque[8];
+    uint8_t covered = 0;  // Pixels covered by at least one sprite
+    uint8_t multiple = 0; // Pixels covered by at least two sprites
+    
+    for (unsigned i = 0; i < 8; i++) {
+        opaque[i] = spriteBits1[i] | spriteBits0[i];
+        multiple |= covered & opaque[i];
+        covered |= opaque[i];
+    }
+    
+    if (!covered)
+        return;
+    
+    // Check sprite/sprite collision
+    if (multiple && vic->spriteSpriteCollisionEnabled) {
+        uint8_t collided = 0;
+        for (unsigned i = 0; i < 8; i++) {
+            if (opaque[i] & multiple) collided |= (1 << i);
+        }
+        vic->iomem[0x1E] |= collided;
+        vic->triggerIRQ(4);
+    }
+    
+    // Check sprite/background collision
+    if ((covered & foregroundMask) && vic->spriteBackgroundCollisionEnabled) {
+        uint8_t collided = 0;
+        for (unsigned i = 0; i < 8; i++) {
+            if (opaque[i] & foregroundMask) collided |= (1 << i);
+        }
+        vic->iomem[0x1F] |= collided;
+        vic->triggerIRQ(2);
+    }
+    
+    if (silent)
+        return;
+    
+    // Draw pixels. A sprite pixel hides the pixels of all sprites with a higher number, even if
+    // it is hidden itself by the foreground.
+    uint64_t pixels;
+    uint8_t available = ~borderMask;
+    
+    assert(bufferoffset + 8 <= NTSC_PIXELS);
+    memcpy(&pixels, pixelBuffer + bufferoffset, 8);
+    
+    for (unsigned i = 0; i < 8 && available; i++) {
+        
+        uint8_t visible = opaque[i] & available;
+        available &= ~opaque[i];
+        
+        if (vic->spriteIsDrawnInBackground(i))
+            visible &= ~foregroundMask;
+        if (!visible)
+            continue;
+        
+        // Color bits '01', '10', '11' select extra color 1, sprite color, extra color 2
+        uint64_t bits1 = expandedBits[spriteBits1[i]];
+        uint64_t bits0 = expandedBits[spriteBits0[i]];
+        uint64_t extra1 = spipe.spriteExtraColor1 * 0x0101010101010101ULL;
+        uint64_t color = spipe.spriteColor[i] * 0x0101010101010101ULL;
+        uint64_t extra2 = spipe.spriteExtraColor2 * 0x0101010101010101ULL;
+        uint64_t colors = (bits1 & ((bits0 & extra2) | (~bits0 & color))) | (~bits1 & extra1);
+        uint64_t mask = expandedBits[visible];
+        
+        pixels = (pixels & ~mask) | (colors & mask);
+    }
+    
+    memcpy(pixelBuffer + bufferoffset, &pixels, 8);
+}
+
 // -----------------------------------------------------------------------------------------------
 //                         Mid level drawing (semantic pixel rendering)
 // -----------------------------------------------------------------------------------------------
@@ -521,56 +796,56 @@ PixelEngine::loadColors(DisplayMode mode, uint8_t characterSpace, uint8_t colorS
             
         case STANDARD_TEXT:
             
-            col_rgba[0] = colors[cpipe.backgroundColor[0]];
-            col_rgba[1] = colors[colorSpace];
+            col_index[0] = cpipe.backgroundColor[0];
+            col_index[1] = colorSpace;
             break;
             
         case MULTICOLOR_TEXT:
             if (colorSpace & 0x8 /* MC flag */) {
-                col_rgba[0] = colors[cpipe.backgroundColor[0]];
-                col_rgba[1] = colors[cpipe.backgroundColor[1]];
-                col_rgba[2] = colors[cpipe.backgroundColor[2]];
-                col_rgba[3] = colors[colorSpace & 0x07];
+                col_index[0] = cpipe.backgroundColor[0];
+                col_index[1] = cpipe.backgroundColor[1];
+                col_index[2] = cpipe.backgroundColor[2];
+                col_index[3] = colorSpace & 0x07;
             } else {
-                col_rgba[0] = colors[cpipe.backgroundColor[0]];
-                col_rgba[1] = colors[colorSpace];
+                col_index[0] = cpipe.backgroundColor[0];
+                col_index[1] = colorSpace;
             }
             break;
             
         case STANDARD_BITMAP:
-            col_rgba[0] = colors[characterSpace & 0x0F]; // color of '0' pixels
-            col_rgba[1] = colors[characterSpace >> 4]; // color of '1' pixels
+            col_index[0] = characterSpace & 0x0F; // color of '0' pixels
+            col_index[1] = characterSpace >> 4; // color of '1' pixels
             break;
             
         case MULTICOLOR_BITMAP:
-            col_rgba[0] = colors[cpipe.backgroundColor[0]];
-            col_rgba[1] = colors[characterSpace >> 4];
-            col_rgba[2] = colors[characterSpace & 0x0F];
-            col_rgba[3] = colors[colorSpace];
+            col_index[0] = cpipe.backgroundColor[0];
+            col_index[1] = characterSpace >> 4;
+            col_index[2] = characterSpace & 0x0F;
+            col_index[3] = colorSpace;
             break;
             
         case EXTENDED_BACKGROUND_COLOR:
-            col_rgba[0] = colors[cpipe.backgroundColor[characterSpace >> 6]];
-            col_rgba[1] = colors[colorSpace];
+            col_index[0] = cpipe.backgroundColor[characterSpace >> 6];
+            col_index[1] = colorSpace;
             break;
             
         case INVALID_TEXT:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
-            col_rgba[2] = colors[PixelEngine::BLACK];
-            col_rgba[3] = colors[PixelEngine::BLACK];
+            col_index[0] = PixelEngine::BLACK;
+            col_index[1] = PixelEngine::BLACK;
+            col_index[2] = PixelEngine::BLACK;
+            col_index[3] = PixelEngine::BLACK;
             break;
             
         case INVALID_STANDARD_BITMAP:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
+            col_index[0] = PixelEngine::BLACK;
+            col_index[1] = PixelEngine::BLACK;
             break;
             
         case INVALID_MULTICOLOR_BITMAP:
-            col_rgba[0] = colors[PixelEngine::BLACK];
-            col_rgba[1] = colors[PixelEngine::BLACK];
-            col_rgba[2] = colors[PixelEngine::BLACK];
-            col_rgba[3] = colors[PixelEngine::BLACK];
+            col_index[0] = PixelEngine::BLACK;
+            col_index[1] = PixelEngine::BLACK;
+            col_index[2] = PixelEngine::BLACK;
+            col_index[3] = PixelEngine::BLACK;
             break;
             
         default:
@@ -582,146 +857,80 @@ PixelEngine::loadColors(DisplayMode mode, uint8_t characterSpace, uint8_t colorS
 inline void
 PixelEngine::setSingleColorPixel(unsigned pixelnr, uint8_t bit /* valid: 0, 1 */)
 {
-    int rgba = col_rgba[bit];
+    uint8_t color = col_index[bit];
     
     if (bit)
-        setForegroundPixel(pixelnr, rgba);
+        setForegroundPixel(pixelnr, color);
     else
-        setBackgroundPixel(pixelnr, rgba);
+        setBackgroundPixel(pixelnr, color);
 }
 
 inline void
 PixelEngine::setMultiColorPixel(unsigned pixelnr, uint8_t two_bits /* valid: 00, 01, 10, 11 */)
 {
-    int rgba = col_rgba[two_bits];
+    uint8_t color = col_index[two_bits];
     
     if (two_bits & 0x02)
-        setForegroundPixel(pixelnr, rgba);
+        setForegroundPixel(pixelnr, color);
     else
-        setBackgroundPixel(pixelnr, rgba);
+        setBackgroundPixel(pixelnr, color);
 }
 
-inline void
-PixelEngine::setSingleColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t bit)
-{
-    if (bit) {
-        int rgba = colors[spipe.spriteColor[spritenr]];
-        setSpritePixel(pixelnr, rgba, spritenr);
-    }
-}
-
-inline void
-PixelEngine::setMultiColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t two_bits)
-{
-    int rgba;
-    
-    switch (two_bits) {
-        case 0x01:
-            rgba = colors[spipe.spriteExtraColor1];
-            setSpritePixel(pixelnr, rgba, spritenr);
-            break;
-            
-        case 0x02:
-            rgba = colors[spipe.spriteColor[spritenr]];
-            setSpritePixel(pixelnr, rgba, spritenr);
-            break;
-            
-        case 0x03:
-            rgba = colors[spipe.spriteExtraColor2];
-            setSpritePixel(pixelnr, rgba, spritenr);
-            break;
-    }
-}
-
-
-inline void
-PixelEngine::setSpritePixel(unsigned pixelnr, int color, int nr)
-{
-    uint8_t mask = (1 << nr);
-    
-    // Check sprite/sprite collision
-    if (vic->spriteSpriteCollisionEnabled && (pixelSource[pixelnr] & 0x7F)) {
-        vic->iomem[0x1E] |= ((pixelSource[pixelnr] & 0x7F) | mask);
-        vic->triggerIRQ(4);
-    }
-        
-    // Check sprite/background collision
-    if (vic->spriteBackgroundCollisionEnabled && (pixelSource[pixelnr] & 0x80)) {
-        vic->iomem[0x1F] |= mask;
-        vic->triggerIRQ(2);
-    }
-        
-    if (nr == 7)
-        mask = 0;
-        
-    setSpritePixel(pixelnr, color, vic->spriteDepth(nr), mask);
-}
-
-
 // -----------------------------------------------------------------------------------------------
 //                        Low level drawing (pixel buffer access)
 // -----------------------------------------------------------------------------------------------
 
 inline void
-PixelEngine::setFramePixel(unsigned pixelnr, int rgba)
+PixelEngine::setFramePixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
     
-    pixelBuffer[offset] = rgba;
-    zBuffer[pixelnr] = BORDER_LAYER_DEPTH;
-    pixelSource[pixelnr] &= (~0x80); // disable sprite/foreground collision detection in border
+    if (!silent) {
+        pixelBuffer[offset] = color;
+    }
+    borderMask |= (0x80 >> pixelnr);
+    foregroundMask &= ~(0x80 >> pixelnr); // disable sprite/foreground collision detection in border
 }
 
 inline void
-PixelEngine::setForegroundPixel(unsigned pixelnr, int rgba)
+PixelEngine::setForegroundPixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
 
-    // The zBuffer check is not necessary as the canvas pixels are the first to draw
-    // if (FOREGROUND_LAYER_DEPTH <= zBuffer[offset])
-    {
-        pixelBuffer[offset] = rgba;
-        zBuffer[pixelnr] = FOREGROUND_LAYER_DEPTH;
-        pixelSource[pixelnr] = 0x80;
-    }
+    // No priority check is necessary as the canvas pixels are the first to draw
+    pixelBuffer[offset] = color;
+    setForegroundBit(pixelnr, true);
 }
 
 inline void
-PixelEngine::setBackgroundPixel(unsigned pixelnr, int rgba)
+PixelEngine::setBackgroundPixel(unsigned pixelnr, uint8_t color)
 {
     unsigned offset = bufferoffset + pixelnr;
     assert(offset < NTSC_PIXELS);
 
-    // The zBuffer check is not necessary as the canvas pixels are the first to draw
-    // if (BACKGROUD_LAYER_DEPTH <= zBuffer[offset])
-    {
-        pixelBuffer[offset] = rgba;
-        zBuffer[pixelnr] = BACKGROUD_LAYER_DEPTH;
-        pixelSource[pixelnr] = 0x00;
+    // No priority check is necessary as the canvas pixels are the first to draw
+    if (!silent) {
+        pixelBuffer[offset] = color;
     }
-
+    setForegroundBit(pixelnr, false);
 }
 
-void
-PixelEngine::setSpritePixel(unsigned pixelnr, int rgba, int depth, int source)
+inline void
+PixelEngine::setForegroundBit(unsigned pixelnr, bool foreground)
 {
-    unsigned offset = bufferoffset + pixelnr;
-    assert(offset < NTSC_PIXELS);
+    uint8_t mask = 0x80 >> pixelnr;
     
-    if (depth <= zBuffer[pixelnr] && !(pixelSource[pixelnr] & 0x7F)) {
-        pixelBuffer[offset] = rgba;
-        zBuffer[pixelnr] = depth;
-    }
-    pixelSource[pixelnr] |= source;
-
+    foregroundMask = foreground ? (foregroundMask | mask) : (foregroundMask & ~mask);
+    borderMask &= ~mask;
 }
 
 void
 PixelEngine::expandBorders()
 {
-    int color, lastX;
+    uint8_t color;
+    int lastX;
     unsigned leftPixelPos;
     unsigned rightPixelPos;
     
@@ -736,24 +945,24 @@ PixelEngine::expandBorders()
     }
     
     // Make picked pixels visible for debugging
-    // pixelBuffer[leftPixelPos + 1] = colors[5];
-    // pixelBuffer[rightPixelPos - 1] = colors[5];
+    // pixelBuffer[leftPixelPos + 1] = 5;
+    // pixelBuffer[rightPixelPos - 1] = 5;
     
     color = pixelBuffer[leftPixelPos];
     for (unsigned i = 0; i < leftPixelPos; i++) {
         pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
+        // pixelBuffer[i] = 5; // for debugging
     }
     color = pixelBuffer[rightPixelPos];
     for (unsigned i = rightPixelPos+1; i < lastX; i++) {
         pixelBuffer[i] = color;
-        // pixelBuffer[i] = colors[5]; // for debugging
+        // pixelBuffer[i] = 5; // for debugging
     }
 
     /*
     // Draw grid lines
     for (unsigned i = 0; i < NTSC_PIXELS; i += 10)
-    pixelBuffer[i] = 0xFFFFFFFF;
+    pixelBuffer[i] = WHITE;
     */
 }
 
@@ -762,8 +971,7 @@ PixelEngine::markLine(uint8_t color, unsigned start, unsigned end)
 {
     assert (end <= NTSC_PIXELS);
     
-    int rgba = colors[color];
     for (unsigned i = start; i < end; i++) {
-        pixelBuffer[start + i] = rgba;
+        pixelBuffer[start + i] = color;
     }	
 }
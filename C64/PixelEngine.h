@@ -24,6 +24,7 @@
 #include "VirtualComponent.h"
 #include "VIC_globals.h"
 #include "C64_defs.h"
+#include "TripleBuffer.h"
 
 // Forward declarations
 class VIC;
@@ -134,46 +135,51 @@ private:
         LO_LO_HI_HI(0xc0, 0xc0, 0xc0, 0xFF)
     };
     
-    /*! @brief    First screen buffer
-     *  @details  The VIC chip writes it output into this buffer. The contents of the array is 
-     *            later copied into to texture RAM of your graphic card by the drawRect method 
-     *            in the GPU related code. 
+    /*! @brief    Screen buffers
+     *  @details  The VIC chip writes its output into the back buffer of this triple buffer.
+     *            Each pixel is stored as a palette index (0 to 15). The RGBA values are looked up
+     *            once per frame when the frame is complete (see indexedOutput). Afterwards, the
+     *            frame is published to the GPU code and all other consumers.
      */
-    int screenBuffer1[PAL_RASTERLINES][NTSC_PIXELS];
+    TripleBuffer frames;
     
-    /*! @brief    Second screen buffer
-     *  @details  The VIC chip uses double buffering. Once a frame is drawn, the VIC chip writes 
-     *            the next frame to the second buffer. 
+    /*! @brief    Target index buffer for all rendering methods
+     *  @details  The variable points to the indices of the back buffer in frames
      */
-    int screenBuffer2[PAL_RASTERLINES][NTSC_PIXELS];
+    uint8_t *currentIndexBuffer;
     
-    /*! @brief    Target screen buffer for all rendering methods
-     *  @details  The variable points either to screenBuffer1 or screenBuffer2 
-     */
+    //! @brief    Screen buffer belonging to currentIndexBuffer
     int *currentScreenBuffer;
     
     /*! @brief    Pointer to the beginning of the current rasterline
      *  @details  This pointer is used by all rendering methods to write pixels. It always points 
-     *            to the beginning of a rasterline, either in screenBuffer1 or screenBuffer2. 
+     *            to the beginning of a rasterline in currentIndexBuffer.
      *            It is reset at the beginning of each frame and incremented at the beginning of 
      *            each rasterline. 
      */
-    int *pixelBuffer;
+    uint8_t *pixelBuffer;
         
-    /*! @brief    Z buffer
-     *  @details  Virtual VICII uses depth buffering to determine pixel priority. In the various
-     *            render routines, a pixel is only written to the screen buffer, if it is closer 
-     *            to the view point. The depth of the closest pixel is kept in the z buffer. 
-     *            The lower the value of the z buffer, the closer it is to the viewer. 
+    /*! @brief    Foreground pixels of the current 8 pixel chunk
+     *  @details  Bit 7 - n is set if the n-th pixel has been drawn as a canvas foreground pixel
+     *            and is not covered by the border. The information is utilized to determine
+     *            sprite priorities and to detect sprite-background collisions.
+     */
+    uint8_t foregroundMask;
+    
+    /*! @brief    Border pixels of the current 8 pixel chunk
+     *  @details  Bit 7 - n is set if the n-th pixel has been drawn as a border pixel. The border
+     *            is in front of all sprites.
      */
-    int zBuffer[8];
+    uint8_t borderMask;
     
-    /*! @brief    Indicates the source of a drawn pixel
-     *  @details  Whenever a foreground pixel or sprite pixel is drawn, a distinct bit in the 
-     *            pixelSource array is set. The information is utilized to detect sprite-sprite 
-     *            and sprite-background collisions. 
+    /*! @brief    Sprite pixels of the current 8 pixel chunk
+     *  @details  The sprite sequencers store the color bits of sprite i in spriteBits1[i] (upper
+     *            bit) and spriteBits0[i] (lower bit). Bit 7 - n refers to the n-th pixel. Single
+     *            color sprites only use the upper bit, because '10' selects the sprite color in
+     *            multicolor mode, too. The pixels are drawn by composeSprites().
      */
-    int pixelSource[8];
+    uint8_t spriteBits1[8];
+    uint8_t spriteBits0[8];
     
     /*! @brief    Offset into pixelBuffer
      *  @details  Variable points to the first pixel of the currently drawn 8 pixel chunk 
@@ -182,11 +188,24 @@ private:
     
 public:
     
-    /*! @brief    Get screen buffer that is currently stable
-     *  @details  This method is called by the GPU code at the beginning of each frame. 
+    /*! @brief    Get screen buffer of the latest published frame
+     *  @details  The buffer is not pinned and may be drawn into at any time.
+     *  @note     Only use within the emulation thread or on halted emulators. All other
+     *            consumers have to use frames.acquire() and frames.release().
+     */
+    inline void *screenBuffer() { return frames.latestFrame()->rgba[0]; }
+
+    /*! @brief    Get index buffer of the latest published frame
+     *  @details  Each pixel is a palette index. The RGBA values are provided by getColors().
+     */
+    inline uint8_t *screenIndexBuffer() { return frames.latestFrame()->indices[0]; }
+    
+    /*! @brief    Indicates if the consumer reads the index buffer instead of the screen buffer
+     *  @details  If false, each completed frame is converted to RGBA in endFrame(). If true, the
+     *            conversion is skipped and the screen buffers are no longer updated. Changing
+     *            the color scheme is free in this mode, because it only affects the palette.
      */
-    inline void *screenBuffer() {
-        return (currentScreenBuffer == screenBuffer1[0]) ? screenBuffer2[0] : screenBuffer1[0]; }
+    bool indexedOutput;
 
     
     // -----------------------------------------------------------------------------------------------
@@ -202,6 +221,23 @@ private:
      */
     bool visibleColumn;
     
+public:
+    
+    /*! @brief    Indicates if pixel synthesis is skipped
+     *  @details  In silent mode, shift registers and pipes are updated and collisions are detected
+     *            as usual, but no colors are looked up and the screen buffers stay untouched.
+     *            Frames ending in silent mode are not swapped in, so the stable screen buffer
+     *            keeps the last synthesized frame. The flag is set per frame by class C64.
+     */
+    bool silent;
+    
+    /*! @brief    Indicates if canvas pixels are synthesized in chunks
+     *  @details  If no register affecting the canvas changes in the middle of an 8 pixel chunk,
+     *            drawCanvas() renders the chunk in one go instead of pixel by pixel. The result is
+     *            the same. The option only exists to compare both code paths.
+     */
+    bool spanRendering;
+    
     
     // -----------------------------------------------------------------------------------------------
     //                                    Execution functions
@@ -220,6 +256,9 @@ public:
     
     //! @brief    Finishes up a frame
     void endFrame();
+    
+    //! @brief    Converts a frame of palette indices into RGBA values
+    void convertToRGBA(const uint8_t *src, int *dst);
 
     
     // -----------------------------------------------------------------------------------------------
@@ -427,6 +466,23 @@ private:
      */
     void drawCanvasPixel(uint8_t pixelnr);
     
+    //! @brief    Loads the canvas shift register with the latched graphics data
+    void loadCanvasShiftRegister();
+    
+    /*! @brief    Draws a range of canvas pixels with unchanged display mode and colors
+     *  @details  Fast path of drawCanvas(). The range must not contain a shift register load
+     *            except at its first pixel.
+     *  @param    first  First pixel to draw (0 to 7)
+     *  @param    last   Pixel after the last pixel to draw (1 to 8)
+     */
+    void drawCanvasSpan(unsigned first, unsigned last);
+    
+    /*! @brief    Draws all eight canvas pixels from the current shift register contents
+     *  @details  Invoked by drawCanvasSpan(). In multicolor mode, the multicolor flipflop must
+     *            be set when calling this function.
+     */
+    void drawCanvasByte(bool multicolor);
+    
     /*! @brief    Draws 8 sprite pixels
      *  @details  Invoked inside draw() 
      */
@@ -449,6 +505,17 @@ private:
      */
     void drawSpritePixel(unsigned spritenr, unsigned pixelnr, bool freeze, bool halt, bool load);
 
+    /*! @brief    Fills in the pixels of a sprite whose shift register is idle in this chunk
+     *  @details  Fast path of drawSprites(). The color bits stay the same for all eight pixels.
+     */
+    void drawIdleSprite(unsigned spritenr);
+    
+    /*! @brief    Draws the sprite pixels of the current chunk and detects collisions
+     *  @details  Invoked at the end of drawSprites(). Lower sprite numbers have higher priority.
+     *            All checks are done for eight pixels at once on the bit masks of each sprite.
+     */
+    void composeSprites();
+
     /*! @brief    Draws all sprites into the pixelbuffer
      *  @details  A sprite is only drawn if it's enabled and if sprite drawing is not switched off for debugging 
      */
@@ -466,13 +533,13 @@ private:
 
 private:
     
-    /*! @brief    This is where loadColors() stores all retrieved colors
+    /*! @brief    This is where loadColors() stores all retrieved colors (palette indices)
      *  @details  [0] : color for '0' pixels in single color mode or '00' pixels in multicolor mode
      *            [1] : color for '1' pixels in single color mode or '01' pixels in multicolor mode
      *            [2] : color for '10' pixels in multicolor mode
      *            [3] : color for '11' pixels in multicolor mode 
      */
-    int col_rgba[4];
+    uint8_t col_index[4];
 
 public:
     
@@ -490,22 +557,6 @@ public:
      *            Uses the drawing colors that are setup by loadColors(). 
      */
     void setMultiColorPixel(unsigned pixelnr, uint8_t two_bits);
-    
-    /*! @brief    Draws single sprite pixel in single-color mode
-     *  @details  Uses the drawing colors that are setup by updateSpriteColors 
-     */
-    void setSingleColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t bit);
-    
-    /*! @brief    Draws single sprite pixel in multi-color mode
-     *  @details  Uses the drawing colors that are setup by updateSpriteColors 
-     */
-    void setMultiColorSpritePixel(unsigned spritenr, unsigned pixelnr, uint8_t two_bits);
-
-    /*! @brief    Draws a single sprite pixel
-     *  @details  This function is invoked by setSingleColorPixel() and setMultiColorPixel().
-     *            It takes care of collison and invokes setSpritePixel(4) to actually render the pixel. 
-     */
-    void setSpritePixel(unsigned pixelnr, int color, int nr);
 
     
     // -----------------------------------------------------------------------------------------------
@@ -515,20 +566,20 @@ public:
 public:
 
     //! @brief    Draw a single frame pixel
-    void setFramePixel(unsigned pixelnr, int rgba);
+    void setFramePixel(unsigned pixelnr, uint8_t color);
     
     //! @brief    Draw a single foreground pixel
-    void setForegroundPixel(unsigned pixelnr, int rgba);
+    void setForegroundPixel(unsigned pixelnr, uint8_t color);
     
     //! @brief    Draw a single background pixel
-    void setBackgroundPixel(unsigned pixelnr, int rgba);
+    void setBackgroundPixel(unsigned pixelnr, uint8_t color);
 
     //! @brief    Draw eight background pixels in a row
-    inline void setEightBackgroundPixels(int rgba) {
-        for (unsigned i = 0; i < 8; i++) setBackgroundPixel(i, rgba); }
+    inline void setEightBackgroundPixels(uint8_t color) {
+        for (unsigned i = 0; i < 8; i++) setBackgroundPixel(i, color); }
 
-    //! @brief    Draw a single sprite pixel
-    void setSpritePixel(unsigned pixelnr, int rgba, int depth, int source);
+    //! @brief    Updates foregroundMask and borderMask for a single canvas pixel
+    void setForegroundBit(unsigned pixelnr, bool foreground);
 
     /*! @brief    Extend border to the left and right to look nice.
      *  @details  This functions replicates the color of the leftmost and rightmost pixel 
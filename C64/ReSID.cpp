@@ -29,48 +29,48 @@ ReSID::ReSID()
     SnapshotItem items[] = {
         
         // Configuration items
-        { &chipModel,           sizeof(chipModel),              KEEP_ON_RESET },
-        { &sampleRate,          sizeof(sampleRate),             KEEP_ON_RESET },
-        { &samplingMethod,      sizeof(samplingMethod),         KEEP_ON_RESET },
-        { &cpuFrequency,        sizeof(cpuFrequency),           KEEP_ON_RESET },
-        { &audioFilter,         sizeof(audioFilter),            KEEP_ON_RESET },
-        { &externalAudioFilter, sizeof(externalAudioFilter),    KEEP_ON_RESET },
-        { &volume,              sizeof(volume),                 KEEP_ON_RESET },
-        { &targetVolume,        sizeof(targetVolume),           KEEP_ON_RESET },
+        { "chipModel",                        &chipModel,           sizeof(chipModel),              KEEP_ON_RESET },
+        { "sampleRate",                       &sampleRate,          sizeof(sampleRate),             KEEP_ON_RESET },
+        { "samplingMethod",                   &samplingMethod,      sizeof(samplingMethod),         KEEP_ON_RESET },
+        { "cpuFrequency",                     &cpuFrequency,        sizeof(cpuFrequency),           KEEP_ON_RESET },
+        { "audioFilter",                      &audioFilter,         sizeof(audioFilter),            KEEP_ON_RESET },
+        { "externalAudioFilter",              &externalAudioFilter, sizeof(externalAudioFilter),    KEEP_ON_RESET },
+        { "volume",                           &volume,              sizeof(volume),                 KEEP_ON_RESET },
+        { "targetVolume",                     &targetVolume,        sizeof(targetVolume),           KEEP_ON_RESET },
         
         // ReSID state
-        { st.sid_register,                  sizeof(st.sid_register),                    KEEP_ON_RESET },
-        { &st.bus_value,                    sizeof(st.bus_value),                       KEEP_ON_RESET },
-        { &st.bus_value_ttl,                sizeof(st.bus_value_ttl),                   KEEP_ON_RESET },
-        { &st.accumulator[0],               sizeof(st.accumulator[0]),                  KEEP_ON_RESET },
-        { &st.accumulator[1],               sizeof(st.accumulator[1]),                  KEEP_ON_RESET },
-        { &st.accumulator[2],               sizeof(st.accumulator[2]),                  KEEP_ON_RESET },
-        { &st.shift_register[0],            sizeof(&st.shift_register[0]),              KEEP_ON_RESET },
-        { &st.shift_register[1],            sizeof(&st.shift_register[1]),              KEEP_ON_RESET },
-        { &st.shift_register[2],            sizeof(&st.shift_register[2]),              KEEP_ON_RESET },
-        { &st.rate_counter[0],              sizeof(st.rate_counter[0]),                 KEEP_ON_RESET },
-        { &st.rate_counter[1],              sizeof(st.rate_counter[1]),                 KEEP_ON_RESET },
-        { &st.rate_counter[2],              sizeof(st.rate_counter[2]),                 KEEP_ON_RESET },
-        { &st.rate_counter_period[0],       sizeof(st.rate_counter_period[0]),          KEEP_ON_RESET },
-        { &st.rate_counter_period[1],       sizeof(st.rate_counter_period[1]),          KEEP_ON_RESET },
-        { &st.rate_counter_period[2],       sizeof(st.rate_counter_period[2]),          KEEP_ON_RESET },
-        { &st.exponential_counter[0],       sizeof(st.exponential_counter[0]),          KEEP_ON_RESET },
-        { &st.exponential_counter[1],       sizeof(st.exponential_counter[1]),          KEEP_ON_RESET },
-        { &st.exponential_counter[2],       sizeof(st.exponential_counter[2]),          KEEP_ON_RESET },
-        { &st.exponential_counter_period[0],sizeof(st.exponential_counter_period[0]),   KEEP_ON_RESET },
-        { &st.exponential_counter_period[1],sizeof(st.exponential_counter_period[1]),   KEEP_ON_RESET },
-        { &st.exponential_counter_period[2],sizeof(st.exponential_counter_period[2]),   KEEP_ON_RESET },
-        { &st.envelope_counter[0],          sizeof(st.envelope_counter[0]),             KEEP_ON_RESET },
-        { &st.envelope_counter[1],          sizeof(st.envelope_counter[1]),             KEEP_ON_RESET },
-        { &st.envelope_counter[2],          sizeof(st.envelope_counter[2]),             KEEP_ON_RESET },
-        { &st.envelope_state[0],            sizeof(st.envelope_state[0]),               KEEP_ON_RESET },
-        { &st.envelope_state[1],            sizeof(st.envelope_state[1]),               KEEP_ON_RESET },
-        { &st.envelope_state[2],            sizeof(st.envelope_state[2]),               KEEP_ON_RESET },
-        { &st.hold_zero[0],                 sizeof(st.hold_zero[0]),                    KEEP_ON_RESET },
-        { &st.hold_zero[1],                 sizeof(st.hold_zero[1]),                    KEEP_ON_RESET },
-        { &st.hold_zero[2],                 sizeof(st.hold_zero[2]),                    KEEP_ON_RESET },
+        { "st.sid_register",                  st.sid_register,                  sizeof(st.sid_register),                    KEEP_ON_RESET },
+        { "st.bus_value",                     &st.bus_value,                    sizeof(st.bus_value),                       KEEP_ON_RESET },
+        { "st.bus_value_ttl",                 &st.bus_value_ttl,                sizeof(st.bus_value_ttl),                   KEEP_ON_RESET },
+        { "st.accumulator[0]",                &st.accumulator[0],               sizeof(st.accumulator[0]),                  KEEP_ON_RESET },
+        { "st.accumulator[1]",                &st.accumulator[1],               sizeof(st.accumulator[1]),                  KEEP_ON_RESET },
+        { "st.accumulator[2]",                &st.accumulator[2],               sizeof(st.accumulator[2]),                  KEEP_ON_RESET },
+        { "st.shift_register[0]",             &st.shift_register[0],            sizeof(&st.shift_register[0]),              KEEP_ON_RESET },
+        { "st.shift_register[1]",             &st.shift_register[1],            sizeof(&st.shift_register[1]),              KEEP_ON_RESET },
+        { "st.shift_register[2]",             &st.shift_register[2],            sizeof(&st.shift_register[2]),              KEEP_ON_RESET },
+        { "st.rate_counter[0]",               &st.rate_counter[0],              sizeof(st.rate_counter[0]),                 KEEP_ON_RESET },
+        { "st.rate_counter[1]",               &st.rate_counter[1],              sizeof(st.rate_counter[1]),                 KEEP_ON_RESET },
+        { "st.rate_counter[2]",               &st.rate_counter[2],              sizeof(st.rate_counter[2]),                 KEEP_ON_RESET },
+        { "st.rate_counter_period[0]",        &st.rate_counter_period[0],       sizeof(st.rate_counter_period[0]),          KEEP_ON_RESET },
+        { "st.rate_counter_period[1]",        &st.rate_counter_period[1],       sizeof(st.rate_counter_period[1]),          KEEP_ON_RESET },
+        { "st.rate_counter_period[2]",        &st.rate_counter_period[2],       sizeof(st.rate_counter_period[2]),          KEEP_ON_RESET },
+        { "st.exponential_counter[0]",        &st.exponential_counter[0],       sizeof(st.exponential_counter[0]),          KEEP_ON_RESET },
+        { "st.exponential_counter[1]",        &st.exponential_counter[1],       sizeof(st.exponential_counter[1]),          KEEP_ON_RESET },
+        { "st.exponential_counter[2]",        &st.exponential_counter[2],       sizeof(st.exponential_counter[2]),          KEEP_ON_RESET },
+        { "st.exponential_counter_period[0]", &st.exponential_counter_period[0],sizeof(st.exponential_counter_period[0]),   KEEP_ON_RESET },
+        { "st.exponential_counter_period[1]", &st.exponential_counter_period[1],sizeof(st.exponential_counter_period[1]),   KEEP_ON_RESET },
+        { "st.exponential_counter_period[2]", &st.exponential_counter_period[2],sizeof(st.exponential_counter_period[2]),   KEEP_ON_RESET },
+        { "st.envelope_counter[0]",           &st.envelope_counter[0],          sizeof(st.envelope_counter[0]),             KEEP_ON_RESET },
+        { "st.envelope_counter[1]",           &st.envelope_counter[1],          sizeof(st.envelope_counter[1]),             KEEP_ON_RESET },
+        { "st.envelope_counter[2]",           &st.envelope_counter[2],          sizeof(st.envelope_counter[2]),             KEEP_ON_RESET },
+        { "st.envelope_state[0]",             &st.envelope_state[0],            sizeof(st.envelope_state[0]),               KEEP_ON_RESET },
+        { "st.envelope_state[1]",             &st.envelope_state[1],            sizeof(st.envelope_state[1]),               KEEP_ON_RESET },
+        { "st.envelope_state[2]",             &st.envelope_state[2],            sizeof(st.envelope_state[2]),               KEEP_ON_RESET },
+        { "st.hold_zero[0]",                  &st.hold_zero[0],                 sizeof(st.hold_zero[0]),                    KEEP_ON_RESET },
+        { "st.hold_zero[1]",                  &st.hold_zero[1],                 sizeof(st.hold_zero[1]),                    KEEP_ON_RESET },
+        { "st.hold_zero[2]",                  &st.hold_zero[2],                 sizeof(st.hold_zero[2]),                    KEEP_ON_RESET },
         
-        { NULL,                             0,                                          0 }};
+        { NULL,                               NULL,                             0,                                          0 }};
     
     registerSnapshotItems(items, sizeof(items));
     
@@ -87,6 +87,7 @@ ReSID::ReSID()
     
     volume = 100000;
     targetVolume = 100000;
+    silent = false;
 }
 
 ReSID::~ReSID()
@@ -205,6 +206,11 @@ ReSID::execute(uint64_t elapsedCycles)
     cycle_count delta_t = (cycle_count)elapsedCycles;
     int bufindex = 0;
     
+    if (silent) {
+        sid->clock(delta_t);
+        return;
+    }
+    
     // Let reSID compute some sound samples
     while (delta_t) {
         bufindex += sid->clock(delta_t, buf + bufindex, buflength - bufindex);
@@ -330,6 +336,9 @@ ReSID::writeData(short *data, size_t count)
         handleBufferOverflow();
     }
     
+    if (c64->capture.isCapturing())
+        c64->capture.recordSamples(data, count);
+    
     // Convert sound samples to floating point values and write into ringbuffer
     for (unsigned i = 0; i < count; i++) {
         ringBuffer[writePtr] = float(data[i]) * scale;
@@ -104,6 +104,12 @@ public:
      */
     int32_t targetVolume;
         
+    /*! @brief   Indicates if sample generation is skipped
+     *  @details In silent mode, reSID is clocked without computing any samples. This is much
+     *           cheaper with the resampling methods and leaves the chip state unchanged.
+     */
+    bool silent;
+    
 private:
     
     /*! @brief   Maximum volume
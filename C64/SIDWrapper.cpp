@@ -33,15 +33,16 @@ SIDWrapper::SIDWrapper()
     SnapshotItem items[] = {
         
         // Configuration items
-        { &useReSID,        sizeof(useReSID),       KEEP_ON_RESET },
+        { "useReSID",       &useReSID,        sizeof(useReSID),       KEEP_ON_RESET },
         // Internal state
-        { &latchedDataBus,  sizeof(latchedDataBus), CLEAR_ON_RESET },
-        { &cycles,          sizeof(cycles),         CLEAR_ON_RESET },
-        { NULL,             0,                      0 }};
+        { "latchedDataBus", &latchedDataBus,  sizeof(latchedDataBus), CLEAR_ON_RESET },
+        { "cycles",         &cycles,          sizeof(cycles),         CLEAR_ON_RESET },
+        { NULL,             NULL,             0,                      0 }};
     
     registerSnapshotItems(items, sizeof(items));
     
     useReSID = true;
+    randomSeed = 0;
 }
 
 SIDWrapper::~SIDWrapper()
@@ -103,7 +104,7 @@ SIDWrapper::peek(uint16_t addr)
     
     if (addr == 0x1B || addr == 0x1C) {
         latchedDataBus = 0;
-        return rand();
+        return rand_r(&randomSeed);
     }
     
     return latchedDataBus;
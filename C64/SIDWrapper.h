@@ -51,6 +51,9 @@ private:
     //! @brief    Remembers latest written value
     uint8_t latchedDataBus;
     
+    //! @brief    Seed of the random number generator used for reading the potentiometer registers
+    unsigned randomSeed;
+    
 public:
     //! @brief    Returns true if the addr is located in the I/O range of the SID chip.
 	static inline bool isSidAddr(uint16_t addr) 
@@ -125,6 +128,9 @@ public:
      *  @details Configures volume and targetVolume to simulate a quick audio fade out
      */
     void rampDown() { resid->rampDown(); }
+    
+    //! @brief    Enables or disables sample generation (ReSID only)
+    void setSilent(bool b) { resid->silent = b; }
 
 
     // -----------------------------------------------------------------------------------
@@ -17,9 +17,23 @@
  */
 
 #include "C64.h"
+#include "Compression.h"
+#include <stddef.h>
 
 const uint8_t Snapshot::magicBytes[] = { 'V', 'C', '6', '4', 0x00 };
 
+static uint16_t
+swap16(uint16_t value)
+{
+    return (uint16_t)((value << 8) | (value >> 8));
+}
+
+static uint32_t
+swap32(uint32_t value)
+{
+    return ((uint32_t)swap16((uint16_t)value) << 16) | swap16((uint16_t)(value >> 16));
+}
+
 Snapshot::Snapshot()
 {
     header.magic[0] = magicBytes[0];
@@ -29,9 +43,16 @@ Snapshot::Snapshot()
     header.major = V_MAJOR;
     header.minor = V_MINOR;
     header.subminor = V_SUBMINOR;
+    header.format = RAW_IMAGE;
+    header.byteOrder = hostByteOrder();
     header.size = 0;
+    header.screenshot.width = 0;
+    header.screenshot.height = 0;
+    memset(header.screenshot.palette, 0, sizeof(header.screenshot.palette));
     timestamp = (time_t)0;
     state = NULL;
+    thumbnail = NULL;
+    imageData = NULL;
 }
 
 Snapshot *
@@ -73,6 +94,8 @@ Snapshot::makeSnapshotWithC64(C64 *c64)
 Snapshot::~Snapshot()
 {
     dealloc();
+    free(thumbnail);
+    free(imageData);
 }
 
 void
@@ -80,6 +103,7 @@ Snapshot::dealloc()
 {
     if (state != NULL) {
         free(state);
+        state = NULL;
         header.size = 0;
     }
 }
@@ -169,21 +193,111 @@ Snapshot::hasSameType(const char *filename)
     return Snapshot::isSnapshotFile(filename, V_MAJOR, V_MINOR, V_SUBMINOR);
 }
 
+uint8_t
+Snapshot::hostByteOrder()
+{
+    const uint16_t probe = 1;
+    return *(const uint8_t *)&probe ? LITTLE_ENDIAN_STATE : BIG_ENDIAN_STATE;
+}
+
+size_t
+Snapshot::maxContainerSize(size_t imageSize)
+{
+    return CONTAINER_HEADER_SIZE + lzMaxCompressedSize(imageSize);
+}
+
+size_t
+Snapshot::compressImage(const uint8_t *image, size_t imageSize, uint8_t *container,
+                        uint32_t *table)
+{
+    assert(image != NULL && imageSize > sizeof(header));
+    assert(image[7] == RAW_IMAGE);
+    
+    // Magic bytes and version number are taken from the image
+    memcpy(container, image, 7);
+    container[7] = COMPRESSED_CONTAINER;
+    
+    size_t payloadSize = lzCompress(image, imageSize, container + CONTAINER_HEADER_SIZE, table);
+    if (payloadSize == 0)
+        return 0;
+    
+    for (unsigned i = 0; i < 4; i++) {
+        container[8 + i] = (uint8_t)(imageSize >> (24 - 8 * i));
+        container[12 + i] = (uint8_t)(payloadSize >> (24 - 8 * i));
+    }
+    
+    return CONTAINER_HEADER_SIZE + payloadSize;
+}
+
 bool 
 Snapshot::readFromBuffer(const uint8_t *buffer, size_t length)
 {
     assert(buffer != NULL);
-    assert(length > sizeof(header));
-
+    
+    if (length >= CONTAINER_HEADER_SIZE && buffer[7] == COMPRESSED_CONTAINER) {
+        
+        size_t imageSize = 0, payloadSize = 0;
+        for (unsigned i = 0; i < 4; i++) {
+            imageSize = (imageSize << 8) | buffer[8 + i];
+            payloadSize = (payloadSize << 8) | buffer[12 + i];
+        }
+        if (payloadSize != length - CONTAINER_HEADER_SIZE || imageSize <= sizeof(header))
+            return false;
+        
+        uint8_t *image = (uint8_t *)malloc(imageSize);
+        if (image == NULL)
+            return false;
+        
+        bool success =
+        lzDecompress(buffer + CONTAINER_HEADER_SIZE, payloadSize, image, imageSize) &&
+        image[7] == RAW_IMAGE &&
+        readFromBuffer(image, imageSize);
+        
+        free(image);
+        return success;
+    }
+    
+    if (length <= sizeof(header))
+        return false;
+    
+    // Check the screenshot dimensions
+    bool foreign = buffer[offsetof(Header, byteOrder)] != hostByteOrder();
+    uint16_t width, height;
+    memcpy(&width, buffer + offsetof(Header, screenshot.width), sizeof(width));
+    memcpy(&height, buffer + offsetof(Header, screenshot.height), sizeof(height));
+    if (foreign) {
+        width = swap16(width);
+        height = swap16(height);
+    }
+    if (width > MAX_THUMBNAIL_WIDTH || height > MAX_THUMBNAIL_HEIGHT)
+        return false;
+    
+    size_t thumbnailSize = ((size_t)width * height + 1) / 2;
+    if (length <= sizeof(header) + thumbnailSize)
+        return false;
+    
+    // The state size stored in the header has to match the remaining data
+    Header h;
+    memcpy((uint8_t *)&h, buffer, sizeof(h));
+    if (foreign)
+        swapHeader(&h);
+    if (h.size != length - sizeof(header) - thumbnailSize)
+        return false;
+    
     // Allocate memory
-    alloc(length - sizeof(header));
+    if (!alloc(h.size) || !allocThumbnail(width, height))
+        return false;
     
     // Copy header
-    memcpy((uint8_t *)&header, buffer, sizeof(header));
-    assert(header.size == length - sizeof(header));
+    header = h;
+    buffer += sizeof(header);
+    
+    // Copy thumbnail
+    memcpy(thumbnail, buffer, thumbnailSize);
+    buffer += thumbnailSize;
     
     // Copy state data
-    memcpy(state, buffer + sizeof(header), length - sizeof(header));
+    memcpy(state, buffer, header.size);
     
 	return true;
 }
@@ -193,39 +307,116 @@ Snapshot::writeToBuffer(uint8_t *buffer)
 {
     assert(state != NULL);
     
-    // Copy header
-    if (buffer)
-        memcpy(buffer,(const void *)&header, sizeof(header));
+    size_t thumbnailSize = getThumbnailSize();
+    
+    if (buffer) {
+        
+        // Copy header (in the byte order of the internal state)
+        Header h = header;
+        if (hasForeignByteOrder())
+            swapHeader(&h);
+        memcpy(buffer, (const void *)&h, sizeof(h));
+        buffer += sizeof(h);
+        
+        // Copy thumbnail
+        if (thumbnailSize)
+            memcpy(buffer, thumbnail, thumbnailSize);
+        buffer += thumbnailSize;
+        
+        // Copy state data
+        memcpy(buffer, state, header.size);
+    }
 
-    // Copy state data
-    if (buffer)
-        memcpy(buffer + sizeof(header), state, header.size);
+    return sizeof(header) + thumbnailSize + header.size;
+}
 
-    return sizeof(header) + header.size;
+bool
+Snapshot::allocThumbnail(unsigned width, unsigned height)
+{
+    assert(width <= MAX_THUMBNAIL_WIDTH && height <= MAX_THUMBNAIL_HEIGHT);
+    
+    // The RGBA image is outdated
+    free(imageData);
+    imageData = NULL;
+    
+    // Thumbnails are allocated in maximum size which keeps the buffer for all further screenshots
+    if (thumbnail == NULL &&
+        (thumbnail = (uint8_t *)malloc((MAX_THUMBNAIL_WIDTH * MAX_THUMBNAIL_HEIGHT + 1) / 2)) == NULL) {
+        warn("Failed to allocate memory for the snapshot thumbnail\n");
+        header.screenshot.width = header.screenshot.height = 0;
+        return false;
+    }
+    
+    header.screenshot.width = width;
+    header.screenshot.height = height;
+    return true;
+}
+
+unsigned char *
+Snapshot::getImageData()
+{
+    if (imageData != NULL || thumbnail == NULL)
+        return (unsigned char *)imageData;
+    
+    size_t count = (size_t)header.screenshot.width * header.screenshot.height;
+    if ((imageData = (uint32_t *)malloc(count * 4)) == NULL)
+        return NULL;
+    
+    for (size_t i = 0; i < count; i++) {
+        uint8_t index = (i & 1) ? thumbnail[i / 2] & 0x0F : thumbnail[i / 2] >> 4;
+        imageData[i] = header.screenshot.palette[index];
+    }
+    
+    return (unsigned char *)imageData;
 }
 
 void
-Snapshot::takeScreenshot(uint32_t *buf, bool pal)
+Snapshot::takeScreenshot(const uint8_t *buf, const uint32_t *palette, bool pal, unsigned scale)
 {
-    unsigned x_start, y_start;
-       
+    unsigned x_start, y_start, width, height;
+    
+    assert(scale == 1 || scale == 2);
+    
     if (pal) {
         x_start = PAL_LEFT_BORDER_WIDTH - 36;
         y_start = PAL_UPPER_BORDER_HEIGHT - 34;
-        header.screenshot.width = 36 + PAL_CANVAS_WIDTH + 36;
-        header.screenshot.height = 34 + PAL_CANVAS_HEIGHT + 34;
+        width = 36 + PAL_CANVAS_WIDTH + 36;
+        height = 34 + PAL_CANVAS_HEIGHT + 34;
     } else {
         x_start = NTSC_LEFT_BORDER_WIDTH - 42;
         y_start = NTSC_UPPER_BORDER_HEIGHT - 9;
-        header.screenshot.width = 36 + PAL_CANVAS_WIDTH + 36;
-        header.screenshot.height = 9 + PAL_CANVAS_HEIGHT + 9;
+        width = 36 + PAL_CANVAS_WIDTH + 36;
+        height = 9 + PAL_CANVAS_HEIGHT + 9;
     }
     
-    uint32_t *target = header.screenshot.screen;
+    // Without a thumbnail buffer, the snapshot goes without a screenshot
+    if (!allocThumbnail(width / scale, height / scale))
+        return;
+    memcpy(header.screenshot.palette, palette, sizeof(header.screenshot.palette));
+    
+    // Pack two pixels into each byte
+    size_t k = 0;
+    
     buf += x_start + y_start * NTSC_PIXELS;
-    for (unsigned i = 0; i < header.screenshot.height; i++) {
-        memcpy(target, buf, header.screenshot.width * 4);
-        target += header.screenshot.width;
-        buf += NTSC_PIXELS;
+    for (unsigned y = 0; y < header.screenshot.height; y++, buf += scale * NTSC_PIXELS) {
+        for (unsigned x = 0; x < header.screenshot.width; x++, k++) {
+            
+            uint8_t index = buf[x * scale] & 0x0F;
+            if (k & 1) {
+                thumbnail[k / 2] |= index;
+            } else {
+                thumbnail[k / 2] = index << 4;
+            }
+        }
     }
 }
+
+void
+Snapshot::swapHeader(Header *header)
+{
+    header->screenshot.width = swap16(header->screenshot.width);
+    header->screenshot.height = swap16(header->screenshot.height);
+    
+    // Palette entries are byte quadruples (RGBA) which are not affected
+    header->size = swap32(header->size);
+}
@@ -29,6 +29,25 @@ class C64;
 /*! @class    Snapshot
  *  @brief    The Snapshot class declares the programmatic interface for a file that contains an emulator snapshot 
  *            (a frozen internal state).
+ *  @details  A snapshot is either stored as a raw image (the header followed by the internal state) or
+ *            as a compressed container. Both start with the magic bytes and the version number. The
+ *            next byte tells them apart:
+ *
+ *                0 : Raw image. The remaining header bytes and the internal state follow.
+ *                1 : Compressed container. A 32 bit raw image size and a 32 bit payload size
+ *                    follow (big endian), followed by the LZ compressed raw image.
+ *
+ *            readFromBuffer() accepts both formats. In a raw image, the header is followed by the
+ *            screenshot thumbnail and the internal state.
+ *
+ *            The header and the snapshot items of the internal state are stored in the byte
+ *            order of the host that has created the snapshot, so that saving and loading boils
+ *            down to a few memcpy calls. The byte order is recorded in the header. Snapshots of
+ *            the opposite byte order are converted when they are read or loaded.
+ *
+ *            The thumbnail is stored as 4 bit palette indices (two pixels per byte, the left
+ *            pixel in the upper nibble), together with the 16 RGBA values of the palette. The
+ *            RGBA image is only created when getImageData() is called.
  */
 class Snapshot : public Container {
 	
@@ -37,7 +56,31 @@ private:
     //! @brief    Header signature
     static const uint8_t magicBytes[];
     
-	struct {
+public:
+    
+    //! @brief    Storage formats
+    enum {
+        RAW_IMAGE            = 0,
+        COMPRESSED_CONTAINER = 1
+    };
+    
+    //! @brief    Byte orders of the header and the internal state
+    enum {
+        LITTLE_ENDIAN_STATE = 0,
+        BIG_ENDIAN_STATE    = 1
+    };
+    
+    //! @brief    Size of the compressed container header in bytes
+    static const size_t CONTAINER_HEADER_SIZE = 16;
+    
+    //! @brief    Maximum thumbnail width and height
+    static const unsigned MAX_THUMBNAIL_WIDTH = NTSC_PIXELS;
+    static const unsigned MAX_THUMBNAIL_HEIGHT = PAL_RASTERLINES;
+    
+private:
+    
+	//! @brief    Snapshot header
+	typedef struct {
 		
 		//! @brief    Magic bytes ('V','C','6','4')
 		char magic[4];
@@ -46,25 +89,39 @@ private:
 		uint8_t major;
 		uint8_t minor;
         uint8_t subminor;
+        
+        //! @brief    Storage format (always RAW_IMAGE in memory)
+        uint8_t format;
+        
+        //! @brief    Byte order of the header and the internal state
+        uint8_t byteOrder;
 		
 		//! @brief    Screenshot
 		struct { 	
 			
-			//! @brief    Image width and height
+			//! @brief    Thumbnail width and height
 			uint16_t width, height;
 		
-			//! @brief    Screen buffer data
-			uint32_t screen[PAL_RASTERLINES * NTSC_PIXELS];
+			//! @brief    RGBA values of the sixteen palette indices
+			uint32_t palette[16];
 		
 		} screenshot;
         
         //! @brief    Size of internal state
         uint32_t size;
 
-    } header;
+    } Header;
+    
+    Header header;
 	
     //! @brief    Internal state data
     uint8_t *state;
+    
+    //! @brief    Thumbnail data (4 bit palette indices)
+    uint8_t *thumbnail;
+    
+    //! @brief    RGBA expansion of the thumbnail or NULL if not created yet
+    uint32_t *imageData;
 
 	//! @brief    Date and time of snapshot creation
 	time_t timestamp;
@@ -111,6 +168,27 @@ public:
     //! @brief    Returns true if file is a snapshot with an outdated version number
     static bool isUnsupportedSnapshotFile(const char *path);
     
+    //! @brief    Returns the byte order of the host
+    static uint8_t hostByteOrder();
+    
+    /*! @brief    Returns true iff the internal state has been created by a host of the
+     *            opposite byte order
+     *  @details  The header is converted by readFromBuffer(). The internal state is converted
+     *            by the components when the snapshot is loaded.
+     */
+    bool hasForeignByteOrder() { return header.byteOrder != hostByteOrder(); }
+    
+    //! @brief    Returns the maximum size of a compressed container holding a raw image
+    static size_t maxContainerSize(size_t imageSize);
+    
+    /*! @brief    Packs a raw image into a compressed container
+     *  @param    container  Target buffer of at least maxContainerSize(imageSize) bytes
+     *  @param    table      Hash table for lzCompress() or NULL
+     *  @result   Size of the container in bytes or 0, if the image could not be compressed
+     */
+    static size_t compressImage(const uint8_t *image, size_t imageSize, uint8_t *container,
+                                uint32_t *table = NULL);
+    
     //
 	// Virtual functions from Container class
     //
@@ -142,8 +220,10 @@ public:
 	//! Returns true, if snapshot does not contain data yet
 	bool isEmpty() { return timestamp == 0; }
 	
-	//! Return screen buffer
-	unsigned char *getImageData() { return (unsigned char *)header.screenshot.screen; }
+	/*! @brief    Returns the screenshot in RGBA format
+     *  @details  The image is expanded from the thumbnail on the first call.
+     */
+	unsigned char *getImageData();
 
     //! Return image width
     unsigned getImageWidth() { return header.screenshot.width; }
@@ -151,8 +231,25 @@ public:
     //! Return image height
     unsigned getImageHeight() { return header.screenshot.height; }
 
-    //! Take screenshot
-    void takeScreenshot(uint32_t *buf, bool pal);
+    //! @brief    Returns the size of the thumbnail data in bytes
+    size_t getThumbnailSize() { return ((size_t)header.screenshot.width * header.screenshot.height + 1) / 2; }
+    
+    /*! @brief    Takes a screenshot
+     *  @param    buf      Index buffer of the pixel engine
+     *  @param    palette  The sixteen C64 colors in RGBA format
+     *  @param    scale    Subsampling factor (1 = full size, 2 = half width and height)
+     */
+    void takeScreenshot(const uint8_t *buf, const uint32_t *palette, bool pal, unsigned scale = 1);
+
+private:
+    
+    /*! @brief    Sets the thumbnail dimensions and makes sure the thumbnail buffer exists
+     *  @result   false, if the buffer could not be allocated. The thumbnail is empty then.
+     */
+    bool allocThumbnail(unsigned width, unsigned height);
+    
+    //! @brief    Converts the numeric header fields to the opposite byte order
+    static void swapHeader(Header *header);
 
 };
 
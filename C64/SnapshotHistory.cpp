@@ -0,0 +1,498 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SnapshotHistory.h"
+#include "Compression.h"
+
+/* Encoded image format
+ *
+ * An encoded image is a sequence of tokens. Each token consists of two variable length
+ * integers (7 bits per byte, least significant group first, bit 7 set if more bytes follow)
+ * and a number of literal bytes:
+ *
+ *     <number of zero bytes> <number of literal bytes> <literal bytes>
+ *
+ * The bytes represent the XOR difference to the predecessor (deltas) or to the byte four
+ * positions before (keyframes). Zero runs shorter than MIN_ZERO_RUN are stored as literals.
+ */
+
+//! @brief    Minimum length of a zero run that terminates a literal run
+#define MIN_ZERO_RUN 8
+
+static inline uint8_t *
+putVarint(uint8_t *out, size_t value)
+{
+    while (value >= 0x80) {
+        *out++ = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = (uint8_t)value;
+    return out;
+}
+
+static inline size_t
+getVarint(const uint8_t **in)
+{
+    size_t value = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+
+    do {
+        byte = *(*in)++;
+        value |= (size_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+
+    return value;
+}
+
+//! @brief    Returns the encoded representation of a single byte
+static inline uint8_t
+difference(const uint8_t *image, const uint8_t *ref, size_t k)
+{
+    return image[k] ^ (ref ? ref[k] : (k >= 4 ? image[k - 4] : 0));
+}
+
+//! @brief    Returns the number of consecutive bytes starting at k whose difference is zero
+static inline size_t
+zeroRun(const uint8_t *image, const uint8_t *ref, size_t k, size_t size)
+{
+    size_t start = k;
+
+    // The first four bytes of a keyframe have no predecessor
+    while (!ref && k < 4 && k < size) {
+        if (image[k]) return k - start;
+        k++;
+    }
+
+    const uint8_t *a = image + k;
+    const uint8_t *b = ref ? ref + k : image + k - 4;
+    uint64_t wa, wb;
+
+    while (k + 8 <= size) {
+        memcpy(&wa, a, 8);
+        memcpy(&wb, b, 8);
+        if (wa != wb) break;
+        a += 8; b += 8; k += 8;
+    }
+    while (k < size && *a == *b) {
+        a++; b++; k++;
+    }
+
+    return k - start;
+}
+
+SnapshotHistory::SnapshotHistory()
+{
+    setDescription("SnapshotHistory");
+
+    memset(entries, 0, sizeof(entries));
+    first = 0;
+    count = 0;
+    firstSerial = 0;
+    budget = 32 * 1024 * 1024;
+    used = 0;
+    sinceKeyframe = 0;
+
+    latest = encoded = packed = decoded = NULL;
+    latestSize = latestCapacity = encodedCapacity = packedCapacity = 0;
+    decodedSize = decodedCapacity = 0;
+    decodedSerial = UINT64_MAX;
+
+    pthread_mutex_init(&lock, NULL);
+}
+
+SnapshotHistory::~SnapshotHistory()
+{
+    clear();
+    free(latest);
+    free(encoded);
+    free(packed);
+    free(decoded);
+    pthread_mutex_destroy(&lock);
+}
+
+void
+SnapshotHistory::clear()
+{
+    pthread_mutex_lock(&lock);
+
+    while (count)
+        discardOldestGroup();
+    first = 0;
+    sinceKeyframe = 0;
+    latestSize = 0;
+
+    pthread_mutex_unlock(&lock);
+}
+
+void
+SnapshotHistory::setBudget(size_t bytes)
+{
+    pthread_mutex_lock(&lock);
+
+    budget = bytes;
+    while (count && used > budget)
+        discardOldestGroup();
+
+    pthread_mutex_unlock(&lock);
+}
+
+bool
+SnapshotHistory::reserve(uint8_t **buffer, size_t *capacity, size_t size)
+{
+    if (*capacity >= size)
+        return true;
+
+    uint8_t *newBuffer = (uint8_t *)realloc(*buffer, size);
+    if (newBuffer == NULL)
+        return false;
+
+    *buffer = newBuffer;
+    *capacity = size;
+    return true;
+}
+
+size_t
+SnapshotHistory::encode(const uint8_t *image, const uint8_t *ref, size_t size, uint8_t *out)
+{
+    uint8_t *ptr = out;
+    size_t i = 0;
+
+    while (i < size) {
+
+        // Skip zero run
+        size_t z = i + zeroRun(image, ref, i, size);
+
+        // Collect literals until the next long zero run begins
+        size_t l = z;
+        while (l < size) {
+            if (difference(image, ref, l)) {
+                l++;
+                continue;
+            }
+            size_t run = zeroRun(image, ref, l, size);
+            if (run >= MIN_ZERO_RUN || l + run == size)
+                break;
+            l += run;
+        }
+
+        ptr = putVarint(ptr, z - i);
+        ptr = putVarint(ptr, l - z);
+        for (size_t k = z; k < l; k++)
+            *ptr++ = difference(image, ref, k);
+
+        i = l;
+    }
+
+    return ptr - out;
+}
+
+void
+SnapshotHistory::decode(const uint8_t *in, size_t inSize, uint8_t *image, bool keyframe)
+{
+    const uint8_t *end = in + inSize;
+    size_t k = 0;
+
+    while (in < end) {
+
+        size_t zeros = getVarint(&in);
+        size_t literals = getVarint(&in);
+
+        if (keyframe) {
+            for (size_t j = 0; j < zeros; j++, k++)
+                image[k] = k >= 4 ? image[k - 4] : 0;
+            for (size_t j = 0; j < literals; j++, k++)
+                image[k] = *in++ ^ (k >= 4 ? image[k - 4] : 0);
+        } else {
+            k += zeros;
+            for (size_t j = 0; j < literals; j++, k++)
+                image[k] ^= *in++;
+        }
+    }
+}
+
+bool
+SnapshotHistory::add(const uint8_t *image, size_t size, time_t timestamp, uint64_t cycle, unsigned epoch,
+                     uint32_t *table)
+{
+    assert(image != NULL);
+
+    pthread_mutex_lock(&lock);
+
+    bool keyframe = count == 0 || sinceKeyframe >= KEYFRAME_DISTANCE || size != latestSize;
+
+    // Nothing is changed before all buffers are in place
+    size_t maxEncodedSize = size + size / 2 + 64;
+    if (!reserve(&encoded, &encodedCapacity, maxEncodedSize) ||
+        !reserve(&packed, &packedCapacity, lzMaxCompressedSize(maxEncodedSize)) ||
+        !reserve(&latest, &latestCapacity, size)) {
+        warn("Failed to allocate buffers for the snapshot history. Snapshot dropped.\n");
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+
+    size_t encodedSize = encode(image, keyframe ? NULL : latest, size, encoded);
+    size_t packedSize = lzCompress(encoded, encodedSize, packed, table);
+    if (packedSize == 0) {
+        warn("Failed to compress the snapshot. Snapshot dropped.\n");
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+
+    // Make room
+    while (count && (count == MAX_SNAPSHOTS || used + packedSize > budget))
+        discardOldestGroup();
+
+    // A delta is useless if its group has been discarded
+    if (!keyframe && count == 0) {
+        keyframe = true;
+        encodedSize = encode(image, NULL, size, encoded);
+        if ((packedSize = lzCompress(encoded, encodedSize, packed, table)) == 0) {
+            warn("Failed to compress the snapshot. Snapshot dropped.\n");
+            pthread_mutex_unlock(&lock);
+            return false;
+        }
+    }
+
+    Entry *e = &entries[(first + count) % MAX_SNAPSHOTS];
+    if ((e->data = (uint8_t *)malloc(packedSize)) == NULL) {
+        warn("Failed to allocate %zu bytes for the snapshot history. Snapshot dropped.\n", packedSize);
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+    memcpy(e->data, packed, packedSize);
+    e->size = packedSize;
+    e->encodedSize = encodedSize;
+    e->rawSize = size;
+    e->timestamp = timestamp;
+    e->cycle = cycle;
+    e->epoch = epoch;
+    e->keyframe = keyframe;
+
+    count++;
+    used += packedSize;
+    sinceKeyframe = keyframe ? 1 : sinceKeyframe + 1;
+
+    // The new image becomes the reference for the next delta
+    memcpy(latest, image, size);
+    latestSize = size;
+
+    pthread_mutex_unlock(&lock);
+    return true;
+}
+
+bool
+SnapshotHistory::unpack(uint64_t serial, bool keyframe)
+{
+    Entry *e = entry(serial);
+
+    if (!reserve(&encoded, &encodedCapacity, e->encodedSize)) {
+        warn("Failed to allocate %zu bytes for decoding a snapshot\n", e->encodedSize);
+        return false;
+    }
+    if (!lzDecompress(e->data, e->size, encoded, e->encodedSize)) {
+        warn("Snapshot history entry %llu is corrupted\n", (unsigned long long)serial);
+        return false;
+    }
+    decode(encoded, e->encodedSize, decoded, keyframe);
+    return true;
+}
+
+void
+SnapshotHistory::discardOldestGroup()
+{
+    assert(count > 0);
+    assert(entries[first].keyframe);
+
+    do {
+        free(entries[first].data);
+        entries[first].data = NULL;
+        used -= entries[first].size;
+        first = (first + 1) % MAX_SNAPSHOTS;
+        firstSerial++;
+        count--;
+    } while (count && !entries[first].keyframe);
+
+    if (decodedSerial != UINT64_MAX && decodedSerial < firstSerial)
+        decodedSerial = UINT64_MAX;
+}
+
+unsigned
+SnapshotHistory::numKeyframes()
+{
+    unsigned result = 0;
+
+    pthread_mutex_lock(&lock);
+    for (unsigned i = 0; i < count; i++)
+        if (entries[(first + i) % MAX_SNAPSHOTS].keyframe) result++;
+    pthread_mutex_unlock(&lock);
+
+    return result;
+}
+
+bool
+SnapshotHistory::restore(unsigned nr, Snapshot *snapshot)
+{
+    assert(snapshot != NULL);
+
+    pthread_mutex_lock(&lock);
+
+    if (nr >= count) {
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+
+    uint64_t target = firstSerial + count - 1 - nr;
+    Entry *e = entry(target);
+    uint8_t *image;
+
+    if (nr == 0) {
+
+        // The latest image is kept in decoded form
+        assert(latestSize == e->rawSize);
+        image = latest;
+
+    } else {
+
+        if (!decodeSerial(target)) {
+            pthread_mutex_unlock(&lock);
+            return false;
+        }
+        image = decoded;
+    }
+
+    bool result = snapshot->readFromBuffer(image, e->rawSize);
+    snapshot->setTimestamp(e->timestamp);
+
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+bool
+SnapshotHistory::decodeSerial(uint64_t target)
+{
+    // Find the keyframe of the group
+    uint64_t key = target;
+    while (!entry(key)->keyframe) key--;
+
+    // Start from the keyframe unless a previously decoded image can be reused
+    uint64_t serial;
+    if (decodedSerial != UINT64_MAX && decodedSerial >= key && decodedSerial <= target) {
+        serial = decodedSerial + 1;
+    } else {
+        decodedSerial = UINT64_MAX;
+        if (!reserve(&decoded, &decodedCapacity, entry(key)->rawSize) || !unpack(key, true))
+            return false;
+        serial = key + 1;
+    }
+
+    // Apply deltas
+    for (; serial <= target; serial++) {
+        if (!unpack(serial, false)) {
+            decodedSerial = UINT64_MAX;
+            return false;
+        }
+    }
+
+    decodedSerial = target;
+    decodedSize = entry(target)->rawSize;
+    return true;
+}
+
+int
+SnapshotHistory::find(uint64_t cycle, unsigned epoch)
+{
+    int result = -1;
+
+    pthread_mutex_lock(&lock);
+
+    for (unsigned nr = 0; nr < count; nr++) {
+        Entry *e = entry(firstSerial + count - 1 - nr);
+        if (e->epoch == epoch && e->cycle <= cycle) {
+            result = (int)nr;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+unsigned
+SnapshotHistory::getEpoch(unsigned nr)
+{
+    pthread_mutex_lock(&lock);
+
+    assert(nr < count);
+    unsigned result = entry(firstSerial + count - 1 - nr)->epoch;
+
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+void
+SnapshotHistory::discardLatest(unsigned nr)
+{
+    pthread_mutex_lock(&lock);
+
+    if (nr > count)
+        nr = count;
+
+    for (unsigned i = 0; i < nr; i++) {
+        Entry *e = entry(firstSerial + count - 1);
+        free(e->data);
+        e->data = NULL;
+        used -= e->size;
+        count--;
+    }
+
+    if (decodedSerial != UINT64_MAX && decodedSerial >= firstSerial + count)
+        decodedSerial = UINT64_MAX;
+
+    // The new latest snapshot becomes the reference for the next delta
+    if (count && nr) {
+        uint64_t newest = firstSerial + count - 1;
+        if (decodeSerial(newest) && reserve(&latest, &latestCapacity, decodedSize)) {
+            memcpy(latest, decoded, decodedSize);
+            latestSize = decodedSize;
+        } else {
+            latestSize = 0; // Enforces a keyframe
+        }
+        for (sinceKeyframe = 1; !entry(newest)->keyframe; newest--)
+            sinceKeyframe++;
+    }
+    if (count == 0) {
+        first = 0;
+        sinceKeyframe = 0;
+        latestSize = 0;
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+void
+SnapshotHistory::dumpState()
+{
+    msg("Snapshot history:\n");
+    msg("-----------------\n\n");
+    msg("           Snapshots : %d (%d keyframes)\n", count, numKeyframes());
+    msg("         Memory used : %zu of %zu bytes\n", used, budget);
+    msg("  Bytes per snapshot : %zu (uncompressed: %zu)\n", bytesPerSnapshot(), latestSize);
+    msg("\n");
+}
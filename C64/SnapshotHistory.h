@@ -0,0 +1,227 @@
+/*!
+ * @header      SnapshotHistory.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _SNAPSHOTHISTORY_INC
+#define _SNAPSHOTHISTORY_INC
+
+#include "Snapshot.h"
+#include <pthread.h>
+
+/*! @class    SnapshotHistory
+ *  @brief    Delta compressed ring buffer of time travel snapshots
+ *  @details  Each snapshot is stored as a single image consisting of the snapshot header
+ *            (including the screenshot) followed by the internal state. Every
+ *            KEYFRAME_DISTANCE snapshots, a keyframe is stored. All other snapshots are stored
+ *            as the XOR difference to their predecessor. Both kinds of images are run-length
+ *            encoded by skipping runs of zero bytes and LZ compressed afterwards. The latter
+ *            removes the redundancy that remains in the deltas, e.g., if the border color
+ *            changes all over the screenshot. A keyframe and the deltas following it
+ *            form a group. If the memory budget is exceeded, the oldest group is discarded.
+ *            All public functions are thread-safe.
+ */
+class SnapshotHistory : public VC64Object {
+
+public:
+
+    //! @brief    Number of snapshots between two keyframes
+    static const unsigned KEYFRAME_DISTANCE = 16;
+
+    //! @brief    Maximum number of stored snapshots
+    static const unsigned MAX_SNAPSHOTS = 4096;
+
+private:
+
+    //! @brief    A single encoded snapshot
+    typedef struct {
+
+        //! @brief    LZ compressed encoded image
+        uint8_t *data;
+
+        //! @brief    Size of the compressed image in bytes
+        size_t size;
+
+        //! @brief    Size of the encoded image in bytes
+        size_t encodedSize;
+
+        //! @brief    Size of the decoded image in bytes
+        size_t rawSize;
+
+        //! @brief    Creation date of the snapshot
+        time_t timestamp;
+
+        //! @brief    Emulated cycle and epoch the snapshot has been taken in (see C64::epoch)
+        uint64_t cycle;
+        unsigned epoch;
+
+        //! @brief    Indicates if the image can be decoded without its predecessor
+        bool keyframe;
+
+    } Entry;
+
+    //! @brief    Ring buffer holding the encoded snapshots
+    Entry entries[MAX_SNAPSHOTS];
+
+    //! @brief    Ring buffer position of the oldest snapshot
+    unsigned first;
+
+    //! @brief    Number of stored snapshots
+    unsigned count;
+
+    //! @brief    Sequence number of the oldest snapshot
+    uint64_t firstSerial;
+
+    //! @brief    Maximum number of bytes occupied by encoded images
+    size_t budget;
+
+    //! @brief    Number of bytes currently occupied by encoded images
+    size_t used;
+
+    //! @brief    Number of snapshots added since the last keyframe
+    unsigned sinceKeyframe;
+
+    //! @brief    Decoded image of the latest snapshot (reference for the next delta)
+    uint8_t *latest;
+    size_t latestSize, latestCapacity;
+
+    //! @brief    Buffer holding the encoder output (or the decoder input)
+    uint8_t *encoded;
+    size_t encodedCapacity;
+
+    //! @brief    Buffer holding the LZ compressor output
+    uint8_t *packed;
+    size_t packedCapacity;
+
+    /*! @brief    Most recently decoded image
+     *  @details  Speeds up restoring neighboring snapshots of the same group.
+     */
+    uint8_t *decoded;
+    size_t decodedSize, decodedCapacity;
+
+    //! @brief    Sequence number of the image in decoded (UINT64_MAX if invalid)
+    uint64_t decodedSerial;
+
+    //! @brief    Protects the ring buffer against concurrent access
+    pthread_mutex_t lock;
+
+public:
+
+    //! @brief    Constructor
+    SnapshotHistory();
+
+    //! @brief    Destructor
+    ~SnapshotHistory();
+
+    //! @brief    Removes all snapshots
+    void clear();
+
+    //! @brief    Returns the memory budget in bytes
+    size_t getBudget() { return budget; }
+
+    /*! @brief    Sets the memory budget in bytes
+     *  @details  Old snapshots are discarded if the new budget is exceeded.
+     */
+    void setBudget(size_t bytes);
+
+    /*! @brief    Adds a snapshot as the latest one
+     *  @param    image  Raw snapshot image as produced by Snapshot::writeToBuffer()
+     *  @param    cycle  Emulated cycle the snapshot has been taken in
+     *  @param    epoch  Epoch the cycle refers to
+     *  @param    table  Hash table for lzCompress() or NULL
+     *  @result   false, if the snapshot has been dropped for lack of memory
+     */
+    bool add(const uint8_t *image, size_t size, time_t timestamp, uint64_t cycle, unsigned epoch,
+             uint32_t *table = NULL);
+
+    //! @brief    Returns the number of stored snapshots
+    unsigned numSnapshots() { return count; }
+
+    //! @brief    Returns the number of stored keyframes
+    unsigned numKeyframes();
+
+    //! @brief    Returns the number of bytes occupied by compressed images
+    size_t bytesUsed() { return used; }
+
+    //! @brief    Returns the average number of bytes per stored snapshot
+    size_t bytesPerSnapshot() { return count ? used / count : 0; }
+
+    /*! @brief    Restores a snapshot
+     *  @param    nr        Index of the snapshot. The latest snapshot is indexed 0.
+     *  @param    snapshot  Snapshot object the decoded image is written into
+     *  @result   false, if no such snapshot exists or if it cannot be decoded
+     */
+    bool restore(unsigned nr, Snapshot *snapshot);
+
+    /*! @brief    Searches the latest snapshot taken at or before a certain cycle
+     *  @details  Only snapshots of the specified epoch are considered.
+     *  @result   Index of the snapshot or -1 if no such snapshot exists
+     */
+    int find(uint64_t cycle, unsigned epoch);
+
+    //! @brief    Returns the epoch a snapshot has been taken in
+    unsigned getEpoch(unsigned nr);
+
+    /*! @brief    Discards the latest snapshots
+     *  @param    nr  Number of snapshots to discard
+     */
+    void discardLatest(unsigned nr);
+
+    //! @brief    Prints debugging information
+    void dumpState();
+
+private:
+
+    /*! @brief    Makes sure that a buffer can hold a certain number of bytes
+     *  @result   false, if the buffer could not be grown. It is left untouched in that case.
+     */
+    static bool reserve(uint8_t **buffer, size_t *capacity, size_t size);
+
+    /*! @brief    Encodes an image
+     *  @param    ref   Reference image or NULL
+     *  @details  If a reference image is given, the XOR difference is encoded. Otherwise, each
+     *            byte is XORed with the byte four positions before which removes the redundancy
+     *            of uniformly colored screenshot areas.
+     *  @result   Size of the encoded image
+     */
+    static size_t encode(const uint8_t *image, const uint8_t *ref, size_t size, uint8_t *out);
+
+    /*! @brief    Decodes an image
+     *  @param    keyframe  If false, the delta is applied to the contents of image.
+     */
+    static void decode(const uint8_t *in, size_t inSize, uint8_t *image, bool keyframe);
+
+    /*! @brief    Decompresses and decodes a stored image into the decoded buffer
+     *  @param    keyframe  If false, the delta is applied to the contents of decoded.
+     *  @result   false, if the entry is corrupted or memory is exhausted
+     */
+    bool unpack(uint64_t serial, bool keyframe);
+
+    /*! @brief    Decodes the snapshot with the specified sequence number into the decoded buffer
+     *  @result   false, if one of the involved entries cannot be unpacked
+     */
+    bool decodeSerial(uint64_t serial);
+
+    //! @brief    Discards the oldest group of snapshots
+    void discardOldestGroup();
+
+    //! @brief    Returns the ring buffer entry of the snapshot with the specified sequence number
+    Entry *entry(uint64_t serial) { return &entries[(first + (serial - firstSerial)) % MAX_SNAPSHOTS]; }
+};
+
+#endif
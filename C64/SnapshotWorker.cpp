@@ -0,0 +1,216 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "SnapshotWorker.h"
+#include "Compression.h"
+
+SnapshotWorker::SnapshotWorker(SnapshotHistory *history)
+{
+    setDescription("SnapshotWorker");
+
+    assert(history != NULL);
+    this->history = history;
+
+    memset(jobs, 0, sizeof(jobs));
+    first = 0;
+    count = 0;
+    dropped = 0;
+    running = false;
+
+    // Without a table of its own, lzCompress() allocates one per call
+    if ((lzTable = (uint32_t *)malloc(LZ_TABLE_ENTRIES * sizeof(uint32_t))) == NULL)
+        warn("Failed to allocate the LZ hash table\n");
+    terminate = false;
+
+    pthread_mutex_init(&lock, NULL);
+    pthread_cond_init(&submitted, NULL);
+    pthread_cond_init(&finished, NULL);
+}
+
+SnapshotWorker::~SnapshotWorker()
+{
+    pthread_mutex_lock(&lock);
+    terminate = true;
+    pthread_cond_signal(&submitted);
+    pthread_mutex_unlock(&lock);
+
+    if (running)
+        pthread_join(thread, NULL);
+
+    for (unsigned i = 0; i < POOL_SIZE; i++) {
+        free(jobs[i].image);
+        free(jobs[i].path);
+    }
+    free(lzTable);
+
+    pthread_cond_destroy(&finished);
+    pthread_cond_destroy(&submitted);
+    pthread_mutex_destroy(&lock);
+}
+
+bool
+SnapshotWorker::addToHistory(Snapshot *snapshot, uint64_t cycle, unsigned epoch)
+{
+    return submit(snapshot, NULL, false, cycle, epoch);
+}
+
+void
+SnapshotWorker::writeToFile(Snapshot *snapshot, const char *path)
+{
+    assert(path != NULL);
+    submit(snapshot, path, true);
+}
+
+void
+SnapshotWorker::waitUntilIdle()
+{
+    pthread_mutex_lock(&lock);
+    while (count)
+        pthread_cond_wait(&finished, &lock);
+    pthread_mutex_unlock(&lock);
+}
+
+uint64_t
+SnapshotWorker::getDropped()
+{
+    pthread_mutex_lock(&lock);
+    uint64_t result = dropped;
+    pthread_mutex_unlock(&lock);
+    return result;
+}
+
+bool
+SnapshotWorker::submit(Snapshot *snapshot, const char *path, bool wait, uint64_t cycle, unsigned epoch)
+{
+    assert(snapshot != NULL);
+
+    pthread_mutex_lock(&lock);
+
+    if (!running) {
+        if (pthread_create(&thread, NULL, threadMain, (void *)this) != 0) {
+            warn("Failed to start the snapshot worker thread\n");
+            if (path == NULL) dropped++;
+            pthread_mutex_unlock(&lock);
+            return false;
+        }
+        running = true;
+    }
+
+    // Wait for a free buffer or give up
+    if (count == POOL_SIZE && !wait) {
+        dropped++;
+        pthread_mutex_unlock(&lock);
+        return false;
+    }
+    while (count == POOL_SIZE)
+        pthread_cond_wait(&finished, &lock);
+
+    // The slot is owned by this thread until count is increased
+    Job *job = &jobs[(first + count) % POOL_SIZE];
+    pthread_mutex_unlock(&lock);
+
+    // Grow the buffer if needed (determining the size does not copy anything)
+    size_t size = snapshot->sizeOnDisk();
+    if (job->capacity < size) {
+        uint8_t *image = (uint8_t *)realloc(job->image, size);
+        if (image == NULL) {
+            warn("Failed to allocate %zu bytes for a snapshot image\n", size);
+            if (path == NULL) {
+                pthread_mutex_lock(&lock);
+                dropped++;
+                pthread_mutex_unlock(&lock);
+            }
+            return false;
+        }
+        job->image = image;
+        job->capacity = size;
+    }
+    job->size = snapshot->writeToBuffer(job->image);
+    assert(job->size == size);
+    job->timestamp = snapshot->getTimestamp();
+    job->cycle = cycle;
+    job->epoch = epoch;
+    free(job->path);
+    job->path = path ? strdup(path) : NULL;
+
+    pthread_mutex_lock(&lock);
+    count++;
+    pthread_cond_signal(&submitted);
+    pthread_mutex_unlock(&lock);
+    return true;
+}
+
+void
+SnapshotWorker::process(Job *job)
+{
+    if (job->path == NULL) {
+        history->add(job->image, job->size, job->timestamp, job->cycle, job->epoch, lzTable);
+        return;
+    }
+
+    bool success = false;
+    uint8_t *container;
+    FILE *file;
+
+    if ((container = (uint8_t *)malloc(Snapshot::maxContainerSize(job->size))) != NULL) {
+
+        size_t size = Snapshot::compressImage(job->image, job->size, container, lzTable);
+        if (size && (file = fopen(job->path, "w")) != NULL) {
+            success = fwrite(container, 1, size, file) == size;
+            success &= fclose(file) == 0;
+        }
+        free(container);
+    }
+
+    if (!success)
+        warn("Failed to write snapshot file %s\n", job->path);
+}
+
+void
+SnapshotWorker::run()
+{
+    pthread_mutex_lock(&lock);
+
+    while (true) {
+
+        while (count == 0 && !terminate)
+            pthread_cond_wait(&submitted, &lock);
+
+        if (count == 0)
+            break;
+
+        // The oldest job is owned by this thread until count is decreased
+        Job *job = &jobs[first];
+        pthread_mutex_unlock(&lock);
+        process(job);
+        pthread_mutex_lock(&lock);
+
+        first = (first + 1) % POOL_SIZE;
+        count--;
+        pthread_cond_broadcast(&finished);
+    }
+
+    pthread_mutex_unlock(&lock);
+}
+
+void *
+SnapshotWorker::threadMain(void *worker)
+{
+    ((SnapshotWorker *)worker)->run();
+    return NULL;
+}
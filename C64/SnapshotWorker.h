@@ -0,0 +1,146 @@
+/*!
+ * @header      SnapshotWorker.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _SNAPSHOTWORKER_INC
+#define _SNAPSHOTWORKER_INC
+
+#include "SnapshotHistory.h"
+
+/*! @class    SnapshotWorker
+ *  @brief    Background thread compressing and persisting snapshots
+ *  @details  The emulation thread only copies the snapshot image into one of POOL_SIZE pooled
+ *            buffers. Encoding the image into the time travel history, compressing it, and
+ *            writing it to disk is done by a separate thread which is started on demand.
+ *            Jobs are processed in the order they have been submitted. If all buffers are in
+ *            use, time travel snapshots are dropped and counted, because they are submitted by
+ *            the emulation thread which must never wait. Snapshot files are written on request
+ *            of the user. Hence, writeToFile() waits until the oldest job has been finished.
+ *            Jobs must not be submitted by more than one thread at a time.
+ */
+class SnapshotWorker : public VC64Object {
+
+public:
+
+    //! @brief    Number of pooled image buffers
+    static const unsigned POOL_SIZE = 4;
+
+private:
+
+    //! @brief    A pending job
+    typedef struct {
+
+        //! @brief    Raw snapshot image
+        uint8_t *image;
+        size_t size, capacity;
+
+        //! @brief    Creation date of the snapshot
+        time_t timestamp;
+
+        //! @brief    Emulated cycle and epoch of a time travel snapshot
+        uint64_t cycle;
+        unsigned epoch;
+
+        //! @brief    Target file or NULL if the image is added to the history
+        char *path;
+
+    } Job;
+
+    //! @brief    Ring buffer of jobs
+    Job jobs[POOL_SIZE];
+
+    //! @brief    Ring buffer position of the oldest pending job
+    unsigned first;
+
+    //! @brief    Number of submitted jobs that have not been finished yet
+    unsigned count;
+
+    //! @brief    Number of time travel snapshots dropped for lack of buffers or memory
+    uint64_t dropped;
+
+    //! @brief    History time travel images are added to
+    SnapshotHistory *history;
+
+    //! @brief    Hash table used by lzCompress() (worker thread only)
+    uint32_t *lzTable;
+
+    //! @brief    The worker thread
+    pthread_t thread;
+
+    //! @brief    Indicates if the worker thread has been started
+    bool running;
+
+    //! @brief    Asks the worker thread to terminate
+    bool terminate;
+
+    //! @brief    Protects all members above
+    pthread_mutex_t lock;
+
+    //! @brief    Signaled when a job has been submitted
+    pthread_cond_t submitted;
+
+    //! @brief    Signaled when a job has been finished
+    pthread_cond_t finished;
+
+public:
+
+    //! @brief    Constructor
+    SnapshotWorker(SnapshotHistory *history);
+
+    /*! @brief    Destructor
+     *  @details  Pending jobs are finished before the worker thread terminates.
+     */
+    ~SnapshotWorker();
+
+    /*! @brief    Copies a snapshot and adds it to the history in the background
+     *  @details  The snapshot is dropped if all buffers are in use or memory is exhausted.
+     *  @result   false, if the snapshot has been dropped
+     */
+    bool addToHistory(Snapshot *snapshot, uint64_t cycle, unsigned epoch);
+
+    /*! @brief    Copies a snapshot and writes it as a compressed container in the background
+     *  @details  A failure is reported via warn(), because the caller has returned already.
+     */
+    void writeToFile(Snapshot *snapshot, const char *path);
+
+    //! @brief    Waits until all submitted jobs have been finished
+    void waitUntilIdle();
+
+    //! @brief    Returns the number of time travel snapshots that have been dropped
+    uint64_t getDropped();
+
+private:
+
+    /*! @brief    Copies a snapshot into the next free pool buffer and wakes up the worker
+     *  @details  If no buffer is free, the function either waits for one or gives up.
+     *  @result   false, if the function has given up or if memory is exhausted
+     */
+    bool submit(Snapshot *snapshot, const char *path, bool wait, uint64_t cycle = 0, unsigned epoch = 0);
+
+    //! @brief    Processes a single job (called without holding the lock)
+    void process(Job *job);
+
+    //! @brief    Main loop of the worker thread
+    void run();
+
+    //! @brief    Entry point of the worker thread
+    static void *threadMain(void *worker);
+};
+
+#endif
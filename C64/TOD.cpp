@@ -23,15 +23,17 @@ TOD::TOD()
 	setDescription("TOD");
 	debug(3, "    Creating TOD at address %p...\n", this);
     
+    hostClock = true;
+    
     // Register snapshot items
     SnapshotItem items[] = {
                 
-        { &tod.value,   sizeof(tod.value),      CLEAR_ON_RESET },
-        { &alarm.value, sizeof(alarm.value),    CLEAR_ON_RESET },
-        { &latch.value, sizeof(latch.value),    CLEAR_ON_RESET },
-        { &frozen,      sizeof(frozen),         CLEAR_ON_RESET },
-        { &stopped,     sizeof(stopped),        CLEAR_ON_RESET },
-        { NULL,         0,                      0 }};
+        { "tod.value",   &tod.value,   sizeof(tod.value),      CLEAR_ON_RESET },
+        { "alarm.value", &alarm.value, sizeof(alarm.value),    CLEAR_ON_RESET },
+        { "latch.value", &latch.value, sizeof(latch.value),    CLEAR_ON_RESET },
+        { "frozen",      &frozen,      sizeof(frozen),         CLEAR_ON_RESET },
+        { "stopped",     &stopped,     sizeof(stopped),        CLEAR_ON_RESET },
+        { NULL,          NULL,         0,                      0 }};
     
     registerSnapshotItems(items, sizeof(items));
 }
@@ -44,16 +46,19 @@ void
 TOD::reset() 
 {
     time_t rawtime;
-    struct tm *timeinfo;
+    struct tm timeinfo;
     
     VirtualComponent::reset();
 
+    if (!hostClock)
+        return;
+    
     time(&rawtime);
-    timeinfo = localtime(&rawtime);
+    localtime_r(&rawtime, &timeinfo);
 
-    tod.time.seconds = BinaryToBCD((uint8_t)timeinfo->tm_sec);
-    tod.time.minutes = BinaryToBCD((uint8_t)timeinfo->tm_min);
-    tod.time.hours = BinaryToBCD((uint8_t)timeinfo->tm_hour);
+    tod.time.seconds = BinaryToBCD((uint8_t)timeinfo.tm_sec);
+    tod.time.minutes = BinaryToBCD((uint8_t)timeinfo.tm_min);
+    tod.time.hours = BinaryToBCD((uint8_t)timeinfo.tm_hour);
 }
 
 size_t
@@ -60,6 +60,12 @@ private:
      */
 	bool stopped;
 	
+    /*! @brief    If set to true, the clock starts with the time of the host
+     *  @details  Otherwise, it starts at 00:00:00. A fixed start time makes headless runs
+     *            reproducible.
+     */
+    bool hostClock;
+    
 
 public:
 	//! @brief    Constructor
@@ -71,6 +77,12 @@ public:
 	//! @brief    Restores the initial state.
 	void reset();
 	
+    //! @brief    Returns true iff the clock starts with the time of the host
+    bool getHostClock() { return hostClock; }
+    
+    //! @brief    Makes the clock start with the time of the host (takes effect on reset)
+    void setHostClock(bool value) { hostClock = value; }
+	
     //! @brief    Returns the size of the internal state.
     size_t stateSize();
     
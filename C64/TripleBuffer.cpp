@@ -0,0 +1,117 @@
+/*
+ * Author: Dirk W. Hoffmann, www.dirkwhoffmann.de
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "TripleBuffer.h"
+
+TripleBuffer::TripleBuffer()
+{
+    setDescription("TripleBuffer");
+
+    memset(slots, 0, sizeof(slots));
+    for (unsigned i = 0; i < SLOTS; i++)
+        readers[i] = 0;
+    latest = 0;
+    back = 1;
+    published = 0;
+    discarded = 0;
+}
+
+bool
+TripleBuffer::publish(uint64_t frame)
+{
+    unsigned current = latest.load();
+
+    // Prefer the slot that is neither the back buffer nor the latest frame (numbers add up to 3)
+    unsigned next = 3 - back - current;
+    if (!claim(next)) {
+        
+        // The slot is held by a consumer. Take over the latest frame if nobody reads it.
+        next = current;
+        if (!claim(next)) {
+            discarded++;
+            return false;
+        }
+    }
+
+    slots[back].frame = frame;
+    slots[back].sequence = ++published;
+    slots[back].timestamp = kernelTime();
+
+    latest.store(back);
+    readers[next] -= CLAIMED;
+    back = next;
+    return true;
+}
+
+bool
+TripleBuffer::claim(unsigned slot)
+{
+    unsigned expected = 0;
+    return readers[slot].compare_exchange_strong(expected, CLAIMED);
+}
+
+void
+TripleBuffer::initConsumer(FrameConsumer *consumer)
+{
+    assert(consumer != NULL);
+
+    memset(consumer, 0, sizeof(FrameConsumer));
+    consumer->slot = -1;
+}
+
+const ScreenFrame *
+TripleBuffer::acquire(FrameConsumer *consumer)
+{
+    assert(consumer != NULL);
+
+    release(consumer);
+
+    // Pin the latest slot and check that it has neither been claimed nor replaced meanwhile
+    unsigned slot;
+    while (true) {
+        slot = latest.load();
+        if (!(readers[slot]++ & CLAIMED) && latest.load() == slot)
+            break;
+        readers[slot]--;
+    }
+    consumer->slot = slot;
+
+    // Update statistics
+    const ScreenFrame *result = &slots[slot];
+    if (consumer->received && result->sequence == consumer->sequence) {
+        consumer->duplicated++;
+    } else {
+        if (consumer->received && result->sequence > consumer->sequence + 1)
+            consumer->dropped += result->sequence - consumer->sequence - 1;
+        consumer->received++;
+    }
+    consumer->sequence = result->sequence;
+
+    return result;
+}
+
+void
+TripleBuffer::release(FrameConsumer *consumer)
+{
+    assert(consumer != NULL);
+
+    if (consumer->slot >= 0) {
+        readers[consumer->slot]--;
+        consumer->slot = -1;
+    }
+}
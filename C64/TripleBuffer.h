@@ -0,0 +1,174 @@
+/*!
+ * @header      TripleBuffer.h
+ * @author      Dirk W. Hoffmann, www.dirkwhoffmann.de
+ * @copyright   2018 Dirk W. Hoffmann
+ */
+/*              This program is free software; you can redistribute it and/or modify
+ *              it under the terms of the GNU General Public License as published by
+ *              the Free Software Foundation; either version 2 of the License, or
+ *              (at your option) any later version.
+ *
+ *              This program is distributed in the hope that it will be useful,
+ *              but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *              MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *              GNU General Public License for more details.
+ *
+ *              You should have received a copy of the GNU General Public License
+ *              along with this program; if not, write to the Free Software
+ *              Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _TRIPLEBUFFER_INC
+#define _TRIPLEBUFFER_INC
+
+#include "VC64Object.h"
+#include "VIC_globals.h"
+#include <atomic>
+
+//! @brief    A completely drawn frame
+typedef struct {
+
+    //! @brief    Palette indices (0 to 15) as written by the pixel engine
+    uint8_t indices[PAL_RASTERLINES][NTSC_PIXELS];
+
+    //! @brief    RGBA version of indices (stale if the pixel engine runs in indexed output mode)
+    int rgba[PAL_RASTERLINES][NTSC_PIXELS];
+
+    //! @brief    Value of C64::frame when the frame was completed
+    uint64_t frame;
+
+    //! @brief    Number of frames published before this one
+    uint64_t sequence;
+
+    //! @brief    Publication time in kernel time units (see kernelTime())
+    uint64_t timestamp;
+
+} ScreenFrame;
+
+/*! @brief    Per consumer bookkeeping
+ *  @details  Each thread reading frames owns one of these. It has to be initialized with
+ *            TripleBuffer::initConsumer() before first use.
+ */
+typedef struct {
+
+    //! @brief    Slot held by the consumer or -1
+    int slot;
+
+    //! @brief    Sequence number of the most recently acquired frame
+    uint64_t sequence;
+
+    //! @brief    Number of distinct frames acquired
+    uint64_t received;
+
+    //! @brief    Number of published frames the consumer never got to see
+    uint64_t dropped;
+
+    //! @brief    Number of times the consumer got the same frame again
+    uint64_t duplicated;
+
+} FrameConsumer;
+
+/*! @class    TripleBuffer
+ *  @brief    Lock-free handoff of finished frames from the emulation thread to its consumers
+ *  @details  One of the three slots is the back buffer the pixel engine draws into, one holds
+ *            the latest published frame, and the third one is either free or still held by a
+ *            consumer that has acquired an older frame. Publishing a frame atomically makes
+ *            the back buffer the latest frame and takes over the third slot as the new back
+ *            buffer. If the third slot is still held by a consumer, the previous frame is
+ *            taken over instead. Only if both are held, the finished frame is discarded and
+ *            the emulator keeps drawing into the same back buffer. Hence, the emulation thread
+ *            never waits.
+ *            Consumers pin the latest frame by incrementing the reader count of its slot and
+ *            verifying afterwards that the slot is still the latest one. Before a slot becomes
+ *            the back buffer, the emulation thread claims it by setting the CLAIMED flag in
+ *            the reader count, which only succeeds if nobody reads it. Consumers never pin a
+ *            claimed slot, hence a pinned slot is never drawn into. Consumers should copy the
+ *            frame out and release it right away.
+ */
+class TripleBuffer : public VC64Object {
+
+public:
+
+    //! @brief    Number of slots
+    static const unsigned SLOTS = 3;
+
+private:
+
+    //! @brief    Reader count flag marking a slot that is about to become the back buffer
+    static const unsigned CLAIMED = 0x80000000;
+
+    //! @brief    Frame storage
+    ScreenFrame slots[SLOTS];
+
+    //! @brief    Slot holding the latest published frame
+    std::atomic<unsigned> latest;
+
+    //! @brief    Number of consumers holding each slot (plus CLAIMED)
+    std::atomic<unsigned> readers[SLOTS];
+
+    //! @brief    Slot the pixel engine draws into (owned by the emulation thread)
+    unsigned back;
+
+    //! @brief    Number of published frames (owned by the emulation thread)
+    uint64_t published;
+
+    //! @brief    Number of finished frames that could not be published
+    std::atomic<uint64_t> discarded;
+
+public:
+
+    //! @brief    Constructor
+    TripleBuffer();
+
+    //
+    //! @functiongroup Producing frames (emulation thread only)
+    //
+
+    //! @brief    Returns the frame that is currently drawn
+    ScreenFrame *backFrame() { return &slots[back]; }
+
+    /*! @brief    Returns a slot
+     *  @details  Only to be used for initializing the buffers before consumers are started.
+     */
+    ScreenFrame *getSlot(unsigned nr) { assert(nr < SLOTS); return &slots[nr]; }
+
+    /*! @brief    Publishes the back buffer
+     *  @details  Returns false if the frame has been discarded, because all other slots are
+     *            held by consumers. In that case, the back buffer stays the same.
+     */
+    bool publish(uint64_t frame);
+
+private:
+
+    //! @brief    Reserves a slot nobody reads as the next back buffer
+    bool claim(unsigned slot);
+
+public:
+
+    //
+    //! @functiongroup Consuming frames (any thread)
+    //
+
+    //! @brief    Prepares a consumer for its first acquire()
+    static void initConsumer(FrameConsumer *consumer);
+
+    /*! @brief    Pins the latest published frame
+     *  @details  The frame stays valid until it is released by the same consumer. Acquiring
+     *            the next frame releases the previous one automatically.
+     */
+    const ScreenFrame *acquire(FrameConsumer *consumer);
+
+    //! @brief    Unpins the frame held by the consumer
+    void release(FrameConsumer *consumer);
+
+    /*! @brief    Returns the latest published frame without pinning it
+     *  @details  The result may change while it is read, unless it is read by the emulation
+     *            thread or the emulator is halted.
+     */
+    ScreenFrame *latestFrame() { return &slots[latest.load()]; }
+
+    //! @brief    Returns the number of frames that have been discarded by publish()
+    uint64_t getDiscarded() { return discarded.load(); }
+};
+
+#endif
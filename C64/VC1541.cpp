@@ -35,29 +35,34 @@ VC1541::VC1541()
     SnapshotItem items[] = {
 
         // Configuration items
-        { &bitAccuracy,             sizeof(bitAccuracy),            KEEP_ON_RESET },
-        { &sendSoundMessages,       sizeof(sendSoundMessages),      KEEP_ON_RESET },
+        { "bitAccuracy",           &bitAccuracy,             sizeof(bitAccuracy),            KEEP_ON_RESET },
+        { "sendSoundMessages",     &sendSoundMessages,       sizeof(sendSoundMessages),      KEEP_ON_RESET },
         
         // Internal state
-        { &bitReadyTimer,           sizeof(bitReadyTimer),          CLEAR_ON_RESET },
-        { &byteReadyCounter,        sizeof(byteReadyCounter),       CLEAR_ON_RESET },
-        { &rotating,                sizeof(rotating),               CLEAR_ON_RESET },
-        { &redLED,                  sizeof(redLED),                 CLEAR_ON_RESET },
-        { &diskPartiallyInserted,   sizeof(diskPartiallyInserted),  CLEAR_ON_RESET },
-        { &halftrack,               sizeof(halftrack),              CLEAR_ON_RESET },
-        { &bitoffset,               sizeof(bitoffset),              CLEAR_ON_RESET },
-        { &zone,                    sizeof(zone),                   CLEAR_ON_RESET },
-        { &read_shiftreg,           sizeof(read_shiftreg),          CLEAR_ON_RESET },
-        { &write_shiftreg,          sizeof(write_shiftreg),         CLEAR_ON_RESET },
-        { &sync,                    sizeof(sync),                   CLEAR_ON_RESET },
+        { "bitReadyTimer",         &bitReadyTimer,           sizeof(bitReadyTimer),          CLEAR_ON_RESET },
+        { "byteReadyCounter",      &byteReadyCounter,        sizeof(byteReadyCounter),       CLEAR_ON_RESET },
+        { "rotating",              &rotating,                sizeof(rotating),               CLEAR_ON_RESET },
+        { "redLED",                &redLED,                  sizeof(redLED),                 CLEAR_ON_RESET },
+        { "diskPartiallyInserted", &diskPartiallyInserted,   sizeof(diskPartiallyInserted),  CLEAR_ON_RESET },
+        { "halftrack",             &halftrack,               sizeof(halftrack),              CLEAR_ON_RESET },
+        { "bitoffset",             &bitoffset,               sizeof(bitoffset),              CLEAR_ON_RESET },
+        { "zone",                  &zone,                    sizeof(zone),                   CLEAR_ON_RESET },
+        { "read_shiftreg",         &read_shiftreg,           sizeof(read_shiftreg),          CLEAR_ON_RESET },
+        { "write_shiftreg",        &write_shiftreg,          sizeof(write_shiftreg),         CLEAR_ON_RESET },
+        { "sync",                  &sync,                    sizeof(sync),                   CLEAR_ON_RESET },
+        { "sleeping",              &sleeping,                sizeof(sleeping),               CLEAR_ON_RESET },
+        { "idleCycles",            &idleCycles,              sizeof(idleCycles),             CLEAR_ON_RESET },
         
         // Disk properties (will survive reset)
-        { &diskInserted,            sizeof(diskInserted),           KEEP_ON_RESET },
-        { NULL,                     0,                              0 }};
+        { "diskInserted",          &diskInserted,            sizeof(diskInserted),           KEEP_ON_RESET },
+        { NULL,                    NULL,                     0,                              0 }};
     
     registerSnapshotItems(items, sizeof(items));
     
     sendSoundMessages = true;
+    idleSleep = true;
+    sleeping = false;
+    idleCycles = 0;
     resetDisk();
 }
 
@@ -77,6 +82,9 @@ VC1541::reset()
     
     cpu.setPC(0xEAA0);
     halftrack = 41;
+    
+    sleeping = false;
+    idleCycles = 0;
 }
 
 void
@@ -115,6 +123,7 @@ VC1541::dumpState()
 	msg("   Head position : Track %d, Bit offset %d\n", halftrack, bitoffset);
 	msg("            SYNC : %d\n", sync);
     msg("       Read mode : %s\n", readMode() ? "YES" : "NO");
+    msg("          Parked : %s (%llu cycles)\n", sleeping ? "YES" : "NO", (unsigned long long)idleCycles);
 	msg("\n");
     disk.dumpState();
 }
@@ -130,13 +139,26 @@ VC1541::powerUp() {
 bool
 VC1541::executeOneCycle() {
     
+    if (sleeping) {
+        
+        // Opening the lid has to be noticed by the DOS interrupt routine
+        if (idleSleep && !diskPartiallyInserted) {
+            idleCycles++;
+            return true;
+        }
+        wakeUp();
+    }
+    
     via1.execute();
     via2.execute();
     uint8_t result = cpu.executeOneCycle();
     
     // Only proceed if drive is active
-    if (!rotating)
+    if (!rotating) {
+        if (cpu.getPC() == IDLE_LOOP_END && canSleep())
+            sleeping = true;
         return result;
+    }
     
     // If bit accurate emulation is enabled, we don't do anything here
     if (!bitAccuracy) {
@@ -155,6 +177,30 @@ VC1541::executeOneCycle() {
     return result;
 }
 
+bool
+VC1541::canSleep()
+{
+    return
+    idleSleep &&
+    cpu.atBeginningOfNewCommand() &&
+    !cpu.getIRQLine(0xFF) &&
+    !diskPartiallyInserted &&
+    !c64->iec.isBusy();
+}
+
+void
+VC1541::wakeUp()
+{
+    if (!sleeping)
+        return;
+    
+    via1.fastForward(idleCycles);
+    via2.fastForward(idleCycles);
+    
+    sleeping = false;
+    idleCycles = 0;
+}
+
 void
 VC1541::executeBitReady()
 {
@@ -390,6 +436,9 @@ VC1541::ejectDisk()
     if (!hasDisk())
         return;
     
+    if (c64->interceptInput(INPUT_EJECT_DISK))
+        return;
+    
 	// Open lid (this blocks the light barrier)
     setDiskPartiallyInserted(true);
 
@@ -119,6 +119,12 @@ public:
     //! @brief    Enables or disables bit accurate drive emulation.
     void setBitAccuracy(bool b);
 
+    //! @brief    Returns true if the drive is parked while DOS is waiting in its idle loop.
+    inline bool getIdleSleep() { return idleSleep; }
+
+    //! @brief    Enables or disables parking the drive in its idle loop.
+    inline void setIdleSleep(bool b) { idleSleep = b; }
+
     
     //
     //! @functiongroup Accessing drive properties
@@ -194,8 +200,25 @@ public:
      */
     bool executeOneCycle();
 
+    /*! @brief    Wakes up a parked drive
+     *  @details  The VIA timers are fast-forwarded by the number of skipped cycles. The function
+     *            is called by the IEC bus whenever one of the bus lines changes its value. It is
+     *            safe to call the function if the drive is awake.
+     */
+    void wakeUp();
+
+    //! @brief    Returns true if the drive is currently parked in its idle loop.
+    inline bool isSleeping() { return sleeping; }
+
 private:
     
+    /*! @brief    Checks whether the drive can be parked
+     *  @details  The drive is parked when DOS reaches the end of its main loop with nothing to do,
+     *            i.e., the motor is off, no interrupt is pending, the light barrier is unblocked and
+     *            the IEC bus has been quiet for a while.
+     */
+    bool canSleep();
+    
     /*! @brief    Helper method for executeOneCycle
      *  @details  Method is executed whenever a single bit is ready
      */
@@ -240,6 +263,29 @@ private:
     //! @brief    Indicates whether the VC1541 shall provide sound notification messages to the GUI
     bool sendSoundMessages;
 
+    /*! @brief    Indicates whether the drive is parked while DOS is idle
+     *  @details  When enabled, the drive CPU is suspended as soon as it enters the idle loop of the DOS
+     *            with the motor switched off. While parked, the drive only counts the elapsed cycles.
+     *            Periodic job loop interrupts that would have been triggered in the meantime collapse
+     *            into a single one when the drive wakes up.
+     */
+    bool idleSleep;
+    
+    /*! @brief    Indicates whether the drive is currently parked
+     *  @details  Both sleeping and idleCycles are part of the snapshot. Hence, saving or restoring
+     *            the state does not wake up the drive and does not alter later execution.
+     */
+    bool sleeping;
+    
+    //! @brief    Number of cycles elapsed since the drive was parked
+    uint64_t idleCycles;
+    
+    /*! @brief    Address of the instruction closing the DOS main loop
+     *  @details  VC1541 DOS reaches this instruction in each iteration of its main loop ($EBFF) if there
+     *            is nothing to do.
+     */
+    static const uint16_t IDLE_LOOP_END = 0xEC9B;
+
 
     // ---------------------------------------------------------------------------------------------
     //                                  Read/Write logic
@@ -26,11 +26,12 @@ VC1541Memory::VC1541Memory()
     // Register snapshot items
     SnapshotItem items[] = {
 
-    { mem,              0xC000,     CLEAR_ON_RESET },
-    { &mem[0xC000],     0x4000,     KEEP_ON_RESET  }, /* VC1541 Rom */
-    { NULL,             0,          0 }};
+    { "mem", mem,              0xC000,     CLEAR_ON_RESET, ramDirty, 0x100 },
+    { "rom", &mem[0xC000],     0x4000,     KEEP_ON_RESET | BLOB_REFERENCE, &romDirty }, /* VC1541 Rom */
+    { NULL,  NULL,             0,          0 }};
 
     registerSnapshotItems(items, sizeof(items));
+    memset(ramDirty, 1, sizeof(ramDirty));
 
 	romFile = NULL;
 }
@@ -38,6 +39,8 @@ VC1541Memory::VC1541Memory()
 VC1541Memory::~VC1541Memory()
 {
 	debug(3, "  Releasing VC1541 memory at %p...\n", this);
+    
+    free(romFile);
 }
 
 void 
@@ -73,6 +76,7 @@ bool
 VC1541Memory::loadRom(const char *filename)
 {
 	if (is1541Rom(filename)) {
+		free(romFile);
 		romFile = strdup(filename);
 		flashRom(filename, 0xC000);
 		return true;
@@ -131,35 +135,18 @@ VC1541Memory::peekIO(uint16_t addr)
 	}
 }
 
-uint8_t 
-VC1541Memory::peek(uint16_t addr)
-{
-	uint8_t result;
-	
-	if (addr >= 0xc000) { 
-		// ROM
-		result = mem[addr];
-	} else if (addr < 0x1000) { // TODO: Check if 0x1000 is the correct value
-		// RAM (bitmask is applied because RAM repeats multiple times)
-		result = mem[addr & 0x07ff]; 		
-	} else { 
-		// IO space
-		result = peekIO(addr);
-	}
-	
-	return result;
-}
-	
 void 
 VC1541Memory::pokeRam(uint16_t addr, uint8_t value)
 {
 	mem[addr] = value;
+    if (addr < 0xC000) ramDirty[addr >> 8] = 1; else romDirty = 1;
 }
 
 void 
 VC1541Memory::pokeRom(uint16_t addr, uint8_t value)
 {
 	mem[addr] = value;
+    if (addr < 0xC000) ramDirty[addr >> 8] = 1; else romDirty = 1;
 }
              
 void 
@@ -173,18 +160,5 @@ VC1541Memory::pokeIO(uint16_t addr, uint8_t value)
 		// No memory here, nothing happens
 	}
 }
-			 			 
-void 
-VC1541Memory::poke(uint16_t addr, uint8_t value)
-{
-	if (addr < 0x1000) {
-		// RAM (repeats multiply times, hence we apply a bitmask)
-		mem[addr & 0x7ff] = value;
-	} else if (addr >= 0xc000) { 
-		// ROM (poking to ROM has no effect)
-	} else {
-		// IO space
-		pokeIO(addr, value);
-	}
-}
+
 
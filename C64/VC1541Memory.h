@@ -39,6 +39,18 @@ public:
 		
 	//! @brief    The VC1541s memory space
 	uint8_t mem[65536];
+
+    /*! @brief    Dirty map of the RAM area
+     *  @details  ramDirty[i] is set whenever page i (256 bytes) below the ROM is written to.
+     *            Only the first eight pages are backed by real RAM.
+     */
+    uint8_t ramDirty[0xC0];
+    
+    /*! @brief    Indicates that the ROM has been modified
+     *  @details  A modified ROM is rehashed when the next snapshot is taken.
+     *  @see      BlobStore
+     */
+    uint8_t romDirty;
 	
     /*! @brief    File name of the VC1541 ROM image.
      *  @details  The file name is set in loadRom(). It is saved for further reference, so the ROM can be reloaded
@@ -82,12 +94,44 @@ public:
 	uint8_t peekRam(uint16_t addr);
 	uint8_t peekRom(uint16_t addr);
 	uint8_t peekIO(uint16_t addr);
-	uint8_t peek(uint16_t addr);             
 	                  																
 	void pokeRam(uint16_t addr, uint8_t value);                  
 	void pokeRom(uint16_t addr, uint8_t value);             
 	void pokeIO(uint16_t addr, uint8_t value);
-	void poke(uint16_t addr, uint8_t value);
+
+    /*! @brief    Reads a value from memory
+     *  @details  Defined inline, because the drive CPU calls this function directly.
+     */
+	inline uint8_t peek(uint16_t addr) {
+
+        if (addr >= 0xc000) {
+            // ROM
+            return mem[addr];
+        } else if (addr < 0x1000) { // TODO: Check if 0x1000 is the correct value
+            // RAM (bitmask is applied because RAM repeats multiple times)
+            return mem[addr & 0x07ff];
+        } else {
+            // IO space
+            return peekIO(addr);
+        }
+    }
+
+    /*! @brief    Writes a value into memory
+     *  @details  Defined inline, because the drive CPU calls this function directly.
+     */
+	inline void poke(uint16_t addr, uint8_t value) {
+
+        if (addr < 0x1000) {
+            // RAM (repeats multiply times, hence we apply a bitmask)
+            mem[addr & 0x7ff] = value;
+            ramDirty[(addr & 0x7ff) >> 8] = 1;
+        } else if (addr >= 0xc000) {
+            // ROM (poking to ROM has no effect)
+        } else {
+            // IO space
+            pokeIO(addr, value);
+        }
+    }
 };
 
 #endif
@@ -27,8 +27,6 @@ VC64Object::VC64Object()
 
 VC64Object::~VC64Object()
 {
-    if (logfile)
-        fclose(logfile);
 }
 
 unsigned VC64Object::defaultDebugLevel = 1;
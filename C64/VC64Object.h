@@ -34,7 +34,9 @@ private:
     /*! @brief    Log file.
      *  @details  By default, this variable is NULL and all debug and trace messages are sent to
      *            stdout or stderr. Assign a file handle, if you wish to send debug output to a file.
-     *  @note     logfile is a class member, i.e., it is shared among all objects
+     *  @note     logfile is a class member, i.e., it is shared among all objects.
+     *            The file handle is owned by the caller of setLogfile and is never closed
+     *            by a VC64Object.
      */
     static FILE *logfile;
 
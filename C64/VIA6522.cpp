@@ -30,21 +30,21 @@ VIA6522::VIA6522()
     
     // Register snapshot items
     SnapshotItem items[] = {
-        { &ddra,            sizeof(ddra),           CLEAR_ON_RESET },
-        { &ddrb,            sizeof(ddrb),           CLEAR_ON_RESET },
-        { &ora,             sizeof(ora),            CLEAR_ON_RESET },
-        { &orb,             sizeof(orb),            CLEAR_ON_RESET },
-        { &ira,             sizeof(ira),            CLEAR_ON_RESET },
-        { &irb,             sizeof(irb),            CLEAR_ON_RESET },
-        { &t1,              sizeof(t1),             CLEAR_ON_RESET },
-        { &t2,              sizeof(t2),             CLEAR_ON_RESET },
-        { &t1_latch_lo,     sizeof(t1_latch_lo),    CLEAR_ON_RESET },
-        { &t1_latch_hi,     sizeof(t1_latch_hi),    CLEAR_ON_RESET },
-        { &t2_latch_lo,     sizeof(t2_latch_lo),    CLEAR_ON_RESET },
-        { &t1_underflow,    sizeof(t1_underflow),   CLEAR_ON_RESET },
-        { &t2_underflow,    sizeof(t2_underflow),   CLEAR_ON_RESET },
-        { io,               sizeof(io),             CLEAR_ON_RESET },
-        { NULL,             0,                      0 }};
+        { "ddra",         &ddra,            sizeof(ddra),           CLEAR_ON_RESET },
+        { "ddrb",         &ddrb,            sizeof(ddrb),           CLEAR_ON_RESET },
+        { "ora",          &ora,             sizeof(ora),            CLEAR_ON_RESET },
+        { "orb",          &orb,             sizeof(orb),            CLEAR_ON_RESET },
+        { "ira",          &ira,             sizeof(ira),            CLEAR_ON_RESET },
+        { "irb",          &irb,             sizeof(irb),            CLEAR_ON_RESET },
+        { "t1",           &t1,              sizeof(t1),             CLEAR_ON_RESET },
+        { "t2",           &t2,              sizeof(t2),             CLEAR_ON_RESET },
+        { "t1_latch_lo",  &t1_latch_lo,     sizeof(t1_latch_lo),    CLEAR_ON_RESET },
+        { "t1_latch_hi",  &t1_latch_hi,     sizeof(t1_latch_hi),    CLEAR_ON_RESET },
+        { "t2_latch_lo",  &t2_latch_lo,     sizeof(t2_latch_lo),    CLEAR_ON_RESET },
+        { "t1_underflow", &t1_underflow,    sizeof(t1_underflow),   CLEAR_ON_RESET },
+        { "t2_underflow", &t2_underflow,    sizeof(t2_underflow),   CLEAR_ON_RESET },
+        { "io",           io,               sizeof(io),             CLEAR_ON_RESET },
+        { NULL,           NULL,             0,                      0 }};
     
     registerSnapshotItems(items, sizeof(items));
 }
@@ -146,6 +146,70 @@ VIA6522::executeTimer2()
     }
 }
 
+void
+VIA6522::fastForward(uint64_t cycles)
+{
+    fastForwardTimer1(cycles);
+    fastForwardTimer2(cycles);
+}
+
+void
+VIA6522::fastForwardTimer1(uint64_t cycles)
+{
+    while (cycles) {
+        
+        if (t1_underflow) {
+            executeTimer1();
+            cycles--;
+            continue;
+        }
+        
+        // Nothing to do if the timer has stopped
+        if (t1 == 0)
+            return;
+        
+        if (cycles < t1) {
+            t1 -= cycles;
+            return;
+        }
+        
+        cycles -= t1;
+        t1 = 0;
+        t1_underflow = true;
+        
+        // In free-run mode, the underflow state recurs every latch + 1 cycles
+        uint16_t latch = HI_LO(t1_latch_hi, t1_latch_lo);
+        if (freeRunMode1() && latch && cycles > latch) {
+            setInterruptFlag_T1();
+            cycles %= (uint64_t)latch + 1;
+        }
+    }
+}
+
+void
+VIA6522::fastForwardTimer2(uint64_t cycles)
+{
+    if (t2_underflow && cycles) {
+        executeTimer2();
+        cycles--;
+    }
+    
+    if (t2 == 0 || cycles == 0)
+        return;
+
+    if (cycles < t2) {
+        t2 -= cycles;
+        return;
+    }
+    
+    cycles -= t2;
+    t2 = 0;
+    t2_underflow = true;
+    
+    if (cycles)
+        executeTimer2();
+}
+
 bool
 VIA6522::IRQ() {
     if (io[0xD] /* IFR */ & io[0xE] /* IER */) {
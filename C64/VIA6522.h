@@ -126,6 +126,23 @@ public:
 
     //! @brief    Executes timer 2 for one cycle.
     void executeTimer2();
+
+    /*! @brief    Advances both timers by the specified number of cycles
+     *  @details  The resulting state is the same as calling execute() repeatedly, except that multiple
+     *            timer interrupts collapse into a single one. The function is used to catch up with a
+     *            drive that has been parked in its idle loop.
+     */
+    void fastForward(uint64_t cycles);
+
+private:
+
+    //! @brief    Advances timer 1 by the specified number of cycles
+    void fastForwardTimer1(uint64_t cycles);
+
+    //! @brief    Advances timer 2 by the specified number of cycles
+    void fastForwardTimer2(uint64_t cycles);
+
+public:
 	
 	/*! @brief    Special peek function for the I/O memory range
 	 *  @details  The peek function only handles those registers that are treated similarily by both VIA chips
@@ -44,56 +44,56 @@ VIC::VIC()
     SnapshotItem items[] = {
 
         // Configuration items
-        { &chipModel,                   sizeof(chipModel),                      KEEP_ON_RESET },
+        { "chipModel",                   &chipModel,                   sizeof(chipModel),                      KEEP_ON_RESET },
         
         // Internal state
-        { &p.xCounter,                  sizeof(p.xCounter),                     CLEAR_ON_RESET },
-        { p.spriteX,                    sizeof(p.spriteX),                      CLEAR_ON_RESET | WORD_FORMAT },
-        { &p.spriteXexpand,             sizeof(p.spriteXexpand),                CLEAR_ON_RESET },
-        { &p.registerCTRL1,             sizeof(p.registerCTRL1),                CLEAR_ON_RESET },
-        { &p.registerCTRL2,             sizeof(p.registerCTRL2),                CLEAR_ON_RESET },
-        { &p.g_data,                    sizeof(p.g_data),                       CLEAR_ON_RESET },
-        { &p.g_character,               sizeof(p.g_character),                  CLEAR_ON_RESET },
-        { &p.g_color,                   sizeof(p.g_color),                      CLEAR_ON_RESET },
-        { &p.mainFrameFF,               sizeof(p.mainFrameFF),                  CLEAR_ON_RESET },
-        { &p.verticalFrameFF,           sizeof(p.verticalFrameFF),              CLEAR_ON_RESET },
-        { &bp.borderColor,              sizeof(bp.borderColor),                 CLEAR_ON_RESET },
-        { cp.backgroundColor,           sizeof(cp.backgroundColor),             CLEAR_ON_RESET | BYTE_FORMAT},
-        { sp.spriteColor,               sizeof(sp.spriteColor),                 CLEAR_ON_RESET | BYTE_FORMAT},
-        { &sp.spriteExtraColor1,        sizeof(sp.spriteExtraColor1),           CLEAR_ON_RESET },
-        { &sp.spriteExtraColor2,        sizeof(sp.spriteExtraColor2),           CLEAR_ON_RESET },
+        { "p.xCounter",                  &p.xCounter,                  sizeof(p.xCounter),                     CLEAR_ON_RESET },
+        { "p.spriteX",                   p.spriteX,                    sizeof(p.spriteX),                      CLEAR_ON_RESET | WORD_FORMAT },
+        { "p.spriteXexpand",             &p.spriteXexpand,             sizeof(p.spriteXexpand),                CLEAR_ON_RESET },
+        { "p.registerCTRL1",             &p.registerCTRL1,             sizeof(p.registerCTRL1),                CLEAR_ON_RESET },
+        { "p.registerCTRL2",             &p.registerCTRL2,             sizeof(p.registerCTRL2),                CLEAR_ON_RESET },
+        { "p.g_data",                    &p.g_data,                    sizeof(p.g_data),                       CLEAR_ON_RESET },
+        { "p.g_character",               &p.g_character,               sizeof(p.g_character),                  CLEAR_ON_RESET },
+        { "p.g_color",                   &p.g_color,                   sizeof(p.g_color),                      CLEAR_ON_RESET },
+        { "p.mainFrameFF",               &p.mainFrameFF,               sizeof(p.mainFrameFF),                  CLEAR_ON_RESET },
+        { "p.verticalFrameFF",           &p.verticalFrameFF,           sizeof(p.verticalFrameFF),              CLEAR_ON_RESET },
+        { "bp.borderColor",              &bp.borderColor,              sizeof(bp.borderColor),                 CLEAR_ON_RESET },
+        { "cp.backgroundColor",          cp.backgroundColor,           sizeof(cp.backgroundColor),             CLEAR_ON_RESET | BYTE_FORMAT},
+        { "sp.spriteColor",              sp.spriteColor,               sizeof(sp.spriteColor),                 CLEAR_ON_RESET | BYTE_FORMAT},
+        { "sp.spriteExtraColor1",        &sp.spriteExtraColor1,        sizeof(sp.spriteExtraColor1),           CLEAR_ON_RESET },
+        { "sp.spriteExtraColor2",        &sp.spriteExtraColor2,        sizeof(sp.spriteExtraColor2),           CLEAR_ON_RESET },
         
-        { &vblank,                      sizeof(vblank),                         CLEAR_ON_RESET },
-        { &yCounter,                    sizeof(yCounter),                       CLEAR_ON_RESET },
-        { &yCounterEqualsIrqRasterline, sizeof(yCounterEqualsIrqRasterline),    CLEAR_ON_RESET },
-        { &registerVC,                  sizeof(registerVC),                     CLEAR_ON_RESET },
-        { &registerVCBASE,              sizeof(registerVCBASE),                 CLEAR_ON_RESET },
-        { &registerRC,                  sizeof(registerRC),                     CLEAR_ON_RESET },
-        { &registerVMLI,                sizeof(registerVMLI),                   CLEAR_ON_RESET },
-        { &refreshCounter,              sizeof(refreshCounter),                 CLEAR_ON_RESET },
-        { &addrBus,                     sizeof(addrBus),                        CLEAR_ON_RESET },
-        { &dataBus,                     sizeof(dataBus),                        CLEAR_ON_RESET },
-        { &gAccessDisplayMode,          sizeof(gAccessDisplayMode),             CLEAR_ON_RESET },
-        { &gAccessfgColor,              sizeof(gAccessfgColor),                 CLEAR_ON_RESET },
-        { &gAccessbgColor,              sizeof(gAccessbgColor),                 CLEAR_ON_RESET },
-        { &badLineCondition,            sizeof(badLineCondition),               CLEAR_ON_RESET },
-        { &DENwasSetInRasterline30,     sizeof(DENwasSetInRasterline30),        CLEAR_ON_RESET },
-        { &displayState,                sizeof(displayState),                   CLEAR_ON_RESET },
-        { &BAlow,                       sizeof(BAlow),                          CLEAR_ON_RESET },
-        { &BAwentLowAtCycle,            sizeof(BAwentLowAtCycle),               CLEAR_ON_RESET },
-        { &iomem,                       sizeof(iomem),                          CLEAR_ON_RESET },
-        { &bankAddr,                    sizeof(bankAddr),                       CLEAR_ON_RESET },
-        { &isFirstDMAcycle,             sizeof(isFirstDMAcycle),                CLEAR_ON_RESET },
-        { &isSecondDMAcycle,            sizeof(isSecondDMAcycle),               CLEAR_ON_RESET },
-        { &mc,                          sizeof(mc),                             CLEAR_ON_RESET | BYTE_FORMAT },
-        { &mcbase,                      sizeof(mcbase),                         CLEAR_ON_RESET | BYTE_FORMAT },
-        { spritePtr,                    sizeof(spritePtr),                      CLEAR_ON_RESET | WORD_FORMAT },
-        { &spriteOnOff,                 sizeof(spriteOnOff),                    CLEAR_ON_RESET },
-        { &spriteDmaOnOff,              sizeof(spriteDmaOnOff),                 CLEAR_ON_RESET },
-        { &expansionFF,                 sizeof(expansionFF),                    CLEAR_ON_RESET },
-        { &cleared_bits_in_d017,        sizeof(cleared_bits_in_d017),           CLEAR_ON_RESET },
-        { &lightpenIRQhasOccured,       sizeof(lightpenIRQhasOccured),          CLEAR_ON_RESET },
-        { NULL,                         0,                                      0 }};
+        { "vblank",                      &vblank,                      sizeof(vblank),                         CLEAR_ON_RESET },
+        { "yCounter",                    &yCounter,                    sizeof(yCounter),                       CLEAR_ON_RESET },
+        { "yCounterEqualsIrqRasterline", &yCounterEqualsIrqRasterline, sizeof(yCounterEqualsIrqRasterline),    CLEAR_ON_RESET },
+        { "registerVC",                  &registerVC,                  sizeof(registerVC),                     CLEAR_ON_RESET },
+        { "registerVCBASE",              &registerVCBASE,              sizeof(registerVCBASE),                 CLEAR_ON_RESET },
+        { "registerRC",                  &registerRC,                  sizeof(registerRC),                     CLEAR_ON_RESET },
+        { "registerVMLI",                &registerVMLI,                sizeof(registerVMLI),                   CLEAR_ON_RESET },
+        { "refreshCounter",              &refreshCounter,              sizeof(refreshCounter),                 CLEAR_ON_RESET },
+        { "addrBus",                     &addrBus,                     sizeof(addrBus),                        CLEAR_ON_RESET },
+        { "dataBus",                     &dataBus,                     sizeof(dataBus),                        CLEAR_ON_RESET },
+        { "gAccessDisplayMode",          &gAccessDisplayMode,          sizeof(gAccessDisplayMode),             CLEAR_ON_RESET },
+        { "gAccessfgColor",              &gAccessfgColor,              sizeof(gAccessfgColor),                 CLEAR_ON_RESET },
+        { "gAccessbgColor",              &gAccessbgColor,              sizeof(gAccessbgColor),                 CLEAR_ON_RESET },
+        { "badLineCondition",            &badLineCondition,            sizeof(badLineCondition),               CLEAR_ON_RESET },
+        { "DENwasSetInRasterline30",     &DENwasSetInRasterline30,     sizeof(DENwasSetInRasterline30),        CLEAR_ON_RESET },
+        { "displayState",                &displayState,                sizeof(displayState),                   CLEAR_ON_RESET },
+        { "BAlow",                       &BAlow,                       sizeof(BAlow),                          CLEAR_ON_RESET },
+        { "BAwentLowAtCycle",            &BAwentLowAtCycle,            sizeof(BAwentLowAtCycle),               CLEAR_ON_RESET },
+        { "iomem",                       &iomem,                       sizeof(iomem),                          CLEAR_ON_RESET },
+        { "bankAddr",                    &bankAddr,                    sizeof(bankAddr),                       CLEAR_ON_RESET },
+        { "isFirstDMAcycle",             &isFirstDMAcycle,             sizeof(isFirstDMAcycle),                CLEAR_ON_RESET },
+        { "isSecondDMAcycle",            &isSecondDMAcycle,            sizeof(isSecondDMAcycle),               CLEAR_ON_RESET },
+        { "mc",                          &mc,                          sizeof(mc),                             CLEAR_ON_RESET | BYTE_FORMAT },
+        { "mcbase",                      &mcbase,                      sizeof(mcbase),                         CLEAR_ON_RESET | BYTE_FORMAT },
+        { "spritePtr",                   spritePtr,                    sizeof(spritePtr),                      CLEAR_ON_RESET | WORD_FORMAT },
+        { "spriteOnOff",                 &spriteOnOff,                 sizeof(spriteOnOff),                    CLEAR_ON_RESET },
+        { "spriteDmaOnOff",              &spriteDmaOnOff,              sizeof(spriteDmaOnOff),                 CLEAR_ON_RESET },
+        { "expansionFF",                 &expansionFF,                 sizeof(expansionFF),                    CLEAR_ON_RESET },
+        { "cleared_bits_in_d017",        &cleared_bits_in_d017,        sizeof(cleared_bits_in_d017),           CLEAR_ON_RESET },
+        { "lightpenIRQhasOccured",       &lightpenIRQhasOccured,       sizeof(lightpenIRQhasOccured),          CLEAR_ON_RESET },
+        { NULL,                          NULL,                         0,                                      0 }};
 
     registerSnapshotItems(items, sizeof(items));
 }
@@ -237,35 +237,12 @@ uint8_t VIC::memAccess(uint16_t addr)
     // 0x2000:   BLANK     RAM
     // 0x1000:   BLANK     CHAR
     // 0x0000:   RAM       RAM
-
-    if (!c64->getUltimax()) {
-        switch (addrBus >> 12) {
-            case 0x9:
-            case 0x1:
-                dataBus = c64->mem.rom[0xC000 + addr];
-                break;
-            default:
-                dataBus = c64->mem.ram[addrBus];
-        }
-    } else {
-        switch (addrBus >> 12) {
-            case 0xF:
-            case 0xB:
-            case 0x7:
-            case 0x3:
-                dataBus = c64->expansionport.peek(addrBus | 0xF000);
-                break;
-            case 0xE:
-            case 0xD:
-            case 0x9:
-            case 0x8:
-            case 0x0:
-                dataBus = c64->mem.ram[addrBus];
-                break;
-            default:
-                dataBus = c64->mem.ram[addrBus]; 
-        }
-    }
+    //
+    // The mapping is stored in the VIC read base pointer table of C64Memory.
+    // A NULL entry refers to the cartridge ROM (ROMH).
+    
+    uint8_t *base = c64->mem.vicReadBase[addrBus >> 12];
+    dataBus = base ? base[addrBus] : c64->expansionport.peek(addrBus | 0xF000);
    
     return dataBus;
 }
@@ -440,9 +440,32 @@ public:
 	//! @brief    Destructor
 	~VIC();
 	
-	//! @brief    Returns the screen buffer that is currently stable.
+	/*! @brief    Returns the screen buffer of the latest published frame.
+     *  @note     Emulation thread only (see PixelEngine::screenBuffer())
+     */
     inline void *screenBuffer() { return pixelEngine.screenBuffer(); }
 
+	//! @brief    Returns the triple buffer finished frames are published in
+    inline TripleBuffer *getFrames() { return &pixelEngine.frames; }
+
+	//! @brief    Returns the index buffer of the latest published frame (see PixelEngine::indexedOutput)
+    inline uint8_t *screenIndexBuffer() { return pixelEngine.screenIndexBuffer(); }
+
+	//! @brief    Returns true if the screen buffers are no longer filled with RGBA values
+    inline bool getIndexedOutput() { return pixelEngine.indexedOutput; }
+
+	//! @brief    Enables or disables the RGBA conversion of finished frames
+    inline void setIndexedOutput(bool b) { pixelEngine.indexedOutput = b; }
+
+	//! @brief    Enables or disables the canvas fast path (see PixelEngine::spanRendering)
+    inline void setSpanRendering(bool b) { pixelEngine.spanRendering = b; }
+
+	//! @brief    Returns the sixteen C64 colors in RGBA format
+    inline const uint32_t *getColors() { return pixelEngine.colors; }
+
+	//! @brief    Enables or disables pixel synthesis (see PixelEngine::silent)
+    inline void setSilent(bool b) { pixelEngine.silent = b; }
+
 	//! @brief    Restores the initial state.
 	void reset();
 		
@@ -24,8 +24,11 @@ VirtualComponent::VirtualComponent()
     running = false;
 	suspendCounter = 0;	
     snapshotItems = NULL;
+    stateLayout = NULL;
     subComponents = NULL;
     snapshotSize = 0;
+    incrementalSave = false;
+    foreignByteOrder = false;
 }
 
 VirtualComponent::~VirtualComponent()
@@ -37,6 +40,9 @@ VirtualComponent::~VirtualComponent()
 
     if (snapshotItems)
         delete [] snapshotItems;
+    
+    if (stateLayout)
+        delete [] stateLayout;
 }
 
 void
@@ -59,8 +65,11 @@ VirtualComponent::reset()
     // Clear snapshot items marked with 'CLEAR_ON_RESET'
     if (snapshotItems != NULL)
         for (unsigned i = 0; snapshotItems[i].data != NULL; i++)
-            if (snapshotItems[i].flags & CLEAR_ON_RESET)
+            if (snapshotItems[i].flags & CLEAR_ON_RESET) {
                 memset(snapshotItems[i].data, 0, snapshotItems[i].size);
+                if (snapshotItems[i].dirty)
+                    memset(snapshotItems[i].dirty, 1, numPages(&snapshotItems[i]));
+            }
     
     setTraceMode(false); 
     
@@ -173,9 +182,59 @@ VirtualComponent::registerSnapshotItems(SnapshotItem *items, unsigned length) {
     snapshotItems = new SnapshotItem[numItems];
     std::copy(items, items + numItems, &snapshotItems[0]);
     
+    // Blob references consist of a single page that needs to be hashed initially
+    for (i = 0; snapshotItems[i].data != NULL; i++) {
+        if (snapshotItems[i].flags & BLOB_REFERENCE) {
+            assert(snapshotItems[i].dirty != NULL);
+            snapshotItems[i].pageSize = snapshotItems[i].size;
+            *snapshotItems[i].dirty = 1;
+        }
+    }
+    
     // Determine size of snapshot on disk
     for (i = snapshotSize = 0; snapshotItems[i].data != NULL; i++)
-        snapshotSize += snapshotItems[i].size;
+        snapshotSize += (snapshotItems[i].flags & BLOB_REFERENCE) ? 8 : snapshotItems[i].size;
+    
+    // Dirty tracking is only supported for byte blocks
+    for (i = 0; snapshotItems[i].data != NULL; i++) {
+        if (snapshotItems[i].dirty) {
+            assert(snapshotItems[i].pageSize > 0);
+            assert((snapshotItems[i].flags & 0x0F) == BYTE_FORMAT ||
+                   ((snapshotItems[i].flags & 0x0F) == 0 && snapshotItems[i].size > 8));
+        }
+    }
+    
+    computeStateLayout(numItems);
+}
+
+void
+VirtualComponent::computeStateLayout(unsigned numItems)
+{
+    unsigned i, j;
+    
+    stateLayout = new StateChunk[numItems];
+    
+    for (i = j = 0; snapshotItems[i].data != NULL; i++) {
+        
+        SnapshotItem *item = &snapshotItems[i];
+        uint8_t *data = (uint8_t *)item->data;
+        bool special = item->dirty != NULL;
+        
+        // Extend the previous chunk if the item directly follows it in memory
+        if (!special && j > 0 && stateLayout[j - 1].item == NULL &&
+            stateLayout[j - 1].data + stateLayout[j - 1].size == data) {
+            stateLayout[j - 1].size += item->size;
+            continue;
+        }
+        
+        stateLayout[j].data = data;
+        stateLayout[j].size = item->size;
+        stateLayout[j].item = special ? item : NULL;
+        j++;
+    }
+    stateLayout[j].data = NULL;
+    
+    debug(3, "%d snapshot items merged into %d chunks\n", i, j);
 }
 
 void
@@ -218,36 +277,26 @@ VirtualComponent::loadFromBuffer(uint8_t **buffer)
             subComponents[i]->loadFromBuffer(buffer);
 
     // Load own internal state
-    void *data; size_t size; int flags;
-    for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
-        
-        data  = snapshotItems[i].data;
-        flags = snapshotItems[i].flags & 0x0F;
-        size  = snapshotItems[i].size;
-        
-        if (flags == 0) { // Auto detect size
-
-            switch (snapshotItems[i].size) {
-                case 1:  *(uint8_t *)data  = read8(buffer); break;
-                case 2:  *(uint16_t *)data = read16(buffer); break;
-                case 4:  *(uint32_t *)data = read32(buffer); break;
-                case 8:  *(uint64_t *)data = read64(buffer); break;
-                default: readBlock(buffer, (uint8_t *)data, size);
-            }
-
-        } else { // Format is specified manually
+    if (foreignByteOrder) {
+        loadForeignItems(buffer);
+    } else {
+        for (StateChunk *chunk = stateLayout; chunk != NULL && chunk->data != NULL; chunk++) {
             
-            switch (flags) {
-                case BYTE_FORMAT: readBlock(buffer, (uint8_t *)data, size); break;
-                case WORD_FORMAT: readBlock16(buffer, (uint16_t *)data, size); break;
-                case DOUBLE_WORD_FORMAT: readBlock32(buffer, (uint32_t *)data, size); break;
-                case QUAD_WORD_FORMAT: readBlock64(buffer, (uint64_t *)data, size); break;
-                default: assert(0);
+            SnapshotItem *item = chunk->item;
+            
+            if (item && (item->flags & BLOB_REFERENCE)) {
+                loadBlobReference(buffer, item);
+                continue;
             }
+            
+            if (item) // Loaded data is new to the incremental saver
+                memset(item->dirty, 1, numPages(item));
+            
+            readBlock(buffer, chunk->data, chunk->size);
         }
     }
     
-    if (*buffer - old != VirtualComponent::stateSize()) {
+    if ((size_t)(*buffer - old) != VirtualComponent::stateSize()) {
         panic("loadFromBuffer: Snapshot size is wrong.");
         assert(false);
     }
@@ -267,37 +316,290 @@ VirtualComponent::saveToBuffer(uint8_t **buffer)
     }
     
     // Save own internal state
-    void *data; size_t size; int flags;
+    for (StateChunk *chunk = stateLayout; chunk != NULL && chunk->data != NULL; chunk++) {
+        
+        SnapshotItem *item = chunk->item;
+        
+        if (item && (item->flags & BLOB_REFERENCE)) {
+            write64(buffer, blobReference(item));
+            continue;
+        }
+        
+        if (item && incrementalSave) {
+            writeDirtyPages(buffer, item);
+            continue;
+        }
+        
+        writeBlock(buffer, chunk->data, chunk->size);
+    }
+    
+    if ((size_t)(*buffer - old) != VirtualComponent::stateSize()) {
+        panic("saveToBuffer: Snapshot size is wrong.");
+        assert(false);
+    }
+}
+
+void
+VirtualComponent::loadForeignItems(uint8_t **buffer)
+{
     for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
         
-        data  = snapshotItems[i].data;
-        flags = snapshotItems[i].flags & 0x0F;
-        size  = snapshotItems[i].size;
+        SnapshotItem *item = &snapshotItems[i];
+        uint8_t *data = (uint8_t *)item->data;
+        
+        if (item->flags & BLOB_REFERENCE) {
+            loadBlobReference(buffer, item);
+            continue;
+        }
+        
+        if (item->dirty) // Loaded data is new to the incremental saver
+            memset(item->dirty, 1, numPages(item));
+        
+        readBlock(buffer, data, item->size);
+        
+        size_t width = elementSize(item);
+        for (size_t j = 0; width > 1 && j + width <= item->size; j += width)
+            std::reverse(data + j, data + j + width);
+    }
+}
 
-        if (flags == 0) { // Auto detect size
-            
-            switch (snapshotItems[i].size) {
-                case 1:  write8(buffer, *(uint8_t *)data); break;
-                case 2:  write16(buffer, *(uint16_t *)data); break;
-                case 4:  write32(buffer, *(uint32_t *)data); break;
-                case 8:  write64(buffer, *(uint64_t *)data); break;
-                default: writeBlock(buffer, (uint8_t *)data, size);
-            }
-            
-        } else { // Format is specified manually
-            
-            switch (flags) {
-                case BYTE_FORMAT: writeBlock(buffer, (uint8_t *)data, size); break;
-                case WORD_FORMAT: writeBlock16(buffer, (uint16_t *)data, size); break;
-                case DOUBLE_WORD_FORMAT: writeBlock32(buffer, (uint32_t *)data, size); break;
-                case QUAD_WORD_FORMAT: writeBlock64(buffer, (uint64_t *)data, size); break;
-                default: assert(0);
+size_t
+VirtualComponent::elementSize(SnapshotItem *item)
+{
+    // The format flags coincide with the element size in bytes
+    size_t result = item->flags & 0x0F;
+    
+    if (result == 0)
+        result = (item->size == 2 || item->size == 4 || item->size == 8) ? item->size : 1;
+    
+    return result;
+}
+
+void
+VirtualComponent::setForeignByteOrder(bool value)
+{
+    foreignByteOrder = value;
+    
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            subComponents[i]->setForeignByteOrder(value);
+}
+
+void
+VirtualComponent::writeDirtyPages(uint8_t **buffer, SnapshotItem *item)
+{
+    uint8_t *data = (uint8_t *)item->data;
+    size_t pages = numPages(item);
+
+    for (size_t i = 0; i < pages; i++) {
+        
+        if (!item->dirty[i])
+            continue;
+        
+        size_t offset = i * item->pageSize;
+        memcpy(*buffer + offset, data + offset, std::min(item->pageSize, item->size - offset));
+        item->dirty[i] = 0;
+    }
+    *buffer += item->size;
+}
+
+void
+VirtualComponent::setIncrementalSave(bool value)
+{
+    incrementalSave = value;
+    
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            subComponents[i]->setIncrementalSave(value);
+}
+
+void
+VirtualComponent::markAllPagesDirty()
+{
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            subComponents[i]->markAllPagesDirty();
+    
+    for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++)
+        if (snapshotItems[i].dirty && !(snapshotItems[i].flags & BLOB_REFERENCE))
+            memset(snapshotItems[i].dirty, 1, numPages(&snapshotItems[i]));
+}
+
+size_t
+VirtualComponent::dirtySize()
+{
+    size_t result = 0;
+    
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            result += subComponents[i]->dirtySize();
+    
+    for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
+        
+        SnapshotItem *item = &snapshotItems[i];
+        if (item->flags & BLOB_REFERENCE)
+            continue;
+        
+        for (size_t j = 0; item->dirty && j < numPages(item); j++)
+            if (item->dirty[j])
+                result += std::min(item->pageSize, item->size - j * item->pageSize);
+    }
+    
+    return result;
+}
+
+uint64_t
+VirtualComponent::blobReference(SnapshotItem *item)
+{
+    assert(item->flags & BLOB_REFERENCE);
+    
+    if (*item->dirty && BlobStore::add((uint8_t *)item->data, item->size, &item->hash))
+        *item->dirty = 0;
+    
+    return item->hash;
+}
+
+void
+VirtualComponent::loadBlobReference(uint8_t **buffer, SnapshotItem *item)
+{
+    uint64_t hash = read64(buffer);
+    
+    // Nothing to do if the item already contains the referenced image
+    if (!*item->dirty && item->hash == hash)
+        return;
+    
+    if (BlobStore::get(hash, item->size, (uint8_t *)item->data)) {
+        item->hash = hash;
+        *item->dirty = 0;
+    } else {
+        warn("Snapshot refers to an unknown memory image (%016llX)\n", (unsigned long long)hash);
+    }
+}
+
+bool
+VirtualComponent::collectBlobs(BlobList *list)
+{
+    bool result = true;
+    
+    if (subComponents != NULL)
+        for (unsigned i = 0; subComponents[i] != NULL; i++)
+            result &= subComponents[i]->collectBlobs(list);
+    
+    for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
+        SnapshotItem *item = &snapshotItems[i];
+        if (item->flags & BLOB_REFERENCE) {
+            BlobStore::addReference(list, blobReference(item), item->size);
+            result &= !*item->dirty;
+        }
+    }
+    
+    return result;
+}
+
+unsigned
+VirtualComponent::diffState(VirtualComponent *other, const char *path)
+{
+    assert(other != NULL);
+    
+    char name[256];
+    unsigned result = 0;
+    
+    if (path)
+        snprintf(name, sizeof(name), "%s.%s", path, getDescription());
+    else
+        snprintf(name, sizeof(name), "%s", getDescription());
+    
+    // Compare sub components
+    for (unsigned i = 0; subComponents != NULL && subComponents[i] != NULL; i++) {
+        assert(other->subComponents[i] != NULL);
+        result += subComponents[i]->diffState(other->subComponents[i], name);
+    }
+    
+    // Compare snapshot items
+    for (unsigned i = 0; snapshotItems != NULL && snapshotItems[i].data != NULL; i++) {
+        
+        SnapshotItem *item = &snapshotItems[i];
+        SnapshotItem *otherItem = &other->snapshotItems[i];
+        assert(item->size == otherItem->size);
+        
+        if (memcmp(item->data, otherItem->data, item->size) != 0) {
+            reportItemDiff(name, item, otherItem);
+            result++;
+        }
+    }
+    
+    if (result)
+        return result;
+    
+    // Compare the state that is not covered by snapshot items
+    size_t size = stateSize(), otherSize = other->stateSize();
+    
+    if (size != otherSize) {
+        msg("%s: State size differs (%zu / %zu bytes)\n", name, size, otherSize);
+        return 1;
+    }
+    
+    uint8_t *state = (uint8_t *)malloc(size);
+    uint8_t *otherState = (uint8_t *)malloc(size);
+    uint8_t *ptr;
+    
+    if (state && otherState) {
+        
+        ptr = state;
+        saveToBuffer(&ptr);
+        ptr = otherState;
+        other->saveToBuffer(&ptr);
+        
+        for (size_t i = 0; i < size; i++) {
+            if (state[i] != otherState[i]) {
+                msg("%s: Unregistered state differs at offset %zu ($%02X / $%02X)\n",
+                    name, i, state[i], otherState[i]);
+                result = 1;
+                break;
             }
         }
     }
     
-    if (*buffer - old != VirtualComponent::stateSize()) {
-        panic("saveToBuffer: Snapshot size is wrong.");
-        assert(false);
+    free(state);
+    free(otherState);
+    return result;
+}
+
+void
+VirtualComponent::reportItemDiff(const char *path, SnapshotItem *item, SnapshotItem *other)
+{
+    size_t width = elementSize(item);
+    size_t count = item->size / width;
+    size_t first = count, differing = 0;
+    
+    for (size_t i = 0; i < count; i++) {
+        if (memcmp((uint8_t *)item->data + i * width, (uint8_t *)other->data + i * width, width)) {
+            if (first == count) first = i;
+            differing++;
+        }
+    }
+    assert(first < count);
+    
+    // Read the first differing element
+    uint64_t value = 0, otherValue = 0;
+    switch (width) {
+        case 1: value = ((uint8_t *)item->data)[first];
+                otherValue = ((uint8_t *)other->data)[first]; break;
+        case 2: value = ((uint16_t *)item->data)[first];
+                otherValue = ((uint16_t *)other->data)[first]; break;
+        case 4: value = ((uint32_t *)item->data)[first];
+                otherValue = ((uint32_t *)other->data)[first]; break;
+        case 8: value = ((uint64_t *)item->data)[first];
+                otherValue = ((uint64_t *)other->data)[first]; break;
+        default: assert(false);
+    }
+    
+    if (count == 1) {
+        msg("%s.%s: $%llX / $%llX\n", path, item->name,
+            (unsigned long long)value, (unsigned long long)otherValue);
+    } else {
+        msg("%s.%s: %zu of %zu elements differ, first at [%zu]: $%llX / $%llX\n",
+            path, item->name, differing, count, first,
+            (unsigned long long)value, (unsigned long long)otherValue);
     }
 }
@@ -22,6 +22,7 @@
 #define _VIRTUAL_COMPONENT_INC
 
 #include "VC64Object.h"
+#include "BlobStore.h"
 
 // Forward declarations
 class C64;
@@ -161,6 +162,7 @@ protected:
     enum {
         KEEP_ON_RESET      = 0x00, //! Don't touch item in VirtualComponent::reset()
         CLEAR_ON_RESET     = 0x10, //! Set item to 0 in VirtualComponent::reset()
+        BLOB_REFERENCE     = 0x20, //! Save a reference into the BlobStore instead of the data
         BYTE_FORMAT        = 0x01, //! Data chunk consists of 8 bit values.
         WORD_FORMAT        = 0x02, //! Data chunk consists of 16 bit values
         DOUBLE_WORD_FORMAT = 0x04, //! Data chunk consists of 32 bit values
@@ -168,12 +170,22 @@ protected:
     };
 
     /*! @brief Fingerprint of a snapshot item
+     *  @details The name is used to report differences between two states (see diffState).
+     *           If a dirty map is specified, the item is divided into pages of pageSize bytes
+     *           (the last page may be shorter). dirty[i] is nonzero iff page i has been modified
+     *           since the last incremental save. Items with a dirty map must be in byte format.
+     *           Items flagged with BLOB_REFERENCE need a dirty map with a single entry which has
+     *           to be set whenever the data changes. hash caches the content hash of the data.
      */
     typedef struct {
         
+        const char *name;
         void *data;
         size_t size;
         uint8_t flags;
+        uint8_t *dirty;
+        size_t pageSize;
+        uint64_t hash;
         
     } SnapshotItem;
     
@@ -182,10 +194,39 @@ protected:
      */
     SnapshotItem *snapshotItems;
     
+    /*! @brief    A chunk of the state layout
+     *  @details  A chunk either covers a sequence of snapshot items that are adjacent in memory
+     *            and can be copied as a whole (item is NULL), or a single item with a dirty map
+     *            or a blob reference which needs special treatment.
+     */
+    typedef struct {
+        
+        uint8_t *data;
+        size_t size;
+        SnapshotItem *item;
+        
+    } StateChunk;
+    
+    /*! @brief    State layout of this component
+     *  @details  The layout is precomputed in registerSnapshotItems(). The end of the array is
+     *            marked by a NULL pointer in the data field.
+     */
+    StateChunk *stateLayout;
+    
     /*! @brief    Snapshot size on disk (in bytes)
      */
     unsigned snapshotSize;
     
+    /*! @brief    Indicates whether saveToBuffer skips clean pages
+     *  @see      setIncrementalSave
+     */
+    bool incrementalSave;
+    
+    /*! @brief    Indicates whether loadFromBuffer reads a state of the opposite byte order
+     *  @see      setForeignByteOrder
+     */
+    bool foreignByteOrder;
+    
     /*! @brief    Registers all snapshot items for this component
      *  @abstract Snaphshot items are usually registered in the constructor of a virtual component.
      *  @param    items Pointer to the first element of a SnapshotItem* array. The end of the array
@@ -194,6 +235,38 @@ protected:
      */
     void registerSnapshotItems(SnapshotItem *items, unsigned length);
     
+    //! @brief    Merges the snapshot items into as few state chunks as possible
+    void computeStateLayout(unsigned numItems);
+    
+    /*! @brief    Loads all snapshot items from a state of the opposite byte order
+     *  @details  This is the slow path of loadFromBuffer which converts each item separately.
+     */
+    void loadForeignItems(uint8_t **buffer);
+    
+    //! @brief    Returns the size of a single element of a snapshot item in bytes
+    static size_t elementSize(SnapshotItem *item);
+    
+    //! @brief    Reports a snapshot item that differs from the same item of another component
+    void reportItemDiff(const char *path, SnapshotItem *item, SnapshotItem *other);
+    
+    //! @brief    Returns the number of pages of a dirty-tracked snapshot item
+    static size_t numPages(SnapshotItem *item) {
+        return (item->size + item->pageSize - 1) / item->pageSize; }
+    
+    /*! @brief    Writes all modified pages of a snapshot item and marks them clean
+     *  @details  The buffer pointer is advanced by the full item size.
+     */
+    void writeDirtyPages(uint8_t **buffer, SnapshotItem *item);
+    
+    /*! @brief    Returns the blob store reference of a snapshot item flagged with BLOB_REFERENCE
+     *  @details  If the data has been modified, it is hashed and added to the blob store. If the
+     *            blob store rejects the data, the item stays dirty (see collectBlobs()).
+     */
+    uint64_t blobReference(SnapshotItem *item);
+    
+    //! @brief    Reads a blob store reference and copies the referenced image into a snapshot item
+    void loadBlobReference(uint8_t **buffer, SnapshotItem *item);
+    
     /*! @brief    Sub components of this component
      *  @details  Initial value is NULL, indicating that no sub components are present
      */
@@ -219,19 +292,64 @@ public:
     virtual size_t stateSize();
     
     /*! @brief    Load internal state from memory buffer
-     *  @note     Snapshot items of size 2, 4, or 8 are converted automatically to big endian format.
-     *            Take this into account when loading byte arrays of these sizes.
+     *  @note     Snapshot items are stored in the byte order of the host which has written the
+     *            state. If setForeignByteOrder() has been called, items of size 2, 4, or 8 and
+     *            blocks in word, double word, or quad word format are converted while loading.
      *  @param    buffer Pointer to next byte to read
      */
     virtual void loadFromBuffer(uint8_t **buffer);
     
     /*! @brief    Save internal state to memory buffer
-     *  @note     Snapshot items of size 2, 4, or 8 are converted automatically to big endian format.
-     *            Take this into account when saving byte arrays of these sizes.
+     *  @note     Snapshot items are copied as they are, i.e., in the byte order of the host.
+     *            Values written with write16() etc. are always stored in big endian format.
      *  @param    buffer Pointer to next byte to read
      */
     virtual void saveToBuffer(uint8_t **buffer);
     
+    /*! @brief    Tells this component and all sub components about the byte order of the state
+     *            that is going to be loaded
+     *  @param    value true iff the state has been written by a host of the opposite byte order
+     */
+    void setForeignByteOrder(bool value);
+    
+    /*! @brief    Enables or disables incremental saving for this component and all sub components
+     *  @details  In incremental mode, saveToBuffer only writes those pages of snapshot items with a
+     *            dirty map that have been modified since the last incremental save and marks them
+     *            clean afterwards. All other pages are skipped, i.e., the buffer is expected to still
+     *            contain the data written by the previous incremental save. Hence, only a single
+     *            buffer should ever be updated incrementally. A full save leaves the dirty maps alone.
+     */
+    void setIncrementalSave(bool value);
+    
+    /*! @brief    Marks all pages of this component and all sub components as modified
+     *  @details  Needs to be called whenever dirty-tracked memory is changed without going through
+     *            the regular write functions.
+     */
+    void markAllPagesDirty();
+    
+    /*! @brief    Returns the number of bytes an incremental save would write
+     *  @details  Only the pages of snapshot items with a dirty map are taken into account.
+     */
+    size_t dirtySize();
+    
+    /*! @brief    Collects the blob store references of this component and all sub components
+     *  @details  The referenced blobs need to be embedded into snapshots that leave the process.
+     *  @result   false, if an image could not be added to the blob store (hash collision). The
+     *            state must not be saved in that case.
+     */
+    virtual bool collectBlobs(BlobList *list);
+    
+    /*! @brief    Compares the internal state with the state of another instance of this component
+     *  @details  All sub components are compared recursively. Each snapshot item that differs is
+     *            reported by name, prefixed with the path of the component. If the saved states
+     *            of a component differ although all items match, the difference is located in
+     *            state written by an overridden saveToBuffer() function.
+     *  @param    other Component of the same type, e.g., of a second C64 instance
+     *  @param    path  Path of the parent component or NULL
+     *  @result   Number of reported differences
+     */
+    unsigned diffState(VirtualComponent *other, const char *path = NULL);
+    
     
     //
     //! @functiongroup Saving single snapshot items
@@ -404,24 +404,27 @@ uint8_t
 localTimeSec()
 {
 	time_t t = time(NULL);
-	struct tm *loctime = localtime(&t);
-	return (uint8_t)loctime->tm_sec;
+	struct tm loctime;
+	localtime_r(&t, &loctime);
+	return (uint8_t)loctime.tm_sec;
 }
 
 uint8_t 
 localTimeMinute()
 {
 	time_t t = time(NULL);
-	struct tm *loctime = localtime(&t);
-	return (uint8_t)loctime->tm_min;
+	struct tm loctime;
+	localtime_r(&t, &loctime);
+	return (uint8_t)loctime.tm_min;
 }
 
 uint8_t 
 localTimeHour()
 {
 	time_t t = time(NULL);
-	struct tm *loctime = localtime(&t);
-	return (uint8_t)loctime->tm_hour;
+	struct tm loctime;
+	localtime_r(&t, &loctime);
+	return (uint8_t)loctime.tm_hour;
 }
 
 	
@@ -433,10 +436,39 @@ sleepMicrosec(unsigned usec)
 	}
 }
 
+uint64_t
+kernelTime()
+{
+#ifdef __APPLE__
+    return mach_absolute_time();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void
+kernelTimebase(uint32_t *numer, uint32_t *denom)
+{
+    assert(numer != NULL);
+    assert(denom != NULL);
+    
+#ifdef __APPLE__
+    mach_timebase_info_data_t timebase;
+    mach_timebase_info(&timebase);
+    *numer = timebase.numer;
+    *denom = timebase.denom;
+#else
+    *numer = 1;
+    *denom = 1;
+#endif
+}
+
 int64_t
 sleepUntil(uint64_t kernelTargetTime, uint64_t kernelEarlyWakeup)
 {
-    uint64_t now = mach_absolute_time();
+    uint64_t now = kernelTime();
     int64_t jitter;
     
     if (now > kernelTargetTime)
@@ -444,12 +476,20 @@ sleepUntil(uint64_t kernelTargetTime, uint64_t kernelEarlyWakeup)
     
     // Sleep
     // printf("Sleeping for %d\n", kernelTargetTime - now);
+#ifdef __APPLE__
     mach_wait_until(kernelTargetTime - kernelEarlyWakeup);
+#else
+    uint64_t wakeup = kernelTargetTime - kernelEarlyWakeup;
+    struct timespec ts;
+    ts.tv_sec = (time_t)(wakeup / 1000000000);
+    ts.tv_nsec = (long)(wakeup % 1000000000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR);
+#endif
     
     // Count some sheep to increase precision
     unsigned sheep = 0;
     do {
-        jitter = mach_absolute_time() - kernelTargetTime;
+        jitter = kernelTime() - kernelTargetTime;
         sheep++;
     } while (jitter < 0);
     
@@ -32,8 +32,10 @@
 #include <sys/stat.h>
 #include <sys/param.h>
 #include <time.h>
+#ifdef __APPLE__
 #include <mach/mach.h>
 #include <mach/mach_time.h>
+#endif
 #include <unistd.h>
 #include <pthread.h>
 #include <errno.h>
@@ -206,6 +208,18 @@ uint8_t localTimeHour();
 //! @brief    Put the current thread to sleep for a certain amount of time.
 void sleepMicrosec(unsigned usec);
 
+/*! @brief    Reads the monotonic kernel timer
+ *  @details  The unit is platform dependent. On Mach kernels, it is defined by the timebase
+ *            info record. On all other systems, the timer is based on CLOCK_MONOTONIC and
+ *            kernel time equals nanoseconds.
+ */
+uint64_t kernelTime();
+
+/*! @brief    Queries the resolution of the kernel timer
+ *  @details  One kernel time unit equals numer / denom nanoseconds.
+ */
+void kernelTimebase(uint32_t *numer, uint32_t *denom);
+
 /*! @brief    Sleeps until kernel timer reaches kernelTargetTime
  *  @param    kernelEarlyWakeup To increase timing precision, the function wakes up the thread earlier
  *            by this amount and waits actively in a delay loop until the deadline is reached.
@@ -137,7 +137,8 @@ struct ContainerWrapper;
 
 - (void) dump;
 
-- (void *) screenBuffer;
+- (const void *) acquireScreenBuffer;
+- (void) releaseScreenBuffer;
 
 - (NSColor *) color:(NSInteger)nr;
 - (NSInteger) colorScheme;
@@ -656,10 +657,7 @@ struct ContainerWrapper;
 
 // Cheatbox
 - (NSInteger) historicSnapshots;
-- (NSInteger) historicSnapshotHeaderSize:(NSInteger)nr;
-- (uint8_t *) historicSnapshotHeader:(NSInteger)nr;
-- (NSInteger) historicSnapshotDataSize:(NSInteger)nr;
-- (uint8_t *) historicSnapshotData:(NSInteger)nr;
+- (NSData *) historicSnapshotFileData:(NSInteger)nr;
 
 - (time_t)historicSnapshotTimestamp:(NSInteger)nr;
 - (unsigned char *)historicSnapshotImageData:(NSInteger)nr;
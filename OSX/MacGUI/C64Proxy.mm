@@ -23,7 +23,7 @@
 struct C64Wrapper { C64 *c64; };
 struct CpuWrapper { CPU *cpu; };
 struct MemoryWrapper { Memory *mem; };
-struct VicWrapper { VIC *vic; };
+struct VicWrapper { VIC *vic; FrameConsumer consumer; };
 struct CiaWrapper { CIA *cia; };
 struct KeyboardWrapper { Keyboard *keyboard; };
 struct JoystickWrapper { Joystick *joystick; };
@@ -159,13 +159,19 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
     if (self = [super init]) {
         wrapper = new VicWrapper();
         wrapper->vic = vic;
+        TripleBuffer::initConsumer(&wrapper->consumer);
     }
     return self;
 }
 
 - (void) dump { wrapper->vic->dumpState(); }
 
-- (void *) screenBuffer { return wrapper->vic->screenBuffer(); }
+- (const void *) acquireScreenBuffer
+{
+    return wrapper->vic->getFrames()->acquire(&wrapper->consumer)->rgba[0];
+}
+
+- (void) releaseScreenBuffer { wrapper->vic->getFrames()->release(&wrapper->consumer); }
 
 - (NSColor *) color:(NSInteger)nr
 {
@@ -830,21 +836,20 @@ struct CRTContainerWrapper { CRTContainer *crtcontainer; };
 // Cheatbox
 - (NSInteger) historicSnapshots { return wrapper->c64->numHistoricSnapshots(); }
 
-- (NSInteger) historicSnapshotHeaderSize:(NSInteger)nr
-    { Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr); return s ? s->getHeaderSize() : 0; }
-
-- (uint8_t *) historicSnapshotHeader:(NSInteger)nr
-    { Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr); return s ? s->getHeader() : NULL; }
-
-
-- (NSInteger) historicSnapshotDataSize:(NSInteger)nr
-    { Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr); return s ? s->getDataSize() : 0; }
+- (NSData *) historicSnapshotFileData:(NSInteger)nr
+{
+    Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr);
+    if (s == NULL)
+        return nil;
+    
+    // Header, thumbnail, and state in the layout readFromBuffer() expects
+    NSMutableData *data = [NSMutableData dataWithLength:s->sizeOnDisk()];
+    s->writeToBuffer((uint8_t *)[data mutableBytes]);
+    return data;
+}
 
 - (time_t)historicSnapshotTimestamp:(NSInteger)nr { Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr); return s ? s->getTimestamp() : 0; }
 
-- (uint8_t *) historicSnapshotData:(NSInteger)nr
-    { Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr); return s ? s->getData() : NULL; }
-
 - (unsigned char *)historicSnapshotImageData:(NSInteger)nr
     { Snapshot *s = wrapper->c64->getHistoricSnapshot((int)nr); return s ? s->getImageData() : NULL; }
 - (NSInteger)historicSnapshotImageWidth:(NSInteger)nr
@@ -128,15 +128,13 @@
 		NSLog(@"imageBrowser:writeItemsAtIndexes:NSNotFound (%lu)", (unsigned long)index);
 		return 0;
 	}
+    NSData *fileData = [c64 historicSnapshotFileData:index];
+    if (fileData == nil) {
+        NSLog(@"imageBrowser:writeItemsAtIndexes:Snapshot %lu not found", (unsigned long)index);
+        return 0;
+    }
 	[pboard declareTypes:[NSArray arrayWithObject:NSFileContentsPboardType] owner:self];
     
-    NSInteger headerSize = [c64 historicSnapshotHeaderSize:index];
-    uint8_t *header = [c64 historicSnapshotHeader:index];
-    NSInteger dataSize = [c64 historicSnapshotDataSize:index];
-    uint8_t *data = [c64 historicSnapshotData:index];
-    
-    NSMutableData *fileData = [NSMutableData dataWithBytes:header length:headerSize];
-    [fileData appendBytes:data length:dataSize];
     NSFileWrapper *fileWrapper = [[NSFileWrapper alloc] initRegularFileWithContents:fileData];
 	[fileWrapper setPreferredFilename:@"Snapshot.VC64"];
 	[pboard writeFileWrapper:fileWrapper];
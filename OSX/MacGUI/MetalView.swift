@@ -241,8 +241,10 @@ public class MetalView: MTKView {
             return
         }
     
-        let buf = c64proxy.vic.screenBuffer()
+        // Pin the latest frame, so the emulator won't draw into it while it is copied
+        let buf = c64proxy.vic.acquireScreenBuffer()
         precondition(buf != nil)
+        defer { c64proxy.vic.releaseScreenBuffer() }
         
         let pixelSize = 4
         let width = Int(NTSC_PIXELS)
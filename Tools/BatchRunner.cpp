@@ -0,0 +1,520 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* vc64batch
+ *
+ * Runs a regression suite of media files on multiple independent C64 instances.
+ *
+ * Usage: vc64batch [-j threads] [-b bootframes] [-o directory] [-v] -r rom [-r rom ...] manifest
+ *
+ * Each non-empty line of the manifest describes a single job:
+ *
+ *     <media file> <frames> [<expected checksum>]
+ *
+ * Lines starting with '#' are ignored. Relative paths are resolved relative to the
+ * directory of the manifest file. Supported media types are PRG, P00, T64, D64, G64,
+ * NIB, TAP, and CRT. Input logs (see class InputLog) are supported as well. They restore
+ * the recorded starting point and replay the recorded input, which makes recorded
+ * sessions usable as benchmarks. After the emulator has run for the specified number of
+ * frames, a checksum (64 bit FNV-1a) is computed over RAM, color RAM, and the last
+ * completed frame. If an expected checksum is given, it is compared against the computed one.
+ * The TOD clocks start at 00:00:00 rather than at the time of the host, so results don't
+ * depend on the time of day.
+ * Option -o saves a snapshot of each job's final state into the specified directory,
+ * named <job number>-<media file name>.v64. Snapshots of two emulator builds can be
+ * compared with vc64diff to locate the first component that diverges.
+ *
+ * Jobs are distributed over a pool of worker threads. Each worker owns a job queue
+ * and steals work from the other queues once its own queue has run dry.
+ */
+
+#include "C64.h"
+
+//! @brief    Maximum number of worker threads
+#define MAX_WORKERS 256
+
+//! @brief    Number of frames to wait for the Kernal to boot up
+#define DEFAULT_BOOT_FRAMES 150
+
+typedef enum {
+    JOB_PENDING,
+    JOB_PASS,
+    JOB_FAIL,
+    JOB_DONE,
+    JOB_ERROR
+} JobState;
+
+//! @brief    A single regression job
+typedef struct {
+
+    //! @brief    Media file path
+    char *path;
+
+    //! @brief    Number of frames to run after the media has been loaded
+    uint64_t frames;
+
+    //! @brief    Expected checksum (only valid if hasChecksum is true)
+    uint64_t expected;
+    bool hasChecksum;
+
+    //! @brief    Results
+    JobState state;
+    uint64_t checksum;
+    double fps;
+    char error[64];
+
+} Job;
+
+//! @brief    Job queue of a single worker thread
+typedef struct {
+
+    pthread_mutex_t lock;
+
+    //! @brief    Indices into the job array (front is read by owner, back is stolen by others)
+    unsigned *jobs;
+    unsigned front;
+    unsigned back;
+
+} WorkQueue;
+
+static Job *jobs;
+static unsigned numJobs;
+static WorkQueue queues[MAX_WORKERS];
+static unsigned numWorkers;
+static const char *roms[8];
+static unsigned numRoms;
+static unsigned bootFrames = DEFAULT_BOOT_FRAMES;
+static const char *snapshotDirectory = NULL;
+
+
+//
+// Evaluating emulator state
+//
+
+static uint64_t
+fnv1a(uint64_t hash, const void *data, size_t length)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+static uint64_t
+checksum(C64 *c64)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    TripleBuffer *frames = c64->vic.getFrames();
+    FrameConsumer consumer;
+
+    hash = fnv1a(hash, c64->mem.ram, sizeof(c64->mem.ram));
+    for (unsigned i = 0; i < sizeof(c64->mem.colorRam); i++) {
+        uint8_t value = c64->mem.colorRam[i] & 0x0F; // Upper nibble is floating
+        hash = fnv1a(hash, &value, 1);
+    }
+    TripleBuffer::initConsumer(&consumer);
+    hash = fnv1a(hash, frames->acquire(&consumer)->rgba[0], PAL_RASTERLINES * NTSC_PIXELS * 4);
+    frames->release(&consumer);
+    return hash;
+}
+
+/*! @brief    Simulates typing text
+ *  @details  The text is written directly into the Kernal keyboard buffer. At most 10
+ *            characters fit in.
+ */
+static void
+typeText(C64 *c64, const char *text)
+{
+    unsigned len = (unsigned)strlen(text);
+    assert(len <= 10);
+
+    for (unsigned i = 0; i < len; i++)
+        c64->mem.pokeRam(0x0277 + i, (uint8_t)text[i]);
+    c64->mem.pokeRam(0x00C6, (uint8_t)len);
+}
+
+
+//
+// Running jobs
+//
+
+static double
+seconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1E9;
+}
+
+//! @brief    Marks a job as failed
+static void
+fail(Job *job, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    vsnprintf(job->error, sizeof(job->error), format, ap);
+    va_end(ap);
+    job->state = JOB_ERROR;
+}
+
+//! @brief    Marks a job as failed if the emulator has stopped prematurely
+static bool
+ran(Job *job, C64 *c64, bool success)
+{
+    if (!success)
+        fail(job, "CPU halted at frame %llu", (unsigned long long)c64->getFrame());
+    return success;
+}
+
+static void
+runJob(Job *job)
+{
+    C64 *c64 = new C64();
+    Archive *archive = NULL;
+    TAPContainer *tape = NULL;
+    CRTContainer *cartridge = NULL;
+    InputLog *movie = NULL;
+    uint64_t startFrame;
+    double start, elapsed;
+
+    // Nobody is going to rewind a batch job
+    c64->setTimeTravelInterval(0);
+
+    // Runs must not depend on the time of day
+    c64->setHostClock(false);
+    c64->reset();
+
+    for (unsigned i = 0; i < numRoms; i++)
+        c64->loadRom(roms[i]);
+
+    if (!c64->isRunnable()) {
+        fail(job, "ROM images missing");
+        goto cleanup;
+    }
+
+    // Open media file
+    if (TAPContainer::isTAPFile(job->path)) {
+        tape = TAPContainer::makeTAPContainerWithFile(job->path);
+    } else if (CRTContainer::isValidCRTFile(job->path)) {
+        cartridge = CRTContainer::makeCRTContainerWithFile(job->path);
+    } else if (InputLog::isInputLogFile(job->path)) {
+        movie = InputLog::makeInputLogWithFile(job->path);
+    } else {
+        archive = Archive::makeArchiveWithFile(job->path);
+    }
+
+    if (!tape && !cartridge && !archive && !movie) {
+        fail(job, "Unsupported or unreadable media file");
+        goto cleanup;
+    }
+
+    start = seconds();
+    startFrame = c64->getFrame();
+
+    if (movie) {
+
+        if (!c64->startReplay(movie)) {
+            fail(job, "Replay rejected");
+            goto cleanup;
+        }
+
+    } else if (cartridge) {
+
+        if (!c64->attachCartridgeAndReset(cartridge)) {
+            fail(job, "Unsupported cartridge type");
+            goto cleanup;
+        }
+
+    } else {
+
+        // Wait until the Kernal is ready to accept input
+        if (!ran(job, c64, c64->runFrames(bootFrames)))
+            goto cleanup;
+
+        if (tape) {
+            c64->insertTape(tape);
+            typeText(c64, "LOAD\r");
+            c64->datasette.pressPlay();
+        } else {
+            switch (archive->type()) {
+                case D64_CONTAINER:
+                case G64_CONTAINER:
+                case NIB_CONTAINER:
+                    c64->insertDisk(archive);
+                    break;
+                default:
+                    break;
+            }
+            c64->flushArchive(archive, 0);
+            typeText(c64, "RUN\r");
+        }
+    }
+
+    // Run the workload
+    if (!ran(job, c64, c64->runFrames(job->frames)))
+        goto cleanup;
+    elapsed = seconds() - start;
+
+    job->checksum = checksum(c64);
+    job->fps = elapsed > 0 ? (c64->getFrame() - startFrame) / elapsed : 0;
+
+    if (snapshotDirectory) {
+
+        const char *name = strrchr(job->path, '/');
+        char path[1024];
+        snprintf(path, sizeof(path), "%s/%u-%s.v64",
+                 snapshotDirectory, (unsigned)(job - jobs), name ? name + 1 : job->path);
+
+        Snapshot *snapshot = Snapshot::makeSnapshotWithC64(c64);
+        bool success = snapshot->writeToFile(path);
+        delete snapshot;
+
+        if (!success) {
+            fail(job, "Cannot write snapshot");
+            goto cleanup;
+        }
+    }
+
+    if (job->hasChecksum)
+        job->state = (job->checksum == job->expected) ? JOB_PASS : JOB_FAIL;
+    else
+        job->state = JOB_DONE;
+
+cleanup:
+
+    delete c64;
+    delete archive;
+    delete tape;
+    delete cartridge;
+    delete movie;
+}
+
+static bool
+popJob(unsigned worker, unsigned *result)
+{
+    // Take a job from the own queue first
+    WorkQueue *q = &queues[worker];
+    pthread_mutex_lock(&q->lock);
+    bool found = q->front < q->back;
+    if (found)
+        *result = q->jobs[q->front++];
+    pthread_mutex_unlock(&q->lock);
+
+    if (found)
+        return true;
+
+    // Steal from another queue
+    for (unsigned i = 1; i < numWorkers; i++) {
+
+        q = &queues[(worker + i) % numWorkers];
+        pthread_mutex_lock(&q->lock);
+        found = q->front < q->back;
+        if (found)
+            *result = q->jobs[--q->back];
+        pthread_mutex_unlock(&q->lock);
+
+        if (found)
+            return true;
+    }
+    return false;
+}
+
+static void *
+workerThread(void *arg)
+{
+    unsigned worker = (unsigned)(uintptr_t)arg;
+    unsigned nr;
+
+    while (popJob(worker, &nr))
+        runJob(&jobs[nr]);
+
+    return NULL;
+}
+
+
+//
+// Parsing the manifest
+//
+
+static bool
+parseManifest(const char *filename)
+{
+    FILE *file;
+    char line[1024], path[1024], directory[1024];
+    unsigned capacity = 64;
+
+    if ((file = fopen(filename, "r")) == NULL) {
+        fprintf(stderr, "Cannot open manifest %s\n", filename);
+        return false;
+    }
+
+    // Determine the base directory for relative paths
+    strncpy(directory, filename, sizeof(directory) - 1);
+    directory[sizeof(directory) - 1] = 0;
+    char *slash = strrchr(directory, '/');
+    if (slash) slash[1] = 0; else directory[0] = 0;
+
+    jobs = (Job *)calloc(capacity, sizeof(Job));
+
+    for (unsigned lineNr = 1; fgets(line, sizeof(line), file); lineNr++) {
+
+        char media[768];
+        unsigned long long frames, expected;
+
+        char *p = line;
+        while (isspace(*p)) p++;
+        if (*p == 0 || *p == '#')
+            continue;
+
+        int items = sscanf(p, "%767s %llu %llx", media, &frames, &expected);
+        if (items < 2) {
+            fprintf(stderr, "%s:%d: Syntax error\n", filename, lineNr);
+            fclose(file);
+            return false;
+        }
+
+        if (numJobs == capacity) {
+            capacity *= 2;
+            jobs = (Job *)realloc(jobs, capacity * sizeof(Job));
+            memset(jobs + numJobs, 0, (capacity - numJobs) * sizeof(Job));
+        }
+
+        if (media[0] == '/')
+            snprintf(path, sizeof(path), "%s", media);
+        else
+            snprintf(path, sizeof(path), "%s%s", directory, media);
+
+        Job *job = &jobs[numJobs++];
+        job->path = strdup(path);
+        job->frames = frames;
+        job->expected = expected;
+        job->hasChecksum = (items == 3);
+        job->state = JOB_PENDING;
+    }
+
+    fclose(file);
+    return true;
+}
+
+
+//
+// Main entry point
+//
+
+static void
+usage()
+{
+    fprintf(stderr, "Usage: vc64batch [-j threads] [-b bootframes] [-o directory] [-v] "
+            "-r rom [-r rom ...] manifest\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    bool verbose = false;
+    int opt;
+
+    numWorkers = cpus > 0 ? (unsigned)cpus : 1;
+
+    while ((opt = getopt(argc, argv, "j:b:o:r:v")) != -1) {
+        switch (opt) {
+            case 'j': numWorkers = (unsigned)atoi(optarg); break;
+            case 'b': bootFrames = (unsigned)atoi(optarg); break;
+            case 'o': snapshotDirectory = optarg; break;
+            case 'r':
+                if (numRoms < sizeof(roms) / sizeof(roms[0]))
+                    roms[numRoms++] = optarg;
+                break;
+            case 'v': verbose = true; break;
+            default: usage(); return 2;
+        }
+    }
+
+    if (optind != argc - 1) {
+        usage();
+        return 2;
+    }
+
+    if (numWorkers < 1) numWorkers = 1;
+    if (numWorkers > MAX_WORKERS) numWorkers = MAX_WORKERS;
+
+    // Keep the emulator instances quiet
+    if (!verbose) {
+        VC64Object::setDefaultDebugLevel(0);
+        VC64Object::setLogfile(fopen("/dev/null", "w"));
+    }
+
+    if (!parseManifest(argv[optind]))
+        return 2;
+
+    if (numWorkers > numJobs) numWorkers = numJobs ? numJobs : 1;
+
+    // Distribute jobs round robin
+    for (unsigned i = 0; i < numWorkers; i++) {
+        pthread_mutex_init(&queues[i].lock, NULL);
+        queues[i].jobs = new unsigned[numJobs / numWorkers + 1];
+        queues[i].front = queues[i].back = 0;
+    }
+    for (unsigned i = 0; i < numJobs; i++) {
+        WorkQueue *q = &queues[i % numWorkers];
+        q->jobs[q->back++] = i;
+    }
+
+    // Run
+    pthread_t threads[MAX_WORKERS];
+    double start = seconds();
+
+    for (unsigned i = 0; i < numWorkers; i++)
+        pthread_create(&threads[i], NULL, workerThread, (void *)(uintptr_t)i);
+    for (unsigned i = 0; i < numWorkers; i++)
+        pthread_join(threads[i], NULL);
+
+    double elapsed = seconds() - start;
+
+    // Report
+    unsigned passed = 0, failed = 0, errors = 0;
+
+    for (unsigned i = 0; i < numJobs; i++) {
+
+        Job *job = &jobs[i];
+
+        switch (job->state) {
+
+            case JOB_ERROR:
+                printf("ERROR %s: %s\n", job->path, job->error);
+                errors++;
+                break;
+
+            default:
+                printf("%-5s %s %llu frames %.1f fps checksum %016llx\n",
+                       job->state == JOB_PASS ? "PASS" : job->state == JOB_FAIL ? "FAIL" : "DONE",
+                       job->path, (unsigned long long)job->frames, job->fps,
+                       (unsigned long long)job->checksum);
+                if (job->state == JOB_PASS) passed++;
+                if (job->state == JOB_FAIL) failed++;
+        }
+    }
+
+    printf("\n%u jobs, %u passed, %u failed, %u errors (%u threads, %.2f s)\n",
+           numJobs, passed, failed, errors, numWorkers, elapsed);
+
+    return (failed || errors) ? 1 : 0;
+}
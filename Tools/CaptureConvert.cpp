@@ -0,0 +1,240 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* vc64capture
+ *
+ * Converts a capture file (see C64::startCapture()) into formats downstream encoders accept.
+ *
+ * Usage: vc64capture [-v video.y4m] [-a audio.wav] capture
+ *
+ * The video track is written as uncompressed YUV 4:4:4 (Y4M), the audio track as 16 bit
+ * mono PCM (WAV). Frames missing in the capture, e.g., frames skipped in warp mode or
+ * dropped because the disk was busy, are filled in by repeating the previous frame. Dropped
+ * audio samples are already stored as silence by the capture. Hence, both tracks stay in sync. Without -v and -a, the file is only checked and summarized.
+ * The exit code is 0 on success, 1 if the capture is malformed, and 2 on I/O errors.
+ */
+
+#include "C64.h"
+
+static void
+usage()
+{
+    fprintf(stderr, "Usage: vc64capture [-v video.y4m] [-a audio.wav] capture\n");
+}
+
+static uint32_t
+get32(const uint8_t *ptr)
+{
+    return (uint32_t)ptr[0] << 24 | ptr[1] << 16 | ptr[2] << 8 | ptr[3];
+}
+
+static void
+putLE(FILE *file, uint32_t value, unsigned bytes)
+{
+    for (unsigned i = 0; i < bytes; i++)
+        fputc((value >> (8 * i)) & 0xFF, file);
+}
+
+//! @brief    Writes a WAV header for 16 bit mono PCM
+static void
+writeWavHeader(FILE *file, uint32_t sampleRate, uint32_t numSamples)
+{
+    uint32_t dataSize = 2 * numSamples;
+
+    fwrite("RIFF", 1, 4, file);
+    putLE(file, 36 + dataSize, 4);
+    fwrite("WAVEfmt ", 1, 8, file);
+    putLE(file, 16, 4);             // Size of the format chunk
+    putLE(file, 1, 2);              // PCM
+    putLE(file, 1, 2);              // Mono
+    putLE(file, sampleRate, 4);
+    putLE(file, 2 * sampleRate, 4); // Bytes per second
+    putLE(file, 2, 2);              // Bytes per sample frame
+    putLE(file, 16, 2);             // Bits per sample
+    fwrite("data", 1, 4, file);
+    putLE(file, dataSize, 4);
+}
+
+//! @brief    Translates a palette into YCbCr (ITU-R BT.601, studio swing)
+static void
+paletteToYUV(const uint8_t *rgb, uint8_t *y, uint8_t *u, uint8_t *v)
+{
+    for (unsigned i = 0; i < 16; i++) {
+        double r = rgb[3 * i], g = rgb[3 * i + 1], b = rgb[3 * i + 2];
+        y[i] = (uint8_t)lround(16.0 + (65.481 * r + 128.553 * g + 24.966 * b) / 255.0);
+        u[i] = (uint8_t)lround(128.0 + (-37.797 * r - 74.203 * g + 112.0 * b) / 255.0);
+        v[i] = (uint8_t)lround(128.0 + (112.0 * r - 93.786 * g - 18.214 * b) / 255.0);
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *videoPath = NULL, *audioPath = NULL;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "v:a:")) != -1) {
+        switch (opt) {
+            case 'v': videoPath = optarg; break;
+            case 'a': audioPath = optarg; break;
+            default: usage(); return 2;
+        }
+    }
+
+    if (optind != argc - 1) {
+        usage();
+        return 2;
+    }
+
+    const char *path = argv[optind];
+    FILE *in = fopen(path, "r"), *video = NULL, *audio = NULL;
+    if (in == NULL) {
+        fprintf(stderr, "%s: Cannot open file\n", path);
+        return 2;
+    }
+
+    // Read header
+    uint8_t header[Capture::HEADER_SIZE];
+    if (fread(header, 1, sizeof(header), in) != sizeof(header) ||
+        memcmp(header, Capture::magicBytes, 4) != 0) {
+        fprintf(stderr, "%s: Not a capture file\n", path);
+        return 1;
+    }
+    unsigned width = HI_LO(header[8], header[9]);
+    unsigned height = HI_LO(header[10], header[11]);
+    unsigned fps = HI_LO(header[12], header[13]);
+    uint32_t sampleRate = get32(header + 14);
+    size_t frameSize = (size_t)width * height;
+
+    uint8_t y[16], u[16], v[16];
+    paletteToYUV(header + 18, y, u, v);
+
+    // The frame size is taken from the file and may be arbitrarily large
+    uint8_t *indices = (uint8_t *)calloc(frameSize, 1);
+    uint8_t *delta = (uint8_t *)malloc(frameSize);
+    uint8_t *yuv = (uint8_t *)malloc(3 * frameSize);
+    if (indices == NULL || delta == NULL || yuv == NULL) {
+        fprintf(stderr, "%s: Cannot allocate buffers for %ux%u frames\n", path, width, height);
+        return 1;
+    }
+
+    if ((videoPath && (video = fopen(videoPath, "w")) == NULL) ||
+        (audioPath && (audio = fopen(audioPath, "w")) == NULL)) {
+        fprintf(stderr, "Cannot create output file\n");
+        return 2;
+    }
+    if (video)
+        fprintf(video, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", width, height, fps);
+    if (audio)
+        writeWavHeader(audio, sampleRate, 0);
+
+    uint8_t *payload = NULL;
+    size_t capacity = 0;
+
+    uint64_t frames = 0, keyframes = 0, repeated = 0, samples = 0, lastFrame = 0;
+    int result = 0;
+
+    // Process chunks
+    uint8_t chunk[5];
+    while (fread(chunk, 1, sizeof(chunk), in) == sizeof(chunk)) {
+
+        uint32_t size = get32(chunk + 1);
+        if (size > capacity) {
+            payload = (uint8_t *)realloc(payload, size);
+            capacity = size;
+        }
+        if (payload == NULL || fread(payload, 1, size, in) != size) {
+            fprintf(stderr, "%s: Truncated chunk\n", path);
+            result = 1;
+            break;
+        }
+
+        if (chunk[0] == Capture::CHUNK_AUDIO) {
+
+            for (uint32_t i = 0; audio && i + 1 < size; i += 2)
+                putLE(audio, HI_LO(payload[i], payload[i + 1]), 2);
+            samples += size / 2;
+            continue;
+        }
+
+        if (chunk[0] != Capture::CHUNK_FRAME || size < 9) {
+            fprintf(stderr, "%s: Unknown chunk type %02X\n", path, chunk[0]);
+            result = 1;
+            break;
+        }
+
+        uint64_t frame = (uint64_t)get32(payload) << 32 | get32(payload + 4);
+        if (!Capture::decodeRLE(payload + 9, size - 9, delta, frameSize)) {
+            fprintf(stderr, "%s: Corrupted frame %llu\n", path, (unsigned long long)frame);
+            result = 1;
+            break;
+        }
+
+        // Fill in missing frames by repeating the previous one
+        if (frames && frame > lastFrame + 1) {
+            for (uint64_t n = 0; video && n < frame - lastFrame - 1; n++) {
+                fputs("FRAME\n", video);
+                fwrite(yuv, 1, 3 * frameSize, video);
+            }
+            repeated += frame - lastFrame - 1;
+        }
+
+        // Apply the difference to the previous frame
+        if (payload[8]) {
+            memset(indices, 0, frameSize);
+            keyframes++;
+        }
+        for (size_t i = 0; i < frameSize; i++)
+            indices[i] ^= delta[i];
+
+        if (video) {
+            for (size_t i = 0; i < frameSize; i++) {
+                uint8_t color = indices[i] & 0x0F;
+                yuv[i] = y[color];
+                yuv[frameSize + i] = u[color];
+                yuv[2 * frameSize + i] = v[color];
+            }
+            fputs("FRAME\n", video);
+            fwrite(yuv, 1, 3 * frameSize, video);
+        }
+
+        frames++;
+        lastFrame = frame;
+    }
+
+    free(payload);
+    free(yuv);
+    free(delta);
+    free(indices);
+    fclose(in);
+
+    if (audio) {
+        fseek(audio, 0, SEEK_SET);
+        writeWavHeader(audio, sampleRate, (uint32_t)samples);
+        if (fclose(audio) != 0)
+            result = 2;
+    }
+    if (video && fclose(video) != 0)
+        result = 2;
+
+    printf("%llu frames (%llu keyframes, %llu repeated), %llu samples at %u Hz\n",
+           (unsigned long long)frames, (unsigned long long)keyframes,
+           (unsigned long long)repeated, (unsigned long long)samples, sampleRate);
+
+    return result;
+}
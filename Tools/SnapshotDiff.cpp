@@ -0,0 +1,123 @@
+/*
+ * Author: Dirk W. Hoffmann. All rights reserved.
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/* vc64diff
+ *
+ * Compares two snapshots and reports which parts of the emulator state differ.
+ *
+ * Usage: vc64diff [-q] snapshot1 snapshot2
+ *
+ * Both snapshots are loaded into separate C64 instances. Afterwards, the states of all
+ * components are compared (see VirtualComponent::diffState()). Each differing snapshot
+ * item is printed by name, e.g.,
+ *
+ *     C64.CIA1.counterA: $1A2B / $1A2C
+ *     C64.C64 memory.ram: 3 of 65536 elements differ, first at [2048]: $20 / $41
+ *
+ * Option -q suppresses the report. The exit code is 0 if both states are equal, 1 if
+ * they differ, and 2 if a snapshot cannot be read or contains a malformed state.
+ *
+ * vc64batch starts the TOD clocks of both CIAs at 00:00:00 instead of the time of the host.
+ * Hence, snapshots of two independent runs of the same job are equal (see vc64batch -o).
+ */
+
+#include "C64.h"
+
+static void
+usage()
+{
+    fprintf(stderr, "Usage: vc64diff [-q] snapshot1 snapshot2\n");
+}
+
+//! @brief    Sink for the emulator's log messages
+static FILE *devnull;
+
+static C64 *
+loadSnapshot(const char *path)
+{
+    if (Snapshot::isUnsupportedSnapshotFile(path)) {
+        fprintf(stderr, "%s: Snapshot has been created with an incompatible version\n", path);
+        return NULL;
+    }
+    
+    Snapshot *snapshot = Snapshot::makeSnapshotWithFile(path);
+    if (snapshot == NULL) {
+        fprintf(stderr, "%s: Cannot read snapshot\n", path);
+        return NULL;
+    }
+    
+    // The state is compared as stored (loadFromSnapshotUnsafe() would release all keys)
+    C64 *c64 = new C64();
+    VC64Object::setLogfile(stderr);
+    bool success = c64->loadStateUnsafe(snapshot);
+    VC64Object::setLogfile(devnull);
+    delete snapshot;
+    
+    if (!success) {
+        fprintf(stderr, "%s: Cannot load the state\n", path);
+        delete c64;
+        return NULL;
+    }
+    
+    return c64;
+}
+
+int
+main(int argc, char *argv[])
+{
+    bool quiet = false;
+    int opt;
+    
+    while ((opt = getopt(argc, argv, "q")) != -1) {
+        switch (opt) {
+            case 'q': quiet = true; break;
+            default: usage(); return 2;
+        }
+    }
+    
+    if (optind != argc - 2) {
+        usage();
+        return 2;
+    }
+    
+    // Only load errors and the differences are printed to the console
+    devnull = fopen("/dev/null", "w");
+    VC64Object::setDefaultDebugLevel(0);
+    VC64Object::setLogfile(devnull);
+    
+    C64 *c64[2] = { NULL, NULL };
+    int result = 2;
+    
+    if ((c64[0] = loadSnapshot(argv[optind])) != NULL &&
+        (c64[1] = loadSnapshot(argv[optind + 1])) != NULL) {
+        
+        VC64Object::setLogfile(quiet ? devnull : stdout);
+        
+        unsigned differences = c64[0]->diffState(c64[1]);
+        
+        if (!quiet)
+            printf("%u difference%s\n", differences, differences == 1 ? "" : "s");
+        
+        result = differences ? 1 : 0;
+    }
+    
+    VC64Object::setLogfile(devnull);
+    delete c64[0];
+    delete c64[1];
+    return result;
+}